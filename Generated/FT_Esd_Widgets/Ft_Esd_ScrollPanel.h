@@ -77,6 +77,9 @@ typedef struct
 	ft_uint8_t Align;
 	ESD_VARIABLE(PreviousTouchX, Type = ft_int16_t, Private)
 	ft_int16_t PreviousTouchX;
+	/* Scroll by translating the rendered content instead of moving all child widgets. Requires FT810 or later */
+	ESD_VARIABLE(Translate, Type = ft_bool_t, Public)
+	ft_bool_t Translate;
 	ESD_VARIABLE(ScrollBars, Type = Esd_Visible, Default = ESD_VISIBLE_NEVER, Public)
 	ft_uint8_t ScrollBars;
 	ESD_VARIABLE(PreviousScrollX, Type = ft_int16_t, Private)
@@ -246,6 +246,7 @@ void Ft_Esd_ScrollPanel__Initializer(Ft_Esd_ScrollPanel *context)
 	context->ScrollY = 0;
 	context->Align = ESD_ALIGN_TOPFILL;
 	context->PreviousTouchX = 0;
+	context->Translate = 0;
 	context->ScrollBars = ESD_VISIBLE_NEVER;
 	context->PreviousScrollX = 0;
 	context->TouchScroll = 1;
@@ -288,20 +289,22 @@ void Ft_Esd_ScrollPanel_Update__Builtin(Ft_Esd_ScrollPanel *context)
 	context->Scroll_Layout.ScrollY = update_variable_5;
 	ft_uint8_t update_variable_6 = context->Align;
 	context->Scroll_Layout.Align = update_variable_6;
-	ft_bool_t update_variable_7 = context->TouchScroll;
-	Ft_Esd_Widget_SetActive((Ft_Esd_Widget *)&context->TouchPanel, update_variable_7);
+	ft_bool_t update_variable_7 = context->Translate;
+	context->Scroll_Layout.Translate = update_variable_7;
+	ft_bool_t update_variable_8 = context->TouchScroll;
+	Ft_Esd_Widget_SetActive((Ft_Esd_Widget *)&context->TouchPanel, update_variable_8);
 	Ft_Esd_Layout_Scroll * context_1 = &context->Scroll_Layout;
-	ft_int16_t update_variable_8 = Ft_Esd_Widget_GetGlobalX(context_1);
-	Ft_Esd_Widget_SetX((Ft_Esd_Widget *)&context->TouchPanel, update_variable_8);
+	ft_int16_t update_variable_9 = Ft_Esd_Widget_GetGlobalX(context_1);
+	Ft_Esd_Widget_SetX((Ft_Esd_Widget *)&context->TouchPanel, update_variable_9);
 	Ft_Esd_Layout_Scroll * context_2 = &context->Scroll_Layout;
-	ft_int16_t update_variable_9 = Ft_Esd_Widget_GetGlobalY(context_2);
-	Ft_Esd_Widget_SetY((Ft_Esd_Widget *)&context->TouchPanel, update_variable_9);
+	ft_int16_t update_variable_10 = Ft_Esd_Widget_GetGlobalY(context_2);
+	Ft_Esd_Widget_SetY((Ft_Esd_Widget *)&context->TouchPanel, update_variable_10);
 	Ft_Esd_Layout_Scroll * context_3 = &context->Scroll_Layout;
-	ft_int16_t update_variable_10 = Ft_Esd_Widget_GetGlobalWidth(context_3);
-	Ft_Esd_Widget_SetWidth((Ft_Esd_Widget *)&context->TouchPanel, update_variable_10);
+	ft_int16_t update_variable_11 = Ft_Esd_Widget_GetGlobalWidth(context_3);
+	Ft_Esd_Widget_SetWidth((Ft_Esd_Widget *)&context->TouchPanel, update_variable_11);
 	Ft_Esd_Layout_Scroll * context_4 = &context->Scroll_Layout;
-	ft_int16_t update_variable_11 = Ft_Esd_Widget_GetGlobalHeight(context_4);
-	Ft_Esd_Widget_SetHeight((Ft_Esd_Widget *)&context->TouchPanel, update_variable_11);
+	ft_int16_t update_variable_12 = Ft_Esd_Widget_GetGlobalHeight(context_4);
+	Ft_Esd_Widget_SetHeight((Ft_Esd_Widget *)&context->TouchPanel, update_variable_12);
 	ft_uint16_t left_1 = Ft_Esd_Layout_Scroll_RangeX(&context->Scroll_Layout);
 	ft_uint8_t left_2 = context->ScrollBars;
 	ft_uint8_t right_1 = ESD_VISIBLE_WHENNEEDED;
@@ -310,12 +313,12 @@ void Ft_Esd_ScrollPanel_Update__Builtin(Ft_Esd_ScrollPanel *context)
 	ft_uint8_t left_3 = context->ScrollBars;
 	ft_uint8_t right_3 = ESD_VISIBLE_ALWAYS;
 	int right_2 = left_3 == right_3;
-	int update_variable_12 = left || right_2;
-	Ft_Esd_Widget_SetActive((Ft_Esd_Widget *)&context->ESD_Scroll_Bar_2, update_variable_12);
-	ft_int16_t update_variable_13 = context->ScrollBarSize;
-	Ft_Esd_Widget_SetHeight((Ft_Esd_Widget *)&context->ESD_Scroll_Bar_2, update_variable_13);
-	ft_int16_t update_variable_14 = context->ScrollX;
-	context->ESD_Scroll_Bar_2.Value = update_variable_14;
+	int update_variable_13 = left || right_2;
+	Ft_Esd_Widget_SetActive((Ft_Esd_Widget *)&context->ESD_Scroll_Bar_2, update_variable_13);
+	ft_int16_t update_variable_14 = context->ScrollBarSize;
+	Ft_Esd_Widget_SetHeight((Ft_Esd_Widget *)&context->ESD_Scroll_Bar_2, update_variable_14);
+	ft_int16_t update_variable_15 = context->ScrollX;
+	context->ESD_Scroll_Bar_2.Value = update_variable_15;
 	ft_uint16_t left_5 = Ft_Esd_Layout_Scroll_RangeY(&context->Scroll_Layout);
 	ft_uint8_t left_6 = context->ScrollBars;
 	ft_uint8_t right_5 = ESD_VISIBLE_WHENNEEDED;
@@ -324,12 +327,12 @@ void Ft_Esd_ScrollPanel_Update__Builtin(Ft_Esd_ScrollPanel *context)
 	ft_uint8_t left_7 = context->ScrollBars;
 	ft_uint8_t right_7 = ESD_VISIBLE_ALWAYS;
 	int right_6 = left_7 == right_7;
-	int update_variable_15 = left_4 || right_6;
-	Ft_Esd_Widget_SetActive((Ft_Esd_Widget *)&context->Linear_Layout_3, update_variable_15);
-	ft_int16_t update_variable_16 = context->ScrollBarSize;
-	Ft_Esd_Widget_SetWidth((Ft_Esd_Widget *)&context->Linear_Layout_3, update_variable_16);
-	ft_int16_t update_variable_17 = context->ScrollY;
-	context->ESD_Scroll_Bar.Value = update_variable_17;
+	int update_variable_16 = left_4 || right_6;
+	Ft_Esd_Widget_SetActive((Ft_Esd_Widget *)&context->Linear_Layout_3, update_variable_16);
+	ft_int16_t update_variable_17 = context->ScrollBarSize;
+	Ft_Esd_Widget_SetWidth((Ft_Esd_Widget *)&context->Linear_Layout_3, update_variable_17);
+	ft_int16_t update_variable_18 = context->ScrollY;
+	context->ESD_Scroll_Bar.Value = update_variable_18;
 	ft_uint16_t left_9 = Ft_Esd_Layout_Scroll_RangeX(&context->Scroll_Layout);
 	ft_uint8_t left_10 = context->ScrollBars;
 	ft_uint8_t right_9 = ESD_VISIBLE_WHENNEEDED;
@@ -338,10 +341,10 @@ void Ft_Esd_ScrollPanel_Update__Builtin(Ft_Esd_ScrollPanel *context)
 	ft_uint8_t left_11 = context->ScrollBars;
 	ft_uint8_t right_11 = ESD_VISIBLE_ALWAYS;
 	int right_10 = left_11 == right_11;
-	int update_variable_18 = left_8 || right_10;
-	Ft_Esd_Widget_SetActive((Ft_Esd_Widget *)&context->Fill_Layout, update_variable_18);
-	ft_int16_t update_variable_19 = context->ScrollBarSize;
-	Ft_Esd_Widget_SetHeight((Ft_Esd_Widget *)&context->Fill_Layout, update_variable_19);
+	int update_variable_19 = left_8 || right_10;
+	Ft_Esd_Widget_SetActive((Ft_Esd_Widget *)&context->Fill_Layout, update_variable_19);
+	ft_int16_t update_variable_20 = context->ScrollBarSize;
+	Ft_Esd_Widget_SetHeight((Ft_Esd_Widget *)&context->Fill_Layout, update_variable_20);
 	Ft_Esd_Widget_Update((Ft_Esd_Widget *)context);
 }
 
@@ -636,6 +639,7 @@ void Ft_Esd_ScrollPanel__Set_ScrollX__ESD(void *context, ft_int16_t value) { ((F
 void Ft_Esd_ScrollPanel__Set_ScrollY__ESD(void *context, ft_int16_t value) { ((Ft_Esd_ScrollPanel__ESD *)context)->Instance.ScrollY = value; }
 void Ft_Esd_ScrollPanel__Set_Align__ESD(void *context, ft_uint8_t value) { ((Ft_Esd_ScrollPanel__ESD *)context)->Instance.Align = value; }
 void Ft_Esd_ScrollPanel__Set_PreviousTouchX__ESD(void *context, ft_int16_t value) { ((Ft_Esd_ScrollPanel__ESD *)context)->Instance.PreviousTouchX = value; }
+void Ft_Esd_ScrollPanel__Set_Translate__ESD(void *context, ft_bool_t value) { ((Ft_Esd_ScrollPanel__ESD *)context)->Instance.Translate = value; }
 void Ft_Esd_ScrollPanel__Set_ScrollBars__ESD(void *context, ft_uint8_t value) { ((Ft_Esd_ScrollPanel__ESD *)context)->Instance.ScrollBars = value; }
 void Ft_Esd_ScrollPanel__Set_PreviousScrollX__ESD(void *context, ft_int16_t value) { ((Ft_Esd_ScrollPanel__ESD *)context)->Instance.PreviousScrollX = value; }
 void Ft_Esd_ScrollPanel__Set_TouchScroll__ESD(void *context, ft_bool_t value) { ((Ft_Esd_ScrollPanel__ESD *)context)->Instance.TouchScroll = value; }
@@ -3,6 +3,7 @@
 #include "FT_Esd_Dl.h"
 
 #include "Ft_Esd_Core.h"
+#include "Ft_Esd_Batch.h"
 
 #include <stdio.h>
 #define _USE_MATH_DEFINES 1
@@ -15,18 +16,45 @@ extern Ft_Esd_GpuAlloc *Ft_Esd_GAlloc;
 #if ESD_DL_OPTIMIZE
 Ft_Esd_GpuState_T Ft_Esd_GpuState[ESD_DL_STATE_STACK_SIZE];
 ft_uint8_t Ft_Esd_GpuState_I;
+ft_uint8_t Ft_Esd_GpuState_Overflow; // Number of SAVE_CONTEXT levels beyond the cache stack
 ft_uint8_t Ft_Esd_Primitive;
 // ft_uint32_t Esd_CurrentContext->CoFgColor;
 // ft_uint32_t Esd_CurrentContext->CoBgColor;
 #endif
 Ft_Esd_Rect16 Ft_Esd_ScissorRect;
+ft_int16_t Ft_Esd_TranslateX;
+ft_int16_t Ft_Esd_TranslateY;
 
 void Esd_ResetGpuState() // Begin of frame
 {
+#if ESD_BATCH_RENDER
+	Esd_Batch_Discard();
+#endif
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_GpuState_I = 0;
+	Ft_Esd_GpuState_Overflow = 0;
 	Ft_Esd_GpuState[0] = (Ft_Esd_GpuState_T)
 	{
+#if (EVE_MODEL >= EVE_FT810)
+		.VertexTranslateX = VERTEX_TRANSLATE_X(0),
+		.VertexTranslateY = VERTEX_TRANSLATE_Y(0),
+#endif
+		.BitmapTransform = {
+		    (21UL << 24) | 256, // A
+		    (22UL << 24), // B
+		    (23UL << 24), // C
+		    (24UL << 24), // D
+		    (25UL << 24) | 256, // E
+		    (26UL << 24), // F
+		},
+		.AlphaFunc = ALPHA_FUNC(ALWAYS, 0),
+		.StencilFunc = STENCIL_FUNC(ALWAYS, 0, 255),
+		.StencilOp = STENCIL_OP(KEEP, KEEP),
+		.StencilMask = STENCIL_MASK(255),
+		.BlendFunc = BLEND_FUNC(SRC_ALPHA, ONE_MINUS_SRC_ALPHA),
+		.ColorMask = COLOR_MASK(1, 1, 1, 1),
+		.TagMask = TAG_MASK(1),
+		.Tag = TAG(255),
 		.LineWidth = 16,
 		.PointSize = 16,
 		.ColorRGB = 0xFFFFFF,
@@ -45,6 +73,16 @@ void Esd_ResetGpuState() // Begin of frame
 	Ft_Esd_ScissorRect.Y = 0;
 	Ft_Esd_ScissorRect.Width = Ft_Esd_Host->Parameters.Display.Width;
 	Ft_Esd_ScissorRect.Height = Ft_Esd_Host->Parameters.Display.Height;
+	Ft_Esd_TranslateX = 0;
+	Ft_Esd_TranslateY = 0;
+}
+
+void Esd_InvalidateGpuState()
+{
+#if ESD_DL_OPTIMIZE
+	// Byte value 0xFF does not match any valid cached value
+	memset(&FT_ESD_STATE, 0xFF, sizeof(Ft_Esd_GpuState_T));
+#endif
 }
 
 void Esd_ResetCoState()
@@ -102,9 +140,9 @@ void Ft_Esd_Dl_Scissor_Adjust(Ft_Esd_Rect16 rect, Ft_Esd_Rect16 state)
 	}
 	// Ft_Gpu_CoCmd_StartFunc(Ft_Esd_Host, FT_CMD_SIZE * 2);
 	if (Ft_Esd_ScissorRect.X != rect.X || Ft_Esd_ScissorRect.Y != rect.Y)
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_XY(rect.X, rect.Y));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, ESD_SCISSOR_XY(rect.X, rect.Y));
 	if (Ft_Esd_ScissorRect.Width != rect.Width || Ft_Esd_ScissorRect.Height != rect.Height)
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_SIZE(rect.Width, rect.Height));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, SCISSOR_SIZE(rect.Width, rect.Height));
 	// Ft_Gpu_CoCmd_EndFunc(Ft_Esd_Host);
 	Ft_Esd_ScissorRect = rect;
 }
@@ -113,9 +151,9 @@ void Ft_Esd_Dl_Scissor_Reset(Ft_Esd_Rect16 state)
 {
 	// Ft_Gpu_CoCmd_StartFunc(Ft_Esd_Host, FT_CMD_SIZE * 2);
 	if (Ft_Esd_ScissorRect.X != state.X || Ft_Esd_ScissorRect.Y != state.Y)
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_XY(state.X, state.Y));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, ESD_SCISSOR_XY(state.X, state.Y));
 	if (Ft_Esd_ScissorRect.Width != state.Width || Ft_Esd_ScissorRect.Height != state.Height)
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_SIZE(state.Width, state.Height));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, SCISSOR_SIZE(state.Width, state.Height));
 	// Ft_Gpu_CoCmd_EndFunc(Ft_Esd_Host);
 	Ft_Esd_ScissorRect = state;
 }
@@ -138,13 +176,13 @@ void FT_Esd_Render_Rect_Grad(ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_
 		// Not a gradient
 		Ft_Esd_Rect16 scissor;
 		// Ft_Gpu_CoCmd_StartFunc(Ft_Esd_Host, FT_CMD_SIZE * 4);
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SAVE_CONTEXT());
+		Eve_CoCmd_SendDl(Ft_Esd_Host, SAVE_CONTEXT());
 		scissor = Ft_Esd_Rect16_Crop(rect, Ft_Esd_Dl_Scissor_Get());
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_XY(scissor.X, scissor.Y));
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_SIZE(scissor.Width, scissor.Height));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, ESD_SCISSOR_XY(scissor.X, scissor.Y));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, SCISSOR_SIZE(scissor.Width, scissor.Height));
 		Ft_Esd_Dl_COLOR_ARGB(color1);
 		FT_Esd_Render_Rect(x, y, w, h);
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, RESTORE_CONTEXT());
+		Eve_CoCmd_SendDl(Ft_Esd_Host, RESTORE_CONTEXT());
 		// Ft_Gpu_CoCmd_EndFunc(Ft_Esd_Host);
 		return;
 	}
@@ -153,15 +191,30 @@ void FT_Esd_Render_Rect_Grad(ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_
 	{
 		double radius = direction * M_PI / 180.0f;
 		double sine = sin(radius), cosine = cos(radius);
-		ft_int16_t x0 = x + (w >> 1);
-		ft_int16_t y0 = y + (h >> 1);
+		// The gradient points are in screen coordinates, like the scissor
+		ft_int16_t x0 = x + (w >> 1) + Ft_Esd_TranslateX;
+		ft_int16_t y0 = y + (h >> 1) + Ft_Esd_TranslateY;
 		ft_int16_t l = (ft_int16_t)(sqrt(w * w + h * h) * 0.8); // use 80% to apply gradient effect
 		ft_int16_t half = l >> 1;
 		ft_int16_t dy = (ft_int16_t)(half * sine);
 		ft_int16_t dx = (ft_int16_t)(half * cosine);
 
 		Ft_Esd_Rect16 s = Ft_Esd_Dl_Scissor_Set(rect);
+#if (EVE_MODEL >= EVE_FT810)
+		// Draw without the vertex translation of a scroll layout, which the points already include
+		ft_bool_t translated = Ft_Esd_TranslateX || Ft_Esd_TranslateY;
+		if (translated)
+		{
+			Ft_Esd_Dl_SAVE_CONTEXT();
+			Ft_Esd_Dl_VERTEX_TRANSLATE_X(0);
+			Ft_Esd_Dl_VERTEX_TRANSLATE_Y(0);
+		}
+#endif
 		Ft_Gpu_CoCmd_Gradient(Ft_Esd_Host, x0 - dx, y0 - dy, color1, x0 + dx, y0 + dy, color2);
+#if (EVE_MODEL >= EVE_FT810)
+		if (translated)
+			Ft_Esd_Dl_RESTORE_CONTEXT();
+#endif
 		Ft_Esd_Dl_Scissor_Reset(s);
 	}
 }
@@ -170,8 +223,8 @@ void FT_Esd_Render_Rect_Grad(ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_
 void FT_Esd_Render_Rect(ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t h)
 {
 	Ft_Esd_Dl_BEGIN(RECTS);
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2II(x, y, 0, 0));
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2II(x + w, y + h, 0, 0));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2II(x, y, 0, 0));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2II(x + w, y + h, 0, 0));
 	Ft_Esd_Dl_END();
 }
 
@@ -11,6 +11,8 @@
 #include "Ft_Esd_Math.h"
 #include "Ft_Esd_BitmapHandle.h"
 
+#include <string.h>
+
 ESD_CATEGORY(EsdUtilities, DisplayName = "ESD Utilities")
 ESD_CATEGORY(EsdRenderable, DisplayName = "ESD Render Functions")
 ESD_CATEGORY(EveRenderFunctions, DisplayName = "Display List", Category = EsdRenderable)
@@ -45,6 +47,20 @@ ESD_TYPE(EVE_HalContext *, Native = Pointer, Edit = Library)
 #define FT_Esd_Dl_POINT_SIZE Ft_Esd_Dl_POINT_SIZE
 #define Esd_Dl_BEGIN Ft_Esd_Dl_BEGIN
 #define Esd_Dl_END Ft_Esd_Dl_END
+#define Esd_Dl_BLEND_FUNC Ft_Esd_Dl_BLEND_FUNC
+#define Esd_Dl_COLOR_MASK Ft_Esd_Dl_COLOR_MASK
+#define Esd_Dl_STENCIL_FUNC Ft_Esd_Dl_STENCIL_FUNC
+#define Esd_Dl_STENCIL_OP Ft_Esd_Dl_STENCIL_OP
+#define Esd_Dl_STENCIL_MASK Ft_Esd_Dl_STENCIL_MASK
+#define Esd_Dl_TAG_MASK Ft_Esd_Dl_TAG_MASK
+#define Esd_Dl_BITMAP_TRANSFORM_A Ft_Esd_Dl_BITMAP_TRANSFORM_A
+#define Esd_Dl_BITMAP_TRANSFORM_B Ft_Esd_Dl_BITMAP_TRANSFORM_B
+#define Esd_Dl_BITMAP_TRANSFORM_C Ft_Esd_Dl_BITMAP_TRANSFORM_C
+#define Esd_Dl_BITMAP_TRANSFORM_D Ft_Esd_Dl_BITMAP_TRANSFORM_D
+#define Esd_Dl_BITMAP_TRANSFORM_E Ft_Esd_Dl_BITMAP_TRANSFORM_E
+#define Esd_Dl_BITMAP_TRANSFORM_F Ft_Esd_Dl_BITMAP_TRANSFORM_F
+#define Esd_Dl_VERTEX_TRANSLATE_X Ft_Esd_Dl_VERTEX_TRANSLATE_X
+#define Esd_Dl_VERTEX_TRANSLATE_Y Ft_Esd_Dl_VERTEX_TRANSLATE_Y
 
 //
 // Structs
@@ -54,19 +70,31 @@ ESD_TYPE(EVE_HalContext *, Native = Pointer, Edit = Library)
 typedef struct
 {
 	// Keep to a minimum
+	// The less common state is kept as the full display list word,
+	// filling a state with 0xFF bytes then guarantees the next call will not be skipped
 #if (EVE_MODEL >= EVE_FT810)
 	ft_uint32_t PaletteSource;
-#endif
-	ft_int16_f4_t LineWidth;
-	ft_int16_f4_t PointSize;
+	ft_uint32_t VertexTranslateX;
+	ft_uint32_t VertexTranslateY;
+#endif
+	ft_uint32_t BitmapTransform[6]; // BITMAP_TRANSFORM_A to BITMAP_TRANSFORM_F
+	ft_uint32_t AlphaFunc;
+	ft_uint32_t StencilFunc;
+	ft_uint32_t StencilOp;
+	ft_uint32_t StencilMask;
+	ft_uint32_t BlendFunc;
+	ft_uint32_t ColorMask;
+	ft_uint32_t TagMask;
+	ft_uint32_t Tag;
 	ft_rgb32_t ColorRGB;
-	ft_uint8_t ColorA;
+	ft_int16_f4_t LineWidth; // Masked to 12 bits
+	ft_int16_f4_t PointSize; // Masked to 13 bits
+	ft_uint16_t ColorA; // Wider than necessary, so 0xFFFF is never a valid value
 	ft_uint8_t Handle; // Current handle
-	ft_uint8_t Cell; // Current cell
+	ft_uint8_t Cell; // Current cell, masked to 7 bits
 #if (EVE_MODEL >= EVE_FT810)
 	ft_uint8_t VertexFormat; // Current vertex format
 #endif
-	ft_bool_t BitmapTransform; // BitmapTransform other than default is set
 } Ft_Esd_GpuState_T;
 #endif
 
@@ -77,16 +105,36 @@ extern EVE_HalContext *Ft_Esd_Host;
 #if ESD_DL_OPTIMIZE
 extern Ft_Esd_GpuState_T Ft_Esd_GpuState[ESD_DL_STATE_STACK_SIZE];
 extern ft_uint8_t Ft_Esd_GpuState_I;
+extern ft_uint8_t Ft_Esd_GpuState_Overflow;
 extern ft_uint8_t Ft_Esd_Primitive;
 // extern ft_uint32_t Esd_CurrentContext->CoFgColor;
 // extern ft_uint32_t Esd_CurrentContext->CoBgColor;
 #endif
 extern Ft_Esd_Rect16 Ft_Esd_ScissorRect;
 
+// Offset from the coordinates of the widgets being processed to the screen, set while a scroll layout translates its content.
+// Ft_Esd_ScissorRect is in the same coordinates as the widgets, the hardware scissor is not affected by the vertex translation
+extern ft_int16_t Ft_Esd_TranslateX;
+extern ft_int16_t Ft_Esd_TranslateY;
+
+// Scissor position of a rectangle in the coordinates of the widgets being drawn
+#define ESD_SCISSOR_XY(x, y) SCISSOR_XY((x) + Ft_Esd_TranslateX, (y) + Ft_Esd_TranslateY)
+
 // Reset any cached state
 void Esd_ResetGpuState();
 void Esd_ResetCoState();
 
+// Forget the cached state of the current context level, used when the state is no longer known
+void Esd_InvalidateGpuState();
+
+// Forget the cached bitmap transform, called after coprocessor commands which write the transform matrix
+inline static void Esd_InvalidateBitmapTransform()
+{
+#if ESD_DL_OPTIMIZE
+	memset(FT_ESD_STATE.BitmapTransform, 0xFF, sizeof(FT_ESD_STATE.BitmapTransform));
+#endif
+}
+
 // Returns the current scissor area
 ESD_FUNCTION(Ft_Esd_Dl_Scissor_Get, Type = Ft_Esd_Rect16, Category = EveRenderFunctions)
 Ft_Esd_Rect16 Ft_Esd_Dl_Scissor_Get();
@@ -112,7 +160,16 @@ ESD_FUNCTION(Ft_Esd_Dl_TAG, Type = ft_void_t, Category = EveRenderFunctions, Inl
 ESD_PARAMETER(s, Type = ft_uint8_t, DisplayName = "Tag", Default = 255, Min = 0, Max = 255)
 inline static ft_void_t Ft_Esd_Dl_TAG(ft_uint8_t s)
 {
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, TAG(s));
+	ft_uint32_t cmd = TAG(s);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.Tag)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.Tag = cmd;
+	}
+#endif
 }
 
 // Specify color RGB
@@ -125,7 +182,7 @@ inline static ft_void_t Ft_Esd_Dl_COLOR_RGB(ft_rgb32_t c)
 	if (rgb != FT_ESD_STATE.ColorRGB)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, COLOR_RGB(0, 0, 0) | (rgb));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, COLOR_RGB(0, 0, 0) | (rgb));
 #if ESD_DL_OPTIMIZE
 		FT_ESD_STATE.ColorRGB = rgb;
 	}
@@ -141,7 +198,7 @@ inline static ft_void_t Ft_Esd_Dl_COLOR_A(ft_uint8_t alpha)
 	if (alpha != FT_ESD_STATE.ColorA)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, COLOR_A(alpha));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, COLOR_A(alpha));
 #if ESD_DL_OPTIMIZE
 		FT_ESD_STATE.ColorA = alpha;
 	}
@@ -166,7 +223,7 @@ inline static ft_void_t Ft_Esd_Dl_BITMAP_HANDLE(ft_uint8_t handle)
 	if (handle != FT_ESD_STATE.Handle)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_HANDLE(handle));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, BITMAP_HANDLE(handle));
 #if ESD_DL_OPTIMIZE
 		FT_ESD_STATE.Handle = handle;
 	}
@@ -178,11 +235,12 @@ ESD_FUNCTION(Ft_Esd_Dl_CELL, Type = ft_void_t, Category = EveRenderFunctions, In
 ESD_PARAMETER(cell, Type = ft_uint8_t, Min = 0, Max = 255)
 inline static ft_void_t Ft_Esd_Dl_CELL(ft_uint8_t cell)
 {
+	cell &= 0x7F;
 #if ESD_DL_OPTIMIZE
 	if (cell != FT_ESD_STATE.Cell)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, CELL(cell));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, CELL(cell));
 #if ESD_DL_OPTIMIZE
 		FT_ESD_STATE.Cell = cell;
 	}
@@ -195,7 +253,16 @@ ESD_PARAMETER(func, Type = ft_uint8_t, Min = 0, Max = 7)
 ESD_PARAMETER(ref, Type = ft_uint8_t, Min = 0, Max = 255)
 inline static ft_void_t Ft_Esd_Dl_Alpha_Func(ft_uint8_t func, ft_uint8_t ref)
 {
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, ALPHA_FUNC(func, ref));
+	ft_uint32_t cmd = ALPHA_FUNC(func, ref);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.AlphaFunc)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.AlphaFunc = cmd;
+	}
+#endif
 }
 
 // Save EVE context, see SAVE_CONTEXT
@@ -205,7 +272,7 @@ inline static ft_void_t Ft_Esd_Dl_SAVE_CONTEXT()
 #if ESD_DL_OPTIMIZE
 	ft_uint8_t nextState;
 #endif
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, SAVE_CONTEXT());
+	Eve_CoCmd_SendDl(Ft_Esd_Host, SAVE_CONTEXT());
 #if ESD_DL_OPTIMIZE
 	nextState = Ft_Esd_GpuState_I + 1;
 	if (nextState < ESD_DL_STATE_STACK_SIZE)
@@ -213,6 +280,13 @@ inline static ft_void_t Ft_Esd_Dl_SAVE_CONTEXT()
 		Ft_Esd_GpuState[nextState] = Ft_Esd_GpuState[Ft_Esd_GpuState_I];
 		Ft_Esd_GpuState_I = nextState;
 	}
+	else
+	{
+		// Out of cache stack, the state saved by the GPU is lost to us.
+		// Count the levels, and forget the state so it gets resent
+		++Ft_Esd_GpuState_Overflow;
+		Esd_InvalidateGpuState();
+	}
 #endif
 }
 
@@ -220,10 +294,22 @@ inline static ft_void_t Ft_Esd_Dl_SAVE_CONTEXT()
 ESD_FUNCTION(Ft_Esd_Dl_RESTORE_CONTEXT, Type = ft_void_t, Category = EveRenderFunctions, Inline)
 inline static ft_void_t Ft_Esd_Dl_RESTORE_CONTEXT()
 {
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, RESTORE_CONTEXT());
+	Eve_CoCmd_SendDl(Ft_Esd_Host, RESTORE_CONTEXT());
 #if ESD_DL_OPTIMIZE
-	if (Ft_Esd_GpuState_I > 0)
+	if (Ft_Esd_GpuState_Overflow)
+	{
+		// Restored to a state which was not cached
+		--Ft_Esd_GpuState_Overflow;
+		Esd_InvalidateGpuState();
+	}
+	else if (Ft_Esd_GpuState_I > 0)
+	{
 		--Ft_Esd_GpuState_I;
+	}
+	else
+	{
+		eve_printf_debug("Warning: RESTORE_CONTEXT without matching SAVE_CONTEXT\n");
+	}
 #endif
 }
 
@@ -237,7 +323,7 @@ inline static ft_void_t Ft_Esd_Dl_VERTEX_FORMAT(ft_uint8_t frac)
 	if (frac != FT_ESD_STATE.VertexFormat)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX_FORMAT(frac));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX_FORMAT(frac));
 #if ESD_DL_OPTIMIZE
 		FT_ESD_STATE.VertexFormat = frac;
 	}
@@ -255,7 +341,7 @@ inline static ft_void_t Ft_Esd_Dl_PALETTE_SOURCE(ft_uint32_t addr)
 	if (addr != FT_ESD_STATE.PaletteSource)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, PALETTE_SOURCE(addr));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, PALETTE_SOURCE(addr));
 #if ESD_DL_OPTIMIZE
 		FT_ESD_STATE.PaletteSource = addr;
 	}
@@ -267,11 +353,12 @@ ESD_FUNCTION(Ft_Esd_Dl_LINE_WIDTH, Type = ft_void_t, Category = EveRenderFunctio
 ESD_PARAMETER(width, Type = ft_int16_f4_t)
 inline static ft_void_t Ft_Esd_Dl_LINE_WIDTH(ft_int16_f4_t width)
 {
+	width &= 4095;
 #if ESD_DL_OPTIMIZE
 	if (width != FT_ESD_STATE.LineWidth)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, LINE_WIDTH(width));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, LINE_WIDTH(width));
 #if ESD_DL_OPTIMIZE
 		FT_ESD_STATE.LineWidth = width;
 	}
@@ -282,11 +369,12 @@ ESD_FUNCTION(Ft_Esd_Dl_POINT_SIZE, Type = ft_void_t, Category = EveRenderFunctio
 ESD_PARAMETER(size, Type = ft_int16_f4_t)
 inline static ft_void_t Ft_Esd_Dl_POINT_SIZE(ft_int16_f4_t size)
 {
+	size &= 8191;
 #if ESD_DL_OPTIMIZE
 	if (size != FT_ESD_STATE.PointSize)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, POINT_SIZE(size));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, POINT_SIZE(size));
 #if ESD_DL_OPTIMIZE
 		FT_ESD_STATE.PointSize = size;
 	}
@@ -301,7 +389,7 @@ inline static ft_void_t Ft_Esd_Dl_BEGIN(ft_uint8_t primitive)
 	if (primitive != Ft_Esd_Primitive)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, BEGIN(primitive));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, BEGIN(primitive));
 #if ESD_DL_OPTIMIZE
 		Ft_Esd_Primitive = primitive;
 	}
@@ -316,7 +404,7 @@ inline static ft_void_t Ft_Esd_Dl_END()
 	if (Ft_Esd_Primitive != 0)
 	{
 #endif
-		Eve_CoCmd_SendCmd(Ft_Esd_Host, END());
+		Eve_CoCmd_SendDl(Ft_Esd_Host, END());
 #if ESD_DL_OPTIMIZE
 		Ft_Esd_Primitive = 0;
 	}
@@ -338,6 +426,255 @@ inline static ft_void_t Ft_Esd_Dl_END()
 #endif
 }
 
+// Specify blend function, see BLEND_FUNC
+ESD_FUNCTION(Ft_Esd_Dl_BLEND_FUNC, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(src, Type = ft_uint8_t, Min = 0, Max = 7)
+ESD_PARAMETER(dst, Type = ft_uint8_t, Min = 0, Max = 7)
+inline static ft_void_t Ft_Esd_Dl_BLEND_FUNC(ft_uint8_t src, ft_uint8_t dst)
+{
+	ft_uint32_t cmd = BLEND_FUNC(src, dst);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.BlendFunc)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.BlendFunc = cmd;
+	}
+#endif
+}
+
+// Enable or disable writing of color components, see COLOR_MASK
+ESD_FUNCTION(Ft_Esd_Dl_COLOR_MASK, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(r, Type = ft_uint8_t, Min = 0, Max = 1)
+ESD_PARAMETER(g, Type = ft_uint8_t, Min = 0, Max = 1)
+ESD_PARAMETER(b, Type = ft_uint8_t, Min = 0, Max = 1)
+ESD_PARAMETER(a, Type = ft_uint8_t, Min = 0, Max = 1)
+inline static ft_void_t Ft_Esd_Dl_COLOR_MASK(ft_uint8_t r, ft_uint8_t g, ft_uint8_t b, ft_uint8_t a)
+{
+	ft_uint32_t cmd = COLOR_MASK(r, g, b, a);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.ColorMask)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.ColorMask = cmd;
+	}
+#endif
+}
+
+// Set stencil test function, see STENCIL_FUNC
+ESD_FUNCTION(Ft_Esd_Dl_STENCIL_FUNC, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(func, Type = ft_uint8_t, Min = 0, Max = 7)
+ESD_PARAMETER(ref, Type = ft_uint8_t, Min = 0, Max = 255)
+ESD_PARAMETER(mask, Type = ft_uint8_t, Min = 0, Max = 255)
+inline static ft_void_t Ft_Esd_Dl_STENCIL_FUNC(ft_uint8_t func, ft_uint8_t ref, ft_uint8_t mask)
+{
+	ft_uint32_t cmd = STENCIL_FUNC(func, ref, mask);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.StencilFunc)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.StencilFunc = cmd;
+	}
+#endif
+}
+
+// Set stencil test actions, see STENCIL_OP
+ESD_FUNCTION(Ft_Esd_Dl_STENCIL_OP, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(sfail, Type = ft_uint8_t, Min = 0, Max = 7)
+ESD_PARAMETER(spass, Type = ft_uint8_t, Min = 0, Max = 7)
+inline static ft_void_t Ft_Esd_Dl_STENCIL_OP(ft_uint8_t sfail, ft_uint8_t spass)
+{
+	ft_uint32_t cmd = STENCIL_OP(sfail, spass);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.StencilOp)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.StencilOp = cmd;
+	}
+#endif
+}
+
+// Control writing of stencil bits, see STENCIL_MASK
+ESD_FUNCTION(Ft_Esd_Dl_STENCIL_MASK, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(mask, Type = ft_uint8_t, Min = 0, Max = 255)
+inline static ft_void_t Ft_Esd_Dl_STENCIL_MASK(ft_uint8_t mask)
+{
+	ft_uint32_t cmd = STENCIL_MASK(mask);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.StencilMask)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.StencilMask = cmd;
+	}
+#endif
+}
+
+// Control writing of the tag buffer, see TAG_MASK
+ESD_FUNCTION(Ft_Esd_Dl_TAG_MASK, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(mask, Type = ft_uint8_t, Min = 0, Max = 1)
+inline static ft_void_t Ft_Esd_Dl_TAG_MASK(ft_uint8_t mask)
+{
+	ft_uint32_t cmd = TAG_MASK(mask);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.TagMask)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.TagMask = cmd;
+	}
+#endif
+}
+
+// Set bitmap transform coefficient A, see BITMAP_TRANSFORM_A. Signed 8.8 fixed point, or 1.15 with bit 17 set on BT815
+ESD_FUNCTION(Ft_Esd_Dl_BITMAP_TRANSFORM_A, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(a, Type = ft_int32_t)
+inline static ft_void_t Ft_Esd_Dl_BITMAP_TRANSFORM_A(ft_int32_t a)
+{
+	ft_uint32_t cmd = (21UL << 24) | (a & 0x3FFFFUL);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.BitmapTransform[0])
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.BitmapTransform[0] = cmd;
+	}
+#endif
+}
+
+// Set bitmap transform coefficient B, see BITMAP_TRANSFORM_B. Signed 8.8 fixed point, or 1.15 with bit 17 set on BT815
+ESD_FUNCTION(Ft_Esd_Dl_BITMAP_TRANSFORM_B, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(b, Type = ft_int32_t)
+inline static ft_void_t Ft_Esd_Dl_BITMAP_TRANSFORM_B(ft_int32_t b)
+{
+	ft_uint32_t cmd = (22UL << 24) | (b & 0x3FFFFUL);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.BitmapTransform[1])
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.BitmapTransform[1] = cmd;
+	}
+#endif
+}
+
+// Set bitmap transform coefficient C, see BITMAP_TRANSFORM_C. Signed 8.8 fixed point
+ESD_FUNCTION(Ft_Esd_Dl_BITMAP_TRANSFORM_C, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(c, Type = ft_int32_t)
+inline static ft_void_t Ft_Esd_Dl_BITMAP_TRANSFORM_C(ft_int32_t c)
+{
+	ft_uint32_t cmd = (23UL << 24) | (c & 0xFFFFFFUL);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.BitmapTransform[2])
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.BitmapTransform[2] = cmd;
+	}
+#endif
+}
+
+// Set bitmap transform coefficient D, see BITMAP_TRANSFORM_D. Signed 8.8 fixed point, or 1.15 with bit 17 set on BT815
+ESD_FUNCTION(Ft_Esd_Dl_BITMAP_TRANSFORM_D, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(d, Type = ft_int32_t)
+inline static ft_void_t Ft_Esd_Dl_BITMAP_TRANSFORM_D(ft_int32_t d)
+{
+	ft_uint32_t cmd = (24UL << 24) | (d & 0x3FFFFUL);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.BitmapTransform[3])
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.BitmapTransform[3] = cmd;
+	}
+#endif
+}
+
+// Set bitmap transform coefficient E, see BITMAP_TRANSFORM_E. Signed 8.8 fixed point, or 1.15 with bit 17 set on BT815
+ESD_FUNCTION(Ft_Esd_Dl_BITMAP_TRANSFORM_E, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(e, Type = ft_int32_t)
+inline static ft_void_t Ft_Esd_Dl_BITMAP_TRANSFORM_E(ft_int32_t e)
+{
+	ft_uint32_t cmd = (25UL << 24) | (e & 0x3FFFFUL);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.BitmapTransform[4])
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.BitmapTransform[4] = cmd;
+	}
+#endif
+}
+
+// Set bitmap transform coefficient F, see BITMAP_TRANSFORM_F. Signed 8.8 fixed point
+ESD_FUNCTION(Ft_Esd_Dl_BITMAP_TRANSFORM_F, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(f, Type = ft_int32_t)
+inline static ft_void_t Ft_Esd_Dl_BITMAP_TRANSFORM_F(ft_int32_t f)
+{
+	ft_uint32_t cmd = (26UL << 24) | (f & 0xFFFFFFUL);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.BitmapTransform[5])
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.BitmapTransform[5] = cmd;
+	}
+#endif
+}
+
+#if (EVE_MODEL >= EVE_FT810)
+// Specify the vertex translation in X direction, see VERTEX_TRANSLATE_X
+ESD_FUNCTION(Ft_Esd_Dl_VERTEX_TRANSLATE_X, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(x, Type = ft_int32_f4_t)
+inline static ft_void_t Ft_Esd_Dl_VERTEX_TRANSLATE_X(ft_int32_f4_t x)
+{
+	ft_uint32_t cmd = VERTEX_TRANSLATE_X(x);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.VertexTranslateX)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.VertexTranslateX = cmd;
+	}
+#endif
+}
+#endif
+
+#if (EVE_MODEL >= EVE_FT810)
+// Specify the vertex translation in Y direction, see VERTEX_TRANSLATE_Y
+ESD_FUNCTION(Ft_Esd_Dl_VERTEX_TRANSLATE_Y, Type = ft_void_t, Category = EveRenderFunctions, Inline)
+ESD_PARAMETER(y, Type = ft_int32_f4_t)
+inline static ft_void_t Ft_Esd_Dl_VERTEX_TRANSLATE_Y(ft_int32_f4_t y)
+{
+	ft_uint32_t cmd = VERTEX_TRANSLATE_Y(y);
+#if ESD_DL_OPTIMIZE
+	if (cmd != FT_ESD_STATE.VertexTranslateY)
+	{
+#endif
+		Eve_CoCmd_SendDl(Ft_Esd_Host, cmd);
+#if ESD_DL_OPTIMIZE
+		FT_ESD_STATE.VertexTranslateY = cmd;
+	}
+#endif
+}
+#endif
+
 /* Display list calls without state caching */
 
 // Fixed point vertex with subprecision depending on current vertex format
@@ -346,7 +683,7 @@ ESD_PARAMETER(x, Type = ft_uint16_t)
 ESD_PARAMETER(y, Type = ft_uint16_t)
 inline static ft_void_t Esd_Dl_VERTEX2F(ft_uint16_t x, ft_uint16_t y)
 {
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2F(x, y));
 }
 
 // Fixed point vertex using 4 bits subprecision
@@ -358,7 +695,7 @@ inline static ft_void_t Esd_Dl_VERTEX2F_4(ft_int16_f4_t x, ft_int16_f4_t y)
 #if (EVE_MODEL >= EVE_FT810)
 	Esd_Dl_VERTEX_FORMAT(4);
 #endif
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2F(x, y));
 }
 
 // Fixed point vertex using 2 bits subprecision
@@ -373,7 +710,7 @@ inline static ft_void_t Esd_Dl_VERTEX2F_2(ft_int16_f2_t x, ft_int16_f2_t y)
 	x <<= 2;
 	y <<= 2;
 #endif
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2F(x, y));
 }
 
 // Fixed point vertex using 0 bits subprecision, or integer point vertex
@@ -384,9 +721,9 @@ inline static ft_void_t Esd_Dl_VERTEX2F_0(ft_uint16_t x, ft_uint16_t y)
 {
 #if (EVE_MODEL >= EVE_FT810)
 	Esd_Dl_VERTEX_FORMAT(0);
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2F(x, y));
 #else
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2II(x, y, 0, 0));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2II(x, y, 0, 0));
 #endif
 }
 
@@ -398,7 +735,7 @@ ESD_PARAMETER(handle, Type = ft_uint8_t)
 ESD_PARAMETER(cell, Type = ft_uint8_t)
 inline static ft_void_t Esd_Dl_VERTEX2II(ft_uint16_t x, ft_uint16_t y, ft_uint8_t handle, ft_uint8_t cell)
 {
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2II(x, y, handle, cell));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2II(x, y, handle, cell));
 }
 
 // Specify clear color RGB
@@ -407,7 +744,7 @@ ESD_PARAMETER(c, Type = ft_rgb32_t, DisplayName = "Color")
 inline static ft_void_t Esd_Dl_CLEAR_COLOR_RGB(ft_rgb32_t c)
 {
 	ft_rgb32_t rgb = c & 0xFFFFFF;
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, CLEAR_COLOR_RGB(0, 0, 0) | (rgb));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, CLEAR_COLOR_RGB(0, 0, 0) | (rgb));
 }
 
 // Specify clear color alpha channel
@@ -415,7 +752,7 @@ ESD_FUNCTION(Esd_Dl_CLEAR_COLOR_A, Type = ft_void_t, Category = EveRenderFunctio
 ESD_PARAMETER(alpha, Type = ft_uint8_t, Default = 255, Min = 0, Max = 255)
 inline static ft_void_t Esd_Dl_CLEAR_COLOR_A(ft_uint8_t alpha)
 {
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, CLEAR_COLOR_A(alpha));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, CLEAR_COLOR_A(alpha));
 }
 
 // Specify clear color: Alpha(31~24 bit) + RGB(23~0 bit)
@@ -441,25 +778,13 @@ ESD_PARAMETER(s, Type = ft_uint8_t, DisplayName = "Clear Stencil")
 ESD_PARAMETER(t, Type = ft_uint8_t, DisplayName = "Clear Tag")
 inline static ft_void_t Esd_Dl_CLEAR(ft_uint8_t c, ft_uint8_t s, ft_uint8_t t)
 {
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, CLEAR(c, s, t));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, CLEAR(c, s, t));
 }
 
 /*
 
-#define STENCIL_FUNC(func,ref,mask) ((10UL<<24)|(((func)&7UL)<<16)|(((ref)&255UL)<<8)|(((mask)&255UL)<<0))
-#define BLEND_FUNC(src,dst) ((11UL<<24)|(((src)&7UL)<<3)|(((dst)&7UL)<<0))
-#define STENCIL_OP(sfail,spass) ((12UL<<24)|(((sfail)&7UL)<<3)|(((spass)&7UL)<<0))
 #define CLEAR_STENCIL(s) ((17UL<<24)|(((s)&255UL)<<0))
 #define CLEAR_TAG(s) ((18UL<<24)|(((s)&255UL)<<0))
-#define STENCIL_MASK(mask) ((19UL<<24)|(((mask)&255UL)<<0))
-#define TAG_MASK(mask) ((20UL<<24)|(((mask)&1UL)<<0))
-#define BITMAP_TRANSFORM_A(a) ((21UL<<24)|(((a)&131071UL)<<0))
-#define BITMAP_TRANSFORM_B(b) ((22UL<<24)|(((b)&131071UL)<<0))
-#define BITMAP_TRANSFORM_C(c) ((23UL<<24)|(((c)&16777215UL)<<0))
-#define BITMAP_TRANSFORM_D(d) ((24UL<<24)|(((d)&131071UL)<<0))
-#define BITMAP_TRANSFORM_E(e) ((25UL<<24)|(((e)&131071UL)<<0))
-#define BITMAP_TRANSFORM_F(f) ((26UL<<24)|(((f)&16777215UL)<<0))
-#define COLOR_MASK(r,g,b,a) ((32UL<<24)|(((r)&1UL)<<3)|(((g)&1UL)<<2)|(((b)&1UL)<<1)|(((a)&1UL)<<0))
 #define CLEAR(c,s,t) ((38UL<<24)|(((c)&1UL)<<2)|(((s)&1UL)<<1)|(((t)&1UL)<<0))
 #define NOP() ((45UL<<24))
 // #define CLEAR_COLOR_A(alpha) ((15UL<<24)|(((alpha)&255UL)<<0))
@@ -481,8 +806,6 @@ inline static ft_void_t Esd_Dl_CLEAR(ft_uint8_t c, ft_uint8_t s, ft_uint8_t t)
 // Not exposed. #define JUMP(dest) ((30UL<<24)|(((dest)&65535UL)<<0))
 // Not exposed. #define BITMAP_LAYOUT_H(linestride,height) ((40UL<<24)|(((linestride)&3UL)<<2)|(((height)&3UL)<<0))
 // Not exposed. #define BITMAP_SIZE_H(width,height) ((41UL<<24)|(((width)&3UL)<<2)|(((height)&3UL)<<0))
-// Not exposed. #define VERTEX_TRANSLATE_X(x) ((43UL<<24)|(((x)&131071UL)<<0))
-// Not exposed. #define VERTEX_TRANSLATE_Y(y) ((44UL<<24)|(((y)&131071UL)<<0))
 // Not exposed. #define RETURN() ((36UL<<24))
 // Not exposed. #define MACRO(m) ((37UL<<24)|(((m)&1UL)<<0))
 // Not exposed. #define DISPLAY() ((0UL<<24))
@@ -500,22 +823,8 @@ ft_void_t FT_Esd_Dl_CLEAR_COLOR_RGB(ft_uint32_t c);
 // ft_void_t Esd_Dl_BITMAP_LAYOUT(ft_uint16_t format, ft_uint16_t linestride, ft_uint16_t height);
 // ft_void_t Esd_Dl_BITMAP_SIZE(ft_uint16_t filter, ft_uint16_t wrapx, ft_uint16_t wrapy, ft_uint16_t width, ft_uint16_t height);
 
-ft_void_t Esd_Dl_ALPHA_FUNC(ft_uint16_t func, ft_uint16_t ref);
-ft_void_t Esd_Dl_STENCIL_FUNC(ft_uint16_t func, ft_uint16_t ref, ft_uint16_t mask);
-ft_void_t Esd_Dl_BLEND_FUNC(ft_uint16_t src, ft_uint16_t dst);
-ft_void_t Esd_Dl_STENCIL_OP(ft_uint16_t sfail, ft_uint16_t spass);
-
 ft_void_t Esd_Dl_CLEAR_STENCIL(ft_uint8_t s);
 ft_void_t Esd_Dl_CLEAR_TAG(ft_uint8_t s);
-ft_void_t Esd_Dl_STENCIL_MASK(ft_uint32_t mask);
-ft_void_t Esd_Dl_TAG_MASK(ft_uint32_t mask);
-
-ft_void_t Esd_Dl_BITMAP_TRANSFORM_A(ft_uint32_t a);
-ft_void_t Esd_Dl_BITMAP_TRANSFORM_B(ft_uint32_t b);
-ft_void_t Esd_Dl_BITMAP_TRANSFORM_C(ft_uint32_t c);
-ft_void_t Esd_Dl_BITMAP_TRANSFORM_D(ft_uint32_t d);
-ft_void_t Esd_Dl_BITMAP_TRANSFORM_E(ft_uint32_t e);
-ft_void_t Esd_Dl_BITMAP_TRANSFORM_F(ft_uint32_t f);
 
 // ft_void_t Esd_Dl_CALL(ft_uint16_t dest);
 // ft_void_t Esd_Dl_JUMP(ft_uint16_t dest);
@@ -525,8 +834,6 @@ ft_void_t Esd_Dl_BITMAP_TRANSFORM_F(ft_uint32_t f);
 
 // ft_void_t Esd_Dl_DISPLAY();
 
-ft_void_t Esd_Dl_COLOR_MASK(ft_uint8_t r, ft_uint8_t g, ft_uint8_t b, ft_uint8_t a);
-
 */
 
 ESD_CATEGORY(EveRenderFunctionsProto, DisplayName = "EVE Render Functions (Prototype)", Category = _GroupHidden)
@@ -4,6 +4,7 @@
 #include "FT_Esd_Primitives.h"
 #include "FT_Esd_Dl.h"
 #include "Ft_Esd_BitmapHandle.h"
+#include "Ft_Esd_Batch.h"
 
 extern EVE_HalContext *Ft_Esd_Host;
 
@@ -25,25 +26,32 @@ ft_void_t Ft_Esd_Render_RectangleF_Gradient(
 // Rectangle drawing with some logic to convert from radius to line width and width height to positions to simplify usage
 ft_void_t Ft_Esd_Render_RectangleF(ft_int32_f4_t x, ft_int32_f4_t y, ft_int32_f4_t w, ft_int32_f4_t h, ft_int32_f4_t radius, ft_argb32_t color)
 {
-	EVE_HalContext *phost = Ft_Esd_Host;
 	ft_int32_t width = radius + 8;
 	ft_int32_t x0 = x + radius;
 	ft_int32_t y0 = y + radius;
 	ft_int32_t x1 = x + w - 16 - radius;
 	ft_int32_t y1 = y + h - 16 - radius;
+#if ESD_BATCH_RENDER
+	Esd_Batch_Vertices(RECTS, color, width, x0, y0, x1, y1);
+#else
+	EVE_HalContext *phost = Ft_Esd_Host;
 	Ft_Esd_Dl_COLOR_ARGB(color);
 	Ft_Esd_Dl_LINE_WIDTH(width);
 	Ft_Esd_Dl_BEGIN(RECTS);
 #if (EVE_MODEL >= EVE_FT810)
 	Ft_Esd_Dl_VERTEX_FORMAT(4);
 #endif
-	Ft_Gpu_CoCmd_SendCmd(phost, VERTEX2F(x0, y0));
-	Ft_Gpu_CoCmd_SendCmd(phost, VERTEX2F(x1, y1));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x0, y0));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x1, y1));
 	Ft_Esd_Dl_END();
+#endif
 }
 
 ft_void_t Ft_Esd_Render_LineF(ft_int32_f4_t x0, ft_int32_f4_t y0, ft_int32_f4_t x1, ft_int32_f4_t y1, ft_int32_f3_t width, ft_argb32_t color)
 {
+#if ESD_BATCH_RENDER
+	Esd_Batch_Vertices(LINES, color, width, x0, y0, x1, y1);
+#else
 	EVE_HalContext *phost = Ft_Esd_Host;
 	Ft_Esd_Dl_COLOR_ARGB(color);
 	Ft_Esd_Dl_LINE_WIDTH(width);
@@ -51,9 +59,27 @@ ft_void_t Ft_Esd_Render_LineF(ft_int32_f4_t x0, ft_int32_f4_t y0, ft_int32_f4_t
 #if (EVE_MODEL >= EVE_FT810)
 	Ft_Esd_Dl_VERTEX_FORMAT(4);
 #endif
-	Ft_Gpu_CoCmd_SendCmd(phost, VERTEX2F(x0, y0));
-	Ft_Gpu_CoCmd_SendCmd(phost, VERTEX2F(x1, y1));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x0, y0));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x1, y1));
+	Ft_Esd_Dl_END();
+#endif
+}
+
+ft_void_t Esd_Render_Circle(ft_int32_f4_t x, ft_int32_f4_t y, ft_int32_f4_t radius, ft_argb32_t color)
+{
+#if ESD_BATCH_RENDER
+	Esd_Batch_Vertices(POINTS, color, radius, x, y, x, y);
+#else
+	EVE_HalContext *phost = Ft_Esd_Host;
+	Ft_Esd_Dl_COLOR_ARGB(color);
+	Ft_Esd_Dl_POINT_SIZE(radius);
+	Ft_Esd_Dl_BEGIN(POINTS);
+#if (EVE_MODEL >= EVE_FT810)
+	Ft_Esd_Dl_VERTEX_FORMAT(4);
+#endif
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x, y));
 	Ft_Esd_Dl_END();
+#endif
 }
 
 void Ft_Esd_Dl_Bitmap_Vertex(ft_int16_t x, ft_int16_t y, ft_uint8_t handle, ft_uint16_t cell)
@@ -66,13 +92,13 @@ void Ft_Esd_Dl_Bitmap_Vertex(ft_int16_t x, ft_int16_t y, ft_uint8_t handle, ft_u
 		Ft_Esd_Dl_BITMAP_HANDLE(handle);
 		Ft_Esd_Dl_Bitmap_Page(handle, cell >> 7);
 		Ft_Esd_Dl_CELL(cell & 0x7F);
-		Ft_Gpu_CoCmd_SendCmd(phost, VERTEX2F(x, y));
+		Eve_CoCmd_SendDl(phost, VERTEX2F(x, y));
 	}
 	else
 #endif
 	{
 		Ft_Esd_Dl_Bitmap_Page(handle, cell >> 7);
-		Ft_Gpu_CoCmd_SendCmd(phost, VERTEX2II(x, y, handle, cell));
+		Eve_CoCmd_SendDl(phost, VERTEX2II(x, y, handle, cell));
 	}
 }
 
@@ -81,18 +107,18 @@ void Ft_Esd_Dl_Bitmap_Vertex(ft_int16_t x, ft_int16_t y, ft_uint8_t handle, ft_u
 void Ft_Esd_Dl_Bitmap_Vertex_DXT1(ft_int16_t x, ft_int16_t y, ft_uint8_t handle, ft_uint8_t additional, ft_uint16_t cell, ft_uint16_t cells)
 {
 	EVE_HalContext *phost = Ft_Esd_Host;
-	Ft_Gpu_CoCmd_SendCmd(phost, BLEND_FUNC(ONE, ZERO));
-	Ft_Gpu_CoCmd_SendCmd(phost, COLOR_A(0x55));
+	Ft_Esd_Dl_BLEND_FUNC(ONE, ZERO);
+	Ft_Esd_Dl_COLOR_A(0x55);
 	Ft_Esd_Dl_Bitmap_Vertex(x, y, handle, cell);
-	Ft_Gpu_CoCmd_SendCmd(phost, BLEND_FUNC(ONE, ONE));
-	Ft_Gpu_CoCmd_SendCmd(phost, COLOR_A(0xAA));
+	Ft_Esd_Dl_BLEND_FUNC(ONE, ONE);
+	Ft_Esd_Dl_COLOR_A(0xAA);
 	Ft_Esd_Dl_Bitmap_Vertex(x, y, handle, cell + cells);
-	Ft_Gpu_CoCmd_SendCmd(phost, COLOR_MASK(1, 1, 1, 0));
+	Ft_Esd_Dl_COLOR_MASK(1, 1, 1, 0);
 	Ft_Gpu_CoCmd_Scale(phost, 4UL * 65536UL, 4UL * 65536UL); // Color pass, scaled up 4x, nearest
 	Ft_Gpu_CoCmd_SetMatrix(phost);
-	Ft_Gpu_CoCmd_SendCmd(phost, BLEND_FUNC(DST_ALPHA, ZERO));
+	Ft_Esd_Dl_BLEND_FUNC(DST_ALPHA, ZERO);
 	Ft_Esd_Dl_Bitmap_Vertex(x, y, additional, cell + cells);
-	Ft_Gpu_CoCmd_SendCmd(phost, BLEND_FUNC(ONE_MINUS_DST_ALPHA, ONE));
+	Ft_Esd_Dl_BLEND_FUNC(ONE_MINUS_DST_ALPHA, ONE);
 	Ft_Esd_Dl_Bitmap_Vertex(x, y, additional, cell);
 }
 
@@ -100,25 +126,58 @@ void Ft_Esd_Dl_Bitmap_Vertex_DXT1(ft_int16_t x, ft_int16_t y, ft_uint8_t handle,
 // NOTE: This function may only be used within a Ft_Esd_Dl_SAVE_CONTEXT block, because it does not clean up state
 void Ft_Esd_Dl_Bitmap_Vertex_PALETTED8(ft_int16_t x, ft_int16_t y, ft_uint8_t handle, ft_uint16_t cell, ft_uint32_t paletteAddr)
 {
-	EVE_HalContext *phost = Ft_Esd_Host;
 	Ft_Esd_Dl_Alpha_Func(ALWAYS, 0);
-	Ft_Gpu_CoCmd_SendCmd(phost, BLEND_FUNC(ONE, ZERO));
-	Ft_Gpu_CoCmd_SendCmd(phost, COLOR_MASK(0, 0, 0, 1));
+	Ft_Esd_Dl_BLEND_FUNC(ONE, ZERO);
+	Ft_Esd_Dl_COLOR_MASK(0, 0, 0, 1);
 	Ft_Esd_Dl_PALETTE_SOURCE(paletteAddr + 3);
 	Ft_Esd_Dl_Bitmap_Vertex(x, y, handle, cell);
-	Ft_Gpu_CoCmd_SendCmd(phost, BLEND_FUNC(DST_ALPHA, ONE_MINUS_DST_ALPHA));
-	Ft_Gpu_CoCmd_SendCmd(phost, COLOR_MASK(1, 0, 0, 0));
+	Ft_Esd_Dl_BLEND_FUNC(DST_ALPHA, ONE_MINUS_DST_ALPHA);
+	Ft_Esd_Dl_COLOR_MASK(1, 0, 0, 0);
 	Ft_Esd_Dl_PALETTE_SOURCE(paletteAddr + 2);
 	Ft_Esd_Dl_Bitmap_Vertex(x, y, handle, cell);
-	Ft_Gpu_CoCmd_SendCmd(phost, COLOR_MASK(0, 1, 0, 0));
+	Ft_Esd_Dl_COLOR_MASK(0, 1, 0, 0);
 	Ft_Esd_Dl_PALETTE_SOURCE(paletteAddr + 1);
 	Ft_Esd_Dl_Bitmap_Vertex(x, y, handle, cell);
-	Ft_Gpu_CoCmd_SendCmd(phost, COLOR_MASK(0, 0, 1, 0));
+	Ft_Esd_Dl_COLOR_MASK(0, 0, 1, 0);
 	Ft_Esd_Dl_PALETTE_SOURCE(paletteAddr);
 	Ft_Esd_Dl_Bitmap_Vertex(x, y, handle, cell);
 }
 #endif
 
+ft_void_t Ft_Esd_Render_Placeholder(ft_int16_t x, ft_int16_t y, ft_int16_t width, ft_int16_t height, Ft_Esd_BitmapInfo *bitmapInfo, ft_argb32_t c)
+{
+	Ft_Esd_BitmapInfo *placeholder;
+	ft_uint32_t alpha;
+
+	// Use the first placeholder bitmap which is loaded
+	for (placeholder = bitmapInfo->Placeholder; placeholder; placeholder = placeholder->Placeholder)
+	{
+		ft_uint8_t handle;
+		if (!placeholder->Width || !placeholder->Height)
+			continue;
+		handle = Ft_Esd_Dl_Bitmap_Setup(placeholder);
+		if (!FT_ESD_BITMAPHANDLE_VALID(handle))
+			continue;
+
+		Ft_Esd_Dl_Bitmap_WidthHeight_BILINEAR(handle, width, height);
+		Ft_Esd_Dl_COLOR_ARGB(c);
+		Ft_Esd_Dl_SAVE_CONTEXT();
+		Ft_Gpu_CoCmd_Scale(Ft_Esd_Host, (((ft_int32_f16_t)width) << 16) / placeholder->Width, (((ft_int32_f16_t)height) << 16) / placeholder->Height);
+		Ft_Gpu_CoCmd_SetMatrix(Ft_Esd_Host);
+		Ft_Esd_Dl_BEGIN(BITMAPS);
+		Ft_Esd_Dl_Bitmap_Vertex(x, y, handle, 0);
+		Ft_Esd_Dl_END();
+		Ft_Gpu_CoCmd_LoadIdentity(Ft_Esd_Host);
+		Ft_Esd_Dl_RESTORE_CONTEXT();
+		return;
+	}
+
+	// Otherwise fill the area, faded along with the bitmap
+	alpha = ((bitmapInfo->PlaceholderColor >> 24) * (c >> 24)) / 255;
+	if (alpha)
+		Ft_Esd_Render_Rectangle(x, y, width, height, 0, (bitmapInfo->PlaceholderColor & 0xFFFFFF) | (alpha << 24));
+}
+
 void Ft_Esd_Render_Bitmap(ft_int16_t x, ft_int16_t y, Ft_Esd_BitmapCell bitmapCell, ft_argb32_t c)
 {
 	Ft_Esd_BitmapInfo *bitmapInfo;
@@ -141,6 +200,19 @@ void Ft_Esd_Render_Bitmap(ft_int16_t x, ft_int16_t y, Ft_Esd_BitmapCell bitmapCe
 		    : FT_ESD_BITMAPHANDLE_INVALID;
 
 		Ft_Esd_Dl_Bitmap_WidthHeightReset(handle);
+#if ESD_BATCH_RENDER
+		if (!FT_ESD_BITMAPHANDLE_VALID(additional)
+#if (EVE_MODEL >= EVE_FT810)
+		    && bitmapInfo->Format != PALETTED8
+#endif
+		)
+		{
+			// Page is set before queueing, changing it again writes out the queue
+			Ft_Esd_Dl_Bitmap_Page(handle, cell >> 7);
+			Esd_Batch_Bitmap(x, y, handle, cell, c, bitmapInfo->Width, bitmapInfo->Height);
+			return;
+		}
+#endif
 		Ft_Esd_Dl_COLOR_ARGB(c);
 		Ft_Esd_Dl_BEGIN(BITMAPS);
 #if (EVE_MODEL >= EVE_FT810)
@@ -172,6 +244,11 @@ void Ft_Esd_Render_Bitmap(ft_int16_t x, ft_int16_t y, Ft_Esd_BitmapCell bitmapCe
 		}
 		Ft_Esd_Dl_END();
 	}
+	else
+	{
+		// Not loaded yet
+		Ft_Esd_Render_Placeholder(x, y, bitmapInfo->Width, bitmapInfo->Height, bitmapInfo, c);
+	}
 }
 
 ft_void_t Ft_Esd_Render_BitmapScaled(ft_int16_t x, ft_int16_t y, Ft_Esd_BitmapCell bitmapCell, ft_argb32_t c, ft_int32_f16_t xscale, ft_int32_f16_t yscale, ft_int32_f16_t xoffset, ft_int32_f16_t yoffset, ft_int16_t width, ft_int16_t height)
@@ -230,6 +307,20 @@ ft_void_t Ft_Esd_Render_BitmapScaled(ft_int16_t x, ft_int16_t y, Ft_Esd_BitmapCe
 		Ft_Gpu_CoCmd_LoadIdentity(Ft_Esd_Host);
 		Ft_Esd_Dl_RESTORE_CONTEXT();
 	}
+	else if (bitmapInfo->Placeholder || bitmapInfo->PlaceholderColor)
+	{
+		// Not loaded yet, stretch the placeholder over the scaled bitmap area, within the rendering boundary
+		Ft_Esd_Rect16 boundary = {
+			.X = x,
+			.Y = y,
+			.Width = width,
+			.Height = height,
+		};
+		Ft_Esd_Rect16 state = Ft_Esd_Dl_Scissor_Set(boundary);
+		Ft_Esd_Render_Placeholder(x + (xoffset >> 16), y + (yoffset >> 16),
+		    (ft_int16_t)((bitmapInfo->Width * xscale) >> 16), (ft_int16_t)((bitmapInfo->Height * yscale) >> 16), bitmapInfo, c);
+		Ft_Esd_Dl_Scissor_Reset(state);
+	}
 }
 
 // Render bitmap using freeform rectangle within a specified global screen rectangle, freeform is relative to global
@@ -313,7 +404,7 @@ ft_void_t Ft_Esd_Render_BitmapRotate_Scaled(Ft_Esd_BitmapCell bitmapCell, ft_arg
 		Ft_Gpu_CoCmd_SetMatrix(Ft_Esd_Host);
 		Ft_Gpu_CoCmd_LoadIdentity(Ft_Esd_Host);
 		Ft_Esd_Dl_BEGIN(BITMAPS);
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(x * 16, y * 16));
+		Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2F(x * 16, y * 16));
 		Ft_Esd_Dl_END();
 		Ft_Esd_Dl_RESTORE_CONTEXT();
 	}
@@ -376,7 +467,7 @@ ft_void_t Ft_Esd_Render_BitmapRotate(Ft_Esd_BitmapCell bitmapCell, ft_argb32_t c
 					//Ft_Gpu_CoCmd_Translate(Ft_Esd_Host, -x_center, -y_center);
 
 					Ft_Gpu_CoCmd_SetMatrix(Ft_Esd_Host);
-					Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(dx * 16, dy * 16));
+					Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2F(dx * 16, dy * 16));
 				}
 			}
 		}
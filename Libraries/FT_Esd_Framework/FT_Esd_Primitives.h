@@ -71,6 +71,14 @@ ESD_PARAMETER(bottomLeft, Type = ft_rgb32_t, DisplayName = "Bottom Left", Defaul
 ESD_PARAMETER(bottomRight, Type = ft_rgb32_t, DisplayName = "Bottom Right", Default = #00D1FF)
 ft_void_t Esd_Render_MultiGradient_Rounded(ft_int16_t x, ft_int16_t y, ft_int16_t width, ft_int16_t height, ft_int32_f4_t radius, ft_uint8_t alpha, ft_argb32_t topLeft, ft_argb32_t topRight, ft_argb32_t bottomLeft, ft_argb32_t bottomRight);
 
+// Filled circle
+ESD_RENDER(Esd_Render_Circle, Type = ft_void_t, DisplayName = "ESD Circle (Fixed Point)", Include = "FT_Esd_Primitives.h", Category = EsdPrimitives)
+ESD_PARAMETER(x, Type = ft_int32_f4_t, Default = 0)
+ESD_PARAMETER(y, Type = ft_int32_f4_t, Default = 0)
+ESD_PARAMETER(radius, Type = ft_int32_f4_t, Default = 160)
+ESD_PARAMETER(color, Type = ft_argb32_t, DisplayName = "Color", Default = #FFFFFFFF)
+ft_void_t Esd_Render_Circle(ft_int32_f4_t x, ft_int32_f4_t y, ft_int32_f4_t radius, ft_argb32_t color);
+
 // Circle stroke
 ft_void_t Esd_Render_Circle_Stroke(
     ft_int32_f4_t x, ft_int32_f4_t y,
@@ -84,6 +92,9 @@ ft_void_t Esd_Render_Rect_Stroke(
     ft_int32_f4_t radius, ft_int32_f4_t border,
     uint8_t stroke, ft_argb32_t color);
 
+// Draw a bitmap cell vertex, switching the handle page and vertex format as needed
+void Ft_Esd_Dl_Bitmap_Vertex(ft_int16_t x, ft_int16_t y, ft_uint8_t handle, ft_uint16_t cell);
+
 // Basic bitmap rendering
 ESD_RENDER(Ft_Esd_Render_Bitmap, Type = ft_void_t, DisplayName = "ESD Bitmap", Category = EsdPrimitives, Icon = ":/icons/image.png", Include = "FT_Esd_Primitives.h")
 ESD_PARAMETER(x, Type = ft_int16_t, Default = 0)
@@ -114,6 +125,9 @@ ESD_PARAMETER(width, Type = ft_int16_t, DisplayName = "Render Width", Default =
 ESD_PARAMETER(height, Type = ft_int16_t, DisplayName = "Render Height", Default = 100)
 ft_void_t Ft_Esd_Render_BitmapScaled(ft_int16_t x, ft_int16_t y, Ft_Esd_BitmapCell bitmapCell, ft_argb32_t c, ft_int32_f16_t xscale, ft_int32_f16_t yscale, ft_int32_f16_t xoffset, ft_int32_f16_t yoffset, ft_int16_t width, ft_int16_t height);
 
+// Render the placeholder of a bitmap which is not loaded yet, stretched over the given area
+ft_void_t Ft_Esd_Render_Placeholder(ft_int16_t x, ft_int16_t y, ft_int16_t width, ft_int16_t height, Ft_Esd_BitmapInfo *bitmapInfo, ft_argb32_t c);
+
 // Render bitmap using freeform rectangle within a specified global screen rectangle, freeform is relative to global
 ft_void_t Ft_Esd_Render_BitmapFreeform(Ft_Esd_BitmapCell bitmapCell, ft_argb32_t c, Ft_Esd_Rect16 globalRect, Ft_Esd_Rect16 freeformRect, ft_uint8_t minAlpha);
 
@@ -0,0 +1,240 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#include "Ft_Esd_Atlas.h"
+#include "Ft_Esd_BitmapHandle.h"
+#include "Ft_Esd_Batch.h"
+#include "Ft_Esd_CoCmd.h"
+#include "Ft_Esd_Core.h"
+#include "FT_Esd_Primitives.h"
+
+extern EVE_HalContext *Ft_Esd_Host;
+extern Ft_Esd_GpuAlloc *Ft_Esd_GAlloc;
+
+static ft_bool_t canPack(Ft_Esd_BitmapInfo *bitmapInfo)
+{
+	switch (bitmapInfo->Format)
+	{
+	case DXT1:
+	case JPEG:
+	case PNG:
+#if (EVE_MODEL >= EVE_FT810)
+	case PALETTED565:
+	case PALETTED4444:
+	case PALETTED8:
+#endif
+		return FT_FALSE;
+	}
+	return !bitmapInfo->CoLoad;
+}
+
+static ft_bool_t sameLayout(Ft_Esd_BitmapInfo *a, Ft_Esd_BitmapInfo *b)
+{
+	return a->Format == b->Format
+	    && a->Width == b->Width
+	    && a->Height == b->Height
+	    && a->Stride == b->Stride;
+}
+
+// Calculate the offset of each image, returns the total size, or 0 if the images cannot be packed
+static ft_uint32_t layoutAtlas(Esd_Atlas *atlas)
+{
+	Ft_Esd_BitmapInfo *first;
+	ft_uint32_t size = 0;
+	ft_uint16_t i;
+
+	if (!atlas->NbImages || atlas->NbImages > ESD_ATLAS_MAX)
+	{
+		eve_printf_debug("Atlas must have between 1 and %i images\n", (int)ESD_ATLAS_MAX);
+		return 0;
+	}
+
+	// Cells are consecutive at Stride * Height bytes, and limited to 128 per page
+	first = atlas->Images[0];
+	atlas->Cells = atlas->NbImages <= 128
+	    && first->Size == first->Stride * first->Height
+#if (EVE_MODEL >= EVE_BT815)
+	    && !ESD_IS_FORMAT_ASTC(first->Format)
+#endif
+	    ;
+
+	for (i = 0; i < atlas->NbImages; ++i)
+	{
+		Ft_Esd_BitmapInfo *bitmapInfo = atlas->Images[i];
+		if (!canPack(bitmapInfo))
+		{
+			eve_printf_debug("Atlas image %i cannot be packed\n", (int)i);
+			return 0;
+		}
+		atlas->Cells = atlas->Cells && sameLayout(first, bitmapInfo) && first->Size == bitmapInfo->Size;
+	}
+
+	for (i = 0; i < atlas->NbImages; ++i)
+	{
+		atlas->Offsets[i] = size;
+		size += atlas->Cells ? (ft_uint32_t)atlas->Images[i]->Size : ((atlas->Images[i]->Size + 3UL) & ~3UL);
+	}
+
+	return size;
+}
+
+ft_uint32_t Esd_LoadAtlas(Esd_Atlas *atlas)
+{
+	ft_uint32_t addr;
+
+	if (!atlas)
+		return GA_INVALID;
+
+	addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, atlas->GpuHandle);
+	if (addr == GA_INVALID)
+	{
+		ft_uint32_t size;
+		ft_uint16_t i;
+
+		// The offsets and cell mode are not stored in RAM_G, so the layout is calculated before adopting
+		size = layoutAtlas(atlas);
+		if (!size)
+			return GA_INVALID;
+
+		// The contents may still be in RAM_G from before the allocator was reset, with the same layout
+		addr = Ft_Esd_GpuAlloc_Adopt(Ft_Esd_GAlloc, &atlas->GpuHandle, atlas->Persistent ? 0 : GA_GC_FLAG);
+		if (addr != GA_INVALID)
+		{
+			atlas->Current = ESD_ATLAS_NONE;
+			return ESD_DL_RAM_G_ADDRESS(addr);
+		}
+
+		// Not loaded, load all the images into one block
+		atlas->GpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, size, atlas->Persistent ? 0 : GA_GC_FLAG);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, atlas->GpuHandle, atlas, "<atlas>");
+		addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, atlas->GpuHandle);
+		if (addr == GA_INVALID)
+		{
+			eve_printf_debug("Unable to allocate space for atlas\n");
+			return GA_INVALID;
+		}
+
+		for (i = 0; i < atlas->NbImages; ++i)
+		{
+			if (!Ft_Esd_LoadBitmapAt(atlas->Images[i], addr + atlas->Offsets[i]))
+			{
+				eve_printf_debug("Failed to load atlas image %i\n", (int)i);
+				Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, atlas->GpuHandle);
+				return GA_INVALID;
+			}
+		}
+		Ft_Esd_GpuAlloc_Seal(Ft_Esd_GAlloc, &atlas->GpuHandle);
+		atlas->Current = ESD_ATLAS_NONE;
+	}
+
+	return ESD_DL_RAM_G_ADDRESS(addr);
+}
+
+// Point the handle to an image, the layout is set again only if it differs from the current image
+static void setImage(Esd_Atlas *atlas, ft_uint8_t handle, ft_uint32_t addr, ft_uint16_t image)
+{
+	Ft_Esd_BitmapInfo *bitmapInfo = atlas->Images[image];
+
+	if (atlas->Current != ESD_ATLAS_NONE && sameLayout(atlas->Images[atlas->Current], bitmapInfo))
+	{
+		Ft_Esd_Dl_BITMAP_HANDLE(handle);
+		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SOURCE(addr + atlas->Offsets[image]));
+	}
+	else
+	{
+		Ft_Esd_Dl_BITMAP_HANDLE(handle);
+#if (EVE_MODEL >= EVE_FT810)
+		Ft_Gpu_CoCmd_SetBitmap(Ft_Esd_Host, addr + atlas->Offsets[image], bitmapInfo->Format, bitmapInfo->Width, bitmapInfo->Height);
+#else
+		eve_assert_ex(false, "No support yet in ESD for bitmaps for FT800 target");
+#endif
+#if (EVE_MODEL >= EVE_BT815)
+		// Important. Bitmap swizzle not reset by SETBITMAP
+		if (bitmapInfo->Swizzle)
+			Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SWIZZLE(bitmapInfo->SwizzleR, bitmapInfo->SwizzleG, bitmapInfo->SwizzleB, bitmapInfo->SwizzleA));
+		else
+			Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SWIZZLE(RED, GREEN, BLUE, ALPHA));
+#endif
+		Esd_CurrentContext->HandleState.Size[handle] = 0;
+	}
+
+	// The scratch handle may be changed by anything else, so it is always set up again
+	atlas->Current = (handle != ESD_CO_SCRATCH_HANDLE) ? image : ESD_ATLAS_NONE;
+}
+
+ft_uint8_t Esd_Dl_Atlas_Setup(Esd_Atlas *atlas, ft_uint16_t image, ft_uint16_t *cell)
+{
+	Esd_HandleState *state = &Esd_CurrentContext->HandleState;
+	ft_uint32_t addr = Esd_LoadAtlas(atlas);
+	ft_uint32_t handle;
+
+	*cell = 0;
+	if (addr == GA_INVALID || image >= atlas->NbImages)
+		return FT_ESD_BITMAPHANDLE_INVALID;
+
+	handle = atlas->BitmapHandle;
+	if (!(FT_ESD_BITMAPHANDLE_VALID(handle)
+	        && (handle != ESD_CO_SCRATCH_HANDLE)
+	        && (state->Info[handle] == atlas)
+	        && (state->GpuHandle[handle].Id == atlas->GpuHandle.Id)
+	        && (state->GpuHandle[handle].Seq == atlas->GpuHandle.Seq)))
+	{
+		if (Esd_CurrentContext->LoopState != ESD_LOOPSTATE_RENDER)
+		{
+			eve_printf_debug("Warning: Can only setup atlas during render pass\n");
+			return FT_ESD_BITMAPHANDLE_INVALID;
+		}
+
+		// Find a free handle, falls back to scratch handle
+		handle = Esd_BitmapHandle_Attach(state, atlas, atlas->GpuHandle);
+		atlas->BitmapHandle = handle;
+		atlas->Current = ESD_ATLAS_NONE;
+	}
+	else
+	{
+		++state->Hits;
+	}
+
+	if (atlas->Cells)
+	{
+		// All images share the layout of the first image
+		if (atlas->Current == ESD_ATLAS_NONE)
+			setImage(atlas, handle, addr, 0);
+		*cell = image;
+	}
+	else if (atlas->Current != image)
+	{
+		setImage(atlas, handle, addr, image);
+	}
+
+	Esd_BitmapHandle_Use(state, handle);
+	return handle;
+}
+
+void Esd_Render_Atlas(ft_int16_t x, ft_int16_t y, Esd_Atlas *atlas, ft_uint16_t image, ft_argb32_t c)
+{
+	ft_uint16_t cell;
+	ft_uint8_t handle;
+
+	if (!atlas)
+		return;
+
+	handle = Esd_Dl_Atlas_Setup(atlas, image, &cell);
+	if (!FT_ESD_BITMAPHANDLE_VALID(handle))
+		return;
+
+#if ESD_BATCH_RENDER
+	// Switching images writes out the queue, since it changes the handle
+	Esd_Batch_Bitmap(x, y, handle, cell, c, atlas->Images[image]->Width, atlas->Images[image]->Height);
+#else
+	Ft_Esd_Dl_COLOR_ARGB(c);
+	Ft_Esd_Dl_BEGIN(BITMAPS);
+	Ft_Esd_Dl_Bitmap_Vertex(x, y, handle, cell);
+	Ft_Esd_Dl_END();
+#endif
+}
+
+/* end of file */
@@ -0,0 +1,74 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#ifndef ESD_ATLAS_H
+#define ESD_ATLAS_H
+
+#include "Ft_Esd.h"
+#include "Ft_Esd_BitmapInfo.h"
+
+// Pack small bitmaps into a single RAM_G block which is drawn through one shared bitmap handle.
+// When all images have the same format and dimensions, they are packed as consecutive cells of one bitmap,
+// and drawing any image only changes the cell. Otherwise switching between images changes the BITMAP_SOURCE
+// offset, and only sets the layout again when it differs from the previous image.
+// Images which are decoded by the coprocessor (JPEG, PNG), DXT1 and paletted images cannot be packed
+
+// Maximum number of images in an atlas
+#ifndef ESD_ATLAS_MAX
+#define ESD_ATLAS_MAX 64
+#endif
+
+#define ESD_ATLAS_NONE 0xFFFF
+
+ESD_TYPE(Esd_Atlas, Native = Struct)
+typedef struct
+{
+	// Images packed into the atlas, these are not loaded individually
+	Ft_Esd_BitmapInfo *const *Images;
+	ft_uint16_t NbImages;
+
+	// When this is set, the allocated ram is not free'd automatically
+	// Use Ft_Esd_GpuAlloc_Free(GpuAlloc, GpuHandle) to free the GPU ram manually
+	ft_bool_t Persistent;
+
+	// (Runtime) Handle pointing to the address in RAM_G of the whole atlas if it is allocated
+	Ft_Esd_GpuHandle GpuHandle;
+
+	// (Runtime) Offset of each image from the start of the atlas
+	ft_uint32_t Offsets[ESD_ATLAS_MAX];
+
+	// (Runtime) All images have the same layout, and are drawn as cells
+	ft_bool_t Cells;
+
+	// (Runtime) Bitmap handle that is being used, and the image it is set up for
+	ft_uint32_t BitmapHandle;
+	ft_uint16_t Current;
+
+} Esd_Atlas;
+
+ESD_TYPE(Esd_Atlas *, Native = Pointer, Edit = Library)
+
+/// Load all images of the atlas into RAM_G, returns the address of the atlas in BITMAP_SOURCE format
+ESD_FUNCTION(Esd_LoadAtlas, Type = ft_uint32_t, Include = "Ft_Esd_Atlas.h", DisplayName = "Load Atlas to RAM_G", Category = EsdUtilities)
+ESD_PARAMETER(atlas, Type = Esd_Atlas *)
+ft_uint32_t Esd_LoadAtlas(Esd_Atlas *atlas);
+
+/// Prepares the shared handle of the atlas for one of its images. Call during render to get the bitmap handle and cell
+ft_uint8_t Esd_Dl_Atlas_Setup(Esd_Atlas *atlas, ft_uint16_t image, ft_uint16_t *cell);
+
+/// Render one image of an atlas
+ESD_RENDER(Esd_Render_Atlas, Type = ft_void_t, DisplayName = "ESD Atlas Image", Category = EsdPrimitives, Icon = ":/icons/image.png", Include = "Ft_Esd_Atlas.h")
+ESD_PARAMETER(x, Type = ft_int16_t, Default = 0)
+ESD_PARAMETER(y, Type = ft_int16_t, Default = 0)
+ESD_PARAMETER(atlas, Type = Esd_Atlas *, DisplayName = "Atlas")
+ESD_PARAMETER(image, Type = ft_uint16_t, DisplayName = "Image", Default = 0)
+// Color to be multiplied with bitmap color, can be used for alpha fade for example
+ESD_PARAMETER(c, Type = ft_argb32_t, DisplayName = "Color", Default = #FFFFFFFF)
+void Esd_Render_Atlas(ft_int16_t x, ft_int16_t y, Esd_Atlas *atlas, ft_uint16_t image, ft_argb32_t c);
+
+#endif /* #ifndef ESD_ATLAS_H */
+
+/* end of file */
@@ -0,0 +1,234 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#include "Ft_Esd_Batch.h"
+#include "FT_Esd_Dl.h"
+#include "FT_Esd_Primitives.h"
+
+#if ESD_BATCH_RENDER
+
+extern EVE_HalContext *Ft_Esd_Host;
+
+typedef struct
+{
+	ft_argb32_t Color;
+	ft_int16_f4_t Width; // LINE_WIDTH or POINT_SIZE
+	ft_uint8_t Primitive;
+	ft_uint8_t Handle; // BITMAPS only
+	ft_uint16_t Cell; // BITMAPS only
+	ft_int32_f4_t X0, Y0, X1, Y1; // Vertices, or the bitmap position in pixels
+	ft_int32_f4_t Left, Top, Right, Bottom; // Covered area, including antialiasing
+
+} Esd_BatchItem;
+
+static Esd_BatchItem s_BatchItems[ESD_BATCH_SIZE];
+static ft_uint16_t s_BatchNb;
+
+#if ESD_DL_OPTIMIZE
+// Cached state which the queued primitives will change when written
+static ft_rgb32_t s_ColorRGB;
+static ft_uint16_t s_ColorA;
+static ft_int16_f4_t s_LineWidth;
+static ft_int16_f4_t s_PointSize;
+static ft_uint8_t s_Handle;
+static ft_uint8_t s_Cell;
+#if (EVE_MODEL >= EVE_FT810)
+static ft_uint8_t s_VertexFormat;
+#endif
+static ft_uint8_t s_Primitive;
+#endif
+
+static bool cbCmdDeferred(EVE_HalContext *phost)
+{
+	(void)phost; // Always Ft_Esd_Host
+	Esd_Batch_Flush();
+	return true;
+}
+
+// Take over the cached state which the queued primitives will change.
+// Until the queue is written, the cache must not skip writing this state,
+// since anything written to the command buffer writes the queue first
+static void beginQueue()
+{
+#if ESD_DL_OPTIMIZE
+	s_ColorRGB = FT_ESD_STATE.ColorRGB;
+	s_ColorA = FT_ESD_STATE.ColorA;
+	s_LineWidth = FT_ESD_STATE.LineWidth;
+	s_PointSize = FT_ESD_STATE.PointSize;
+	s_Handle = FT_ESD_STATE.Handle;
+	s_Cell = FT_ESD_STATE.Cell;
+#if (EVE_MODEL >= EVE_FT810)
+	s_VertexFormat = FT_ESD_STATE.VertexFormat;
+#endif
+	s_Primitive = Ft_Esd_Primitive;
+
+	// Byte value 0xFF does not match any valid cached value
+	FT_ESD_STATE.ColorRGB = 0xFFFFFFFF;
+	FT_ESD_STATE.ColorA = 0xFFFF;
+	FT_ESD_STATE.LineWidth = -1;
+	FT_ESD_STATE.PointSize = -1;
+	FT_ESD_STATE.Handle = 0xFF;
+	FT_ESD_STATE.Cell = 0xFF;
+#if (EVE_MODEL >= EVE_FT810)
+	FT_ESD_STATE.VertexFormat = 0xFF;
+#endif
+	Ft_Esd_Primitive = 0xFF;
+#endif
+
+	Ft_Esd_Host->CbCmdDeferred = cbCmdDeferred;
+}
+
+static void endQueue()
+{
+#if ESD_DL_OPTIMIZE
+	FT_ESD_STATE.ColorRGB = s_ColorRGB;
+	FT_ESD_STATE.ColorA = s_ColorA;
+	FT_ESD_STATE.LineWidth = s_LineWidth;
+	FT_ESD_STATE.PointSize = s_PointSize;
+	FT_ESD_STATE.Handle = s_Handle;
+	FT_ESD_STATE.Cell = s_Cell;
+#if (EVE_MODEL >= EVE_FT810)
+	FT_ESD_STATE.VertexFormat = s_VertexFormat;
+#endif
+	Ft_Esd_Primitive = s_Primitive;
+#endif
+}
+
+static ft_bool_t sameGroup(const Esd_BatchItem *a, const Esd_BatchItem *b)
+{
+	return a->Primitive == b->Primitive
+	    && a->Color == b->Color
+	    && (a->Primitive == BITMAPS || a->Width == b->Width);
+}
+
+static ft_bool_t overlaps(const Esd_BatchItem *a, const Esd_BatchItem *b)
+{
+	return a->Left < b->Right && b->Left < a->Right
+	    && a->Top < b->Bottom && b->Top < a->Bottom;
+}
+
+static void queue(const Esd_BatchItem *item)
+{
+	int i;
+
+	if (s_BatchNb == ESD_BATCH_SIZE)
+		Esd_Batch_Flush();
+	if (!s_BatchNb)
+		beginQueue();
+
+	// Join the last group with the same state, as long as the primitive
+	// does not overlap anything that was queued after that group
+	for (i = s_BatchNb - 1; i >= 0; --i)
+	{
+		if (sameGroup(&s_BatchItems[i], item))
+			break;
+		if (overlaps(&s_BatchItems[i], item))
+		{
+			i = s_BatchNb - 1;
+			break;
+		}
+	}
+	if (i < 0)
+		i = s_BatchNb - 1;
+
+	++i;
+	memmove(&s_BatchItems[i + 1], &s_BatchItems[i], (s_BatchNb - i) * sizeof(Esd_BatchItem));
+	s_BatchItems[i] = *item;
+	++s_BatchNb;
+}
+
+void Esd_Batch_Vertices(ft_uint8_t primitive, ft_argb32_t color, ft_int16_f4_t width, ft_int32_f4_t x0, ft_int32_f4_t y0, ft_int32_f4_t x1, ft_int32_f4_t y1)
+{
+	Esd_BatchItem item;
+	ft_int32_f4_t extent = width + 16;
+	item.Color = color;
+	item.Width = width;
+	item.Primitive = primitive;
+	item.Handle = 0;
+	item.Cell = 0;
+	item.X0 = x0;
+	item.Y0 = y0;
+	item.X1 = x1;
+	item.Y1 = y1;
+	item.Left = min(x0, x1) - extent;
+	item.Top = min(y0, y1) - extent;
+	item.Right = max(x0, x1) + extent;
+	item.Bottom = max(y0, y1) + extent;
+	queue(&item);
+}
+
+void Esd_Batch_Bitmap(ft_int16_t x, ft_int16_t y, ft_uint8_t handle, ft_uint16_t cell, ft_argb32_t color, ft_int16_t width, ft_int16_t height)
+{
+	Esd_BatchItem item;
+	item.Color = color;
+	item.Width = 0;
+	item.Primitive = BITMAPS;
+	item.Handle = handle;
+	item.Cell = cell;
+	item.X0 = x;
+	item.Y0 = y;
+	item.X1 = x;
+	item.Y1 = y;
+	item.Left = ((ft_int32_f4_t)x << 4) - 16;
+	item.Top = ((ft_int32_f4_t)y << 4) - 16;
+	item.Right = ((ft_int32_f4_t)(x + width) << 4) + 16;
+	item.Bottom = ((ft_int32_f4_t)(y + height) << 4) + 16;
+	queue(&item);
+}
+
+void Esd_Batch_Flush()
+{
+	EVE_HalContext *phost = Ft_Esd_Host;
+	ft_uint16_t nb = s_BatchNb;
+	ft_uint16_t i;
+
+	if (!nb)
+		return;
+
+	// Anything written from here on is the queue itself
+	s_BatchNb = 0;
+	phost->CbCmdDeferred = NULL;
+	endQueue();
+
+	for (i = 0; i < nb; ++i)
+	{
+		const Esd_BatchItem *item = &s_BatchItems[i];
+		Ft_Esd_Dl_COLOR_ARGB(item->Color);
+		if (item->Primitive == BITMAPS)
+		{
+			Ft_Esd_Dl_BEGIN(BITMAPS);
+			Ft_Esd_Dl_Bitmap_Vertex(item->X0, item->Y0, item->Handle, item->Cell);
+		}
+		else
+		{
+			if (item->Primitive == POINTS)
+				Ft_Esd_Dl_POINT_SIZE(item->Width);
+			else
+				Ft_Esd_Dl_LINE_WIDTH(item->Width);
+			Ft_Esd_Dl_BEGIN(item->Primitive);
+#if (EVE_MODEL >= EVE_FT810)
+			Ft_Esd_Dl_VERTEX_FORMAT(4);
+#endif
+			Eve_CoCmd_SendDl(phost, VERTEX2F(item->X0, item->Y0));
+			if (item->Primitive != POINTS)
+				Eve_CoCmd_SendDl(phost, VERTEX2F(item->X1, item->Y1));
+		}
+		Ft_Esd_Dl_END();
+	}
+}
+
+void Esd_Batch_Discard()
+{
+	if (s_BatchNb)
+	{
+		s_BatchNb = 0;
+		Ft_Esd_Host->CbCmdDeferred = NULL;
+	}
+}
+
+#endif
+
+/* end of file */
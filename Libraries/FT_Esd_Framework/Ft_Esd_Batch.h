@@ -0,0 +1,43 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#ifndef ESD_BATCH_H
+#define ESD_BATCH_H
+
+#include "Ft_Esd.h"
+
+// Batch simple primitives across widgets, grouped by primitive and color.
+// Primitives are queued until anything else is written to the command buffer,
+// and may be moved in front of earlier primitives which they do not overlap
+#ifndef ESD_BATCH_RENDER
+#define ESD_BATCH_RENDER 0
+#endif
+
+// Maximum number of queued primitives, the queue is written out when full
+#ifndef ESD_BATCH_SIZE
+#define ESD_BATCH_SIZE 64
+#endif
+
+#if ESD_BATCH_RENDER
+
+/// Queue two VERTEX2F vertices in 1/16th pixel units for RECTS, LINES, or POINTS.
+/// The width is the LINE_WIDTH for RECTS and LINES, and the POINT_SIZE for POINTS
+void Esd_Batch_Vertices(ft_uint8_t primitive, ft_argb32_t color, ft_int16_f4_t width, ft_int32_f4_t x0, ft_int32_f4_t y0, ft_int32_f4_t x1, ft_int32_f4_t y1);
+
+/// Queue a bitmap cell of a handle which has already been set up
+void Esd_Batch_Bitmap(ft_int16_t x, ft_int16_t y, ft_uint8_t handle, ft_uint16_t cell, ft_argb32_t color, ft_int16_t width, ft_int16_t height);
+
+/// Write all queued primitives
+void Esd_Batch_Flush();
+
+/// Drop all queued primitives, called when the display list is restarted
+void Esd_Batch_Discard();
+
+#endif
+
+#endif /* #ifndef ESD_BATCH_H */
+
+/* end of file */
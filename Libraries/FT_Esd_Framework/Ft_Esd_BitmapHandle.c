@@ -111,10 +111,94 @@ void Esd_BitmapHandle_FrameStart(Esd_HandleState *handleState)
 	}
 }
 
+#define ESD_LRU_NIL 0xFF
+
 /// Reset the bitmap handle state
 void Esd_BitmapHandle_Reset(Esd_HandleState *state)
 {
 	memset(state, 0, sizeof(Esd_HandleState));
+	for (int i = 0; i < FT_ESD_BITMAPHANDLE_NB; ++i)
+	{
+		state->LruPrev[i] = i ? (i - 1) : ESD_LRU_NIL;
+		state->LruNext[i] = (i + 1 < FT_ESD_BITMAPHANDLE_NB) ? (i + 1) : ESD_LRU_NIL;
+	}
+	state->LruFirst = 0;
+	state->LruLast = FT_ESD_BITMAPHANDLE_NB - 1;
+}
+
+// Mark the handle as in use, and move it to the front of the LRU list
+static void useHandle(Esd_HandleState *state, ft_uint8_t handle)
+{
+	state->Use[handle] = 2; // In use
+	if (state->LruFirst == handle)
+		return;
+
+	// Unlink
+	state->LruNext[state->LruPrev[handle]] = state->LruNext[handle];
+	if (state->LruNext[handle] != ESD_LRU_NIL)
+		state->LruPrev[state->LruNext[handle]] = state->LruPrev[handle];
+	else
+		state->LruLast = state->LruPrev[handle];
+
+	// Link at the front
+	state->LruPrev[handle] = ESD_LRU_NIL;
+	state->LruNext[handle] = state->LruFirst;
+	state->LruPrev[state->LruFirst] = handle;
+	state->LruFirst = handle;
+}
+
+// Find the least recently used handle that is not in use, or the scratch handle when all handles are in use.
+// Handles in use are always more recent than handles which are not in use
+static ft_uint8_t findHandle(Esd_HandleState *state)
+{
+	ft_uint8_t handle = state->LruLast;
+	if (handle == FT_ESD_SCRATCHHANDLE)
+		handle = state->LruPrev[handle];
+	if (handle != ESD_LRU_NIL && !state->Use[handle])
+		return handle;
+	return FT_ESD_SCRATCHHANDLE;
+}
+
+ft_uint8_t Esd_BitmapHandle_Attach(Esd_HandleState *state, void *info, Ft_Esd_GpuHandle gpuHandle)
+{
+	ft_uint8_t handle;
+
+	++state->Misses;
+	handle = findHandle(state);
+	if (handle != FT_ESD_SCRATCHHANDLE)
+	{
+		// Attach this handle to the resource
+		state->Info[handle] = info;
+		state->GpuHandle[handle] = gpuHandle;
+	}
+
+	// The caller sets up the handle from scratch
+	state->Resized[handle] = 0;
+	state->Page[handle] = 0;
+	state->Size[handle] = 0;
+	return handle;
+}
+
+void Esd_BitmapHandle_Use(Esd_HandleState *state, ft_uint8_t handle)
+{
+	if (FT_ESD_BITMAPHANDLE_VALID(handle) && (handle != FT_ESD_SCRATCHHANDLE)) // When valid and not using scratch handle
+	{
+		useHandle(state, handle);
+	}
+}
+
+void Esd_BitmapHandle_GpuMoved(Esd_HandleState *state, Ft_Esd_GpuHandle gpuHandle)
+{
+	for (int i = 0; i < FT_ESD_BITMAPHANDLE_NB; ++i)
+	{
+		if (state->GpuHandle[i].Id == gpuHandle.Id && state->GpuHandle[i].Seq == gpuHandle.Seq)
+		{
+			// The handle remains in use until the frames displaying it are gone
+			state->Info[i] = NULL;
+			state->GpuHandle[i].Id = MAX_NUM_ALLOCATIONS;
+			state->GpuHandle[i].Seq = 0;
+		}
+	}
 }
 
 ft_uint32_t Ft_Esd_BitmapHandle_GetTotalUsed()
@@ -194,19 +278,8 @@ ft_uint8_t Ft_Esd_Dl_Bitmap_Setup(Ft_Esd_BitmapInfo *bitmapInfo)
 			return FT_ESD_BITMAPHANDLE_INVALID;
 		}
 
-		// Find a free handle
-		handle = FT_ESD_SCRATCHHANDLE; // Fallback to scratch handle
-		for (int i = 0; i < FT_ESD_BITMAPHANDLE_NB; ++i)
-		{
-			if ((i != FT_ESD_SCRATCHHANDLE) && (!Esd_CurrentContext->HandleState.Use[i]))
-			{
-				// Attach this handle to the bitmap info
-				handle = i;
-				Esd_CurrentContext->HandleState.Info[i] = bitmapInfo;
-				Esd_CurrentContext->HandleState.GpuHandle[i] = bitmapInfo->GpuHandle;
-				break;
-			}
-		}
+		// Find a free handle, falls back to scratch handle
+		handle = Esd_BitmapHandle_Attach(&Esd_CurrentContext->HandleState, bitmapInfo, bitmapInfo->GpuHandle);
 
 		eve_printf_debug("Use handle %i, addr %i, gpu alloc %i, %i, file %s\n",
 		    (int)handle, (int)addr, (int)bitmapInfo->GpuHandle.Id, (int)bitmapInfo->GpuHandle.Seq,
@@ -235,8 +308,10 @@ ft_uint8_t Ft_Esd_Dl_Bitmap_Setup(Ft_Esd_BitmapInfo *bitmapInfo)
 		else
 			Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SWIZZLE(RED, GREEN, BLUE, ALPHA));
 #endif
-		Esd_CurrentContext->HandleState.Resized[handle] = 0;
-		Esd_CurrentContext->HandleState.Page[handle] = 0;
+	}
+	else
+	{
+		++Esd_CurrentContext->HandleState.Hits;
 	}
 
 	// TEMPORARY WORKAROUND: SetBitmap not correctly being applied some frames... Need to check!
@@ -248,10 +323,7 @@ ft_uint8_t Ft_Esd_Dl_Bitmap_Setup(Ft_Esd_BitmapInfo *bitmapInfo)
 	// Ft_Gpu_CoCmd_SetBitmap(Ft_Esd_Host, addr, format, bitmapInfo->Width, bitmapInfo->Height); // TODO: What with stride?
 	// Ft_Esd_BitmapHandleResized[handle] = 0;
 
-	if (FT_ESD_BITMAPHANDLE_VALID(handle) && (handle != FT_ESD_SCRATCHHANDLE)) // When valid and not using scratch handle
-	{
-		Esd_CurrentContext->HandleState.Use[handle] = 2; // In use
-	}
+	Esd_BitmapHandle_Use(&Esd_CurrentContext->HandleState, handle);
 
 #if (EVE_MODEL >= EVE_FT810)
 	// Use palette if available
@@ -298,20 +370,11 @@ ft_uint8_t Ft_Esd_Dl_Font_Setup(Esd_FontInfo *fontInfo)
 				return FT_ESD_BITMAPHANDLE_INVALID;
 			}
 
-			// Find a free handle
-			handle = FT_ESD_SCRATCHHANDLE; // Fallback to scratch handle
-			for (int i = 0; i < FT_ESD_BITMAPHANDLE_NB; ++i)
-			{
-				if ((i != FT_ESD_SCRATCHHANDLE) && (!Esd_CurrentContext->HandleState.Use[i]))
-				{
-					// Attach this handle to the bitmap info
-					handle = i;
-					Esd_CurrentContext->HandleState.Info[i] = romFontInfo;
-					Esd_CurrentContext->HandleState.GpuHandle[i].Id = MAX_NUM_ALLOCATIONS;
-					Esd_CurrentContext->HandleState.GpuHandle[i].Seq = font;
-					break;
-				}
-			}
+			// Find a free handle, falls back to scratch handle
+			Ft_Esd_GpuHandle romHandle;
+			romHandle.Id = MAX_NUM_ALLOCATIONS;
+			romHandle.Seq = font;
+			handle = Esd_BitmapHandle_Attach(&Esd_CurrentContext->HandleState, romFontInfo, romHandle);
 
 			eve_printf_debug("Use handle %i, font %i\n",
 			    (int)handle, (int)font);
@@ -322,8 +385,10 @@ ft_uint8_t Ft_Esd_Dl_Font_Setup(Esd_FontInfo *fontInfo)
 #if ESD_DL_OPTIMIZE
 			FT_ESD_STATE.Handle = handle;
 #endif
-			Esd_CurrentContext->HandleState.Resized[handle] = 0;
-			Esd_CurrentContext->HandleState.Page[handle] = 0;
+		}
+		else
+		{
+			++Esd_CurrentContext->HandleState.Hits;
 		}
 #else
 		romFontInfo->BitmapHandle = font;
@@ -351,19 +416,8 @@ ft_uint8_t Ft_Esd_Dl_Font_Setup(Esd_FontInfo *fontInfo)
 				return FT_ESD_BITMAPHANDLE_INVALID;
 			}
 
-			// Find a free handle
-			handle = FT_ESD_SCRATCHHANDLE; // Fallback to scratch handle
-			for (int i = 0; i < FT_ESD_BITMAPHANDLE_NB; ++i)
-			{
-				if ((i != FT_ESD_SCRATCHHANDLE) && (!Esd_CurrentContext->HandleState.Use[i]))
-				{
-					// Attach this handle to the font info
-					handle = i;
-					Esd_CurrentContext->HandleState.Info[i] = fontInfo;
-					Esd_CurrentContext->HandleState.GpuHandle[i] = fontInfo->FontResource.GpuHandle;
-					break;
-				}
-			}
+			// Find a free handle, falls back to scratch handle
+			handle = Esd_BitmapHandle_Attach(&Esd_CurrentContext->HandleState, fontInfo, fontInfo->FontResource.GpuHandle);
 
 			eve_printf_debug("Use handle %i, addr %i, %i, gpu alloc %i, %i, %i, %i, file %s, %s, flash %i, %i\n",
 			    (int)handle, (int)addr, (int)Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, fontInfo->GlyphResource.GpuHandle),
@@ -384,36 +438,52 @@ ft_uint8_t Ft_Esd_Dl_Font_Setup(Esd_FontInfo *fontInfo)
 #if ESD_DL_OPTIMIZE
 			FT_ESD_STATE.Handle = handle;
 #endif
-			Esd_CurrentContext->HandleState.Resized[handle] = 0;
-			Esd_CurrentContext->HandleState.Page[handle] = 0;
+		}
+		else
+		{
+			++Esd_CurrentContext->HandleState.Hits;
 		}
 	}
 
-	if (FT_ESD_BITMAPHANDLE_VALID(handle) && (handle != FT_ESD_SCRATCHHANDLE)) // When valid and not using scratch handle
-	{
-		Esd_CurrentContext->HandleState.Use[handle] = 2; // In use
-	}
+	Esd_BitmapHandle_Use(&Esd_CurrentContext->HandleState, handle);
 
 	return handle;
 }
 
-void Ft_Esd_Dl_Bitmap_WidthHeight(ft_uint8_t handle, ft_uint16_t width, ft_uint16_t height)
+void Ft_Esd_Dl_Bitmap_Size(ft_uint8_t handle, ft_uint8_t filter, ft_uint8_t wrapx, ft_uint8_t wrapy, ft_uint16_t width, ft_uint16_t height)
 {
+	ft_uint32_t sizeCmd = BITMAP_SIZE(filter, wrapx, wrapy, width & 0x1ff, height & 0x1ff);
+#if (EVE_MODEL >= EVE_FT810)
+	ft_uint32_t sizeHCmd = BITMAP_SIZE_H(width >> 9, height >> 9);
+#else
+	ft_uint32_t sizeHCmd = 0;
+#endif
+	// Bit 31 marks the size as known, BITMAP_SIZE is stored in the low 21 bits, BITMAP_SIZE_H above it
+	ft_uint32_t size = 0x80000000UL | (sizeCmd & 0x1FFFFFUL) | ((sizeHCmd & 0xFUL) << 21);
+
+	// The coprocessor may change the scratch handle, so it is never cached
+	ft_bool_t cached = FT_ESD_BITMAPHANDLE_VALID(handle) && (handle != FT_ESD_SCRATCHHANDLE);
+	if (cached && Esd_CurrentContext->HandleState.Size[handle] == size)
+		return;
+
 	Ft_Esd_Dl_BITMAP_HANDLE(handle);
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SIZE(NEAREST, BORDER, BORDER, width & 0x1ff, height & 0x1ff));
+	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, sizeCmd);
 #if (EVE_MODEL >= EVE_FT810)
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SIZE_H(width >> 9, height >> 9));
+	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, sizeHCmd);
 #endif
+	if (cached)
+		Esd_CurrentContext->HandleState.Size[handle] = size;
+}
+
+void Ft_Esd_Dl_Bitmap_WidthHeight(ft_uint8_t handle, ft_uint16_t width, ft_uint16_t height)
+{
+	Ft_Esd_Dl_Bitmap_Size(handle, NEAREST, BORDER, BORDER, width, height);
 	Esd_CurrentContext->HandleState.Resized[handle] = 1;
 }
 
 void Ft_Esd_Dl_Bitmap_WidthHeight_BILINEAR(ft_uint8_t handle, ft_uint16_t width, ft_uint16_t height)
 {
-	Ft_Esd_Dl_BITMAP_HANDLE(handle);
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SIZE(BILINEAR, BORDER, BORDER, width & 0x1ff, height & 0x1ff));
-#if (EVE_MODEL >= EVE_FT810)
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SIZE_H(width >> 9, height >> 9));
-#endif
+	Ft_Esd_Dl_Bitmap_Size(handle, BILINEAR, BORDER, BORDER, width, height);
 	Esd_CurrentContext->HandleState.Resized[handle] = 1;
 }
 
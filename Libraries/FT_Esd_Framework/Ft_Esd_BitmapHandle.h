@@ -20,6 +20,17 @@ typedef struct
 
 	ft_bool_t Resized[FT_ESD_BITMAPHANDLE_NB];
 	ft_uint8_t Page[FT_ESD_BITMAPHANDLE_NB];
+	ft_uint32_t Size[FT_ESD_BITMAPHANDLE_NB]; // Last BITMAP_SIZE and BITMAP_SIZE_H, 0 if unknown
+
+	// Handles ordered from most to least recently used, a new setup replaces the least recently used handle
+	ft_uint8_t LruPrev[FT_ESD_BITMAPHANDLE_NB];
+	ft_uint8_t LruNext[FT_ESD_BITMAPHANDLE_NB];
+	ft_uint8_t LruFirst;
+	ft_uint8_t LruLast;
+
+	// Number of setup calls which found their handle still set up, and which needed to set up a handle
+	ft_uint32_t Hits;
+	ft_uint32_t Misses;
 
 } Esd_HandleState;
 
@@ -32,6 +43,16 @@ void Esd_BitmapHandle_FrameStart(Esd_HandleState *state);
 /// Reset the bitmap handle state
 void Esd_BitmapHandle_Reset(Esd_HandleState *state);
 
+/// Find a handle for a resource which has no valid handle yet, falls back to the scratch handle.
+/// The handle is attached to the resource, and must be set up completely by the caller
+ft_uint8_t Esd_BitmapHandle_Attach(Esd_HandleState *state, void *info, Ft_Esd_GpuHandle gpuHandle);
+
+/// Mark a handle as in use for this frame, does nothing for the scratch handle
+void Esd_BitmapHandle_Use(Esd_HandleState *state, ft_uint8_t handle);
+
+/// Invalidate the bitmap handles which use a gpu ram block that was moved, so they are set up again
+void Esd_BitmapHandle_GpuMoved(Esd_HandleState *state, Ft_Esd_GpuHandle gpuHandle);
+
 ft_uint32_t Ft_Esd_BitmapHandle_GetTotalUsed();
 ft_uint32_t Ft_Esd_BitmapHandle_GetTotal();
 
@@ -60,6 +81,9 @@ ESD_FUNCTION(Ft_Esd_Dl_Font_Setup, Type = ft_uint8_t, DisplayName = "Setup Font"
 ESD_PARAMETER(fontInfo, Type = Esd_FontInfo *)
 ft_uint8_t Ft_Esd_Dl_Font_Setup(Esd_FontInfo *fontInfo);
 
+// Set the bitmap size of a handle. Skipped when the handle already has this size, except for the scratch handle
+void Ft_Esd_Dl_Bitmap_Size(ft_uint8_t handle, ft_uint8_t filter, ft_uint8_t wrapx, ft_uint8_t wrapy, ft_uint16_t width, ft_uint16_t height);
+
 void Ft_Esd_Dl_Bitmap_WidthHeight(ft_uint8_t handle, ft_uint16_t width, ft_uint16_t height);
 void Ft_Esd_Dl_Bitmap_WidthHeight_BILINEAR(ft_uint8_t handle, ft_uint16_t width, ft_uint16_t height);
 void Ft_Esd_Dl_Bitmap_WidthHeightReset(ft_uint8_t handle);
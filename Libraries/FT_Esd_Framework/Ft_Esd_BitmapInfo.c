@@ -3,6 +3,8 @@
 #include "Ft_Esd_BitmapInfo.h"
 #include "Ft_Esd_GpuAlloc.h"
 #include "Ft_Esd_CoCmd.h"
+#include "Ft_Esd_Loader.h"
+#include "Ft_Esd_Decode.h"
 
 #ifndef NDEBUG
 #define ESD_BITMAPINFO_DEBUG
@@ -11,10 +13,6 @@
 extern EVE_HalContext *Ft_Esd_Host;
 extern Ft_Esd_GpuAlloc *Ft_Esd_GAlloc;
 
-#ifdef EVE_FLASH_AVAILABLE
-#define ESD_BITMAPINFO_SUPPORT_DIRECT_FLASH(bitmapInfo) (bitmapInfo->Flash && ESD_IS_FORMAT_ASTC(bitmapInfo->Format))
-#endif
-
 static ft_bool_t Ft_Esd_LoadFromFile(ft_uint32_t *imageFormat, ft_bool_t deflate, ft_uint32_t dst, const char *file)
 {
 	return imageFormat
@@ -82,13 +80,66 @@ ft_uint32_t Ft_Esd_LoadBitmap(Ft_Esd_BitmapInfo *bitmapInfo)
 			return GA_INVALID;
 		}
 
+		// The contents may still be in RAM_G from before the allocator was reset
+		addr = Ft_Esd_GpuAlloc_Adopt(Ft_Esd_GAlloc, &bitmapInfo->GpuHandle,
+		    (bitmapInfo->Persistent ? 0 : GA_GC_FLAG) | ((bitmapInfo->Flash && bitmapInfo->PreferRam) ? GA_LOW_FLAG : 0));
+		if (addr != GA_INVALID)
+			return ESD_DL_RAM_G_ADDRESS(addr);
+
+#if ESD_LOADER_ASYNC
+		if ((bitmapInfo->Async || bitmapInfo->Placeholder || bitmapInfo->PlaceholderColor)
+		    && !bitmapInfo->Flash && !bitmapInfo->AdditionalFile
+		    && !(bitmapInfo->CoLoad || bitmapInfo->Format == JPEG || bitmapInfo->Format == PNG)
+		    && Esd_Loader_Request(&bitmapInfo->GpuHandle, bitmapInfo->File, bitmapInfo->Compressed, bitmapInfo->Size,
+		        bitmapInfo->Persistent ? 0 : GA_GC_FLAG, bitmapInfo))
+		{
+			// Not loaded, queued to be loaded in the background
+			return GA_INVALID;
+		}
+#endif
+
+#if ESD_DECODE_HOST
+		if ((bitmapInfo->CoLoad || bitmapInfo->Format == JPEG || bitmapInfo->Format == PNG)
+		    && !bitmapInfo->Flash && !bitmapInfo->AdditionalFile)
+		{
+			// Choose where to decode the first time the image is loaded, the format is known after that
+			if (bitmapInfo->Format == JPEG || bitmapInfo->Format == PNG)
+				bitmapInfo->HostDecode = Esd_Decode_Prefer(bitmapInfo->Format == PNG ? ESD_DECODE_PNG : ESD_DECODE_JPEG);
+			bitmapInfo->CoLoad = FT_TRUE;
+			if (bitmapInfo->HostDecode && Esd_Loader_RequestImage(&bitmapInfo->GpuHandle, bitmapInfo->File, &bitmapInfo->Format,
+			                                  bitmapInfo->Persistent ? 0 : GA_GC_FLAG, bitmapInfo))
+			{
+				// Not loaded, queued to be decoded in the background
+				return GA_INVALID;
+			}
+		}
+#endif
+
+#if ESD_LOADER_MEDIAFIFO
+		if ((bitmapInfo->CoLoad || bitmapInfo->Format == JPEG || bitmapInfo->Format == PNG)
+		    && !bitmapInfo->Flash && !bitmapInfo->AdditionalFile && (ft_uint32_t)bitmapInfo->Size >= ESD_LOADER_MEDIAFIFO_MIN
+		    && Esd_Loader_StreamImage(&bitmapInfo->GpuHandle, bitmapInfo->File, &bitmapInfo->Format, bitmapInfo->Size,
+		        bitmapInfo->Persistent ? 0 : GA_GC_FLAG, bitmapInfo))
+		{
+			// Not loaded, streamed to the coprocessor between frames
+			bitmapInfo->CoLoad = FT_TRUE;
+			return GA_INVALID;
+		}
+#endif
+
 		// Not loaded, load this bitmap
 		bitmapInfo->GpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, bitmapInfo->Size,
 		    (bitmapInfo->Persistent ? 0 : GA_GC_FLAG) | ((bitmapInfo->Flash && bitmapInfo->PreferRam) ? GA_LOW_FLAG : 0));
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, bitmapInfo->GpuHandle, bitmapInfo, bitmapInfo->Flash ? "<flash bitmap>" : bitmapInfo->File);
 		addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, bitmapInfo->GpuHandle);
 		if (addr != GA_INVALID)
 		{
 			ft_bool_t coLoad = bitmapInfo->CoLoad || bitmapInfo->Format == JPEG || bitmapInfo->Format == PNG;
+#if ESD_DECODE_HOST
+			ft_uint8_t kind = bitmapInfo->Format == PNG ? ESD_DECODE_PNG : ESD_DECODE_JPEG;
+			ft_bool_t measure = !bitmapInfo->Flash && (bitmapInfo->Format == JPEG || bitmapInfo->Format == PNG);
+			ft_uint32_t start = EVE_millis();
+#endif
 			bitmapInfo->CoLoad = coLoad;
 
 #ifdef ESD_BITMAPINFO_DEBUG
@@ -109,6 +160,13 @@ ft_uint32_t Ft_Esd_LoadBitmap(Ft_Esd_BitmapInfo *bitmapInfo)
 				Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, bitmapInfo->GpuHandle);
 				addr = GA_INVALID;
 			}
+#if ESD_DECODE_HOST
+			else if (measure)
+			{
+				// Compare with the cost of decoding on the host
+				Esd_Decode_Measure(kind, FT_FALSE, bitmapInfo->Width * bitmapInfo->Height, EVE_millis() - start);
+			}
+#endif
 
 			// Special load for DXT1, additional file loaded halfway the address space
 			if (bitmapInfo->Flash ? (bitmapInfo->AdditionalFlashAddress != FA_INVALID) : (!!bitmapInfo->AdditionalFile))
@@ -127,6 +185,10 @@ ft_uint32_t Ft_Esd_LoadBitmap(Ft_Esd_BitmapInfo *bitmapInfo)
 					addr = GA_INVALID;
 				}
 			}
+
+			// Remember the contents, to adopt them again after a reset
+			if (addr != GA_INVALID)
+				Ft_Esd_GpuAlloc_Seal(Ft_Esd_GAlloc, &bitmapInfo->GpuHandle);
 		}
 		else
 		{
@@ -155,6 +217,23 @@ ft_uint32_t Ft_Esd_LoadBitmap(Ft_Esd_BitmapInfo *bitmapInfo)
 	return addr;
 }
 
+ft_bool_t Ft_Esd_LoadBitmapAt(Ft_Esd_BitmapInfo *bitmapInfo, ft_uint32_t addr)
+{
+#ifndef EVE_FLASH_AVAILABLE
+	if (bitmapInfo->Flash)
+		return FT_FALSE;
+#endif
+
+	if (bitmapInfo->Flash ? (bitmapInfo->FlashAddress == FA_INVALID) : !bitmapInfo->File)
+		return FT_FALSE;
+
+	return
+#ifdef EVE_FLASH_AVAILABLE
+	    bitmapInfo->Flash ? Ft_Esd_LoadFromFlash(NULL, bitmapInfo->Compressed, addr, bitmapInfo->FlashAddress, bitmapInfo->Size) :
+#endif
+	                      Ft_Esd_LoadFromFile(NULL, bitmapInfo->Compressed, addr, bitmapInfo->File);
+}
+
 ft_uint32_t Ft_Esd_LoadPalette(Ft_Esd_BitmapInfo *bitmapInfo)
 {
 	ft_uint32_t addr;
@@ -209,8 +288,14 @@ ft_uint32_t Ft_Esd_LoadPalette(Ft_Esd_BitmapInfo *bitmapInfo)
 			return GA_INVALID;
 		}
 
+		// The contents may still be in RAM_G from before the allocator was reset
+		addr = Ft_Esd_GpuAlloc_Adopt(Ft_Esd_GAlloc, &bitmapInfo->PaletteGpuHandle, bitmapInfo->Persistent ? 0 : GA_GC_FLAG);
+		if (addr != GA_INVALID)
+			return ESD_DL_RAM_G_ADDRESS(addr);
+
 		// Not loaded, load this bitmap palette
 		bitmapInfo->PaletteGpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, size, bitmapInfo->Persistent ? 0 : GA_GC_FLAG);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, bitmapInfo->PaletteGpuHandle, bitmapInfo, bitmapInfo->Flash ? "<flash palette>" : bitmapInfo->PaletteFile);
 		addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, bitmapInfo->PaletteGpuHandle);
 		if (addr != GA_INVALID)
 		{
@@ -231,6 +316,10 @@ ft_uint32_t Ft_Esd_LoadPalette(Ft_Esd_BitmapInfo *bitmapInfo)
 				Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, bitmapInfo->PaletteGpuHandle);
 				addr = GA_INVALID;
 			}
+			else
+			{
+				Ft_Esd_GpuAlloc_Seal(Ft_Esd_GAlloc, &bitmapInfo->PaletteGpuHandle);
+			}
 		}
 		else
 		{
@@ -75,10 +75,29 @@ typedef struct Ft_Esd_BitmapInfo
 	// Load image using coprocessor (for JPEG and PNG)
 	ft_bool_t CoLoad : 1;
 
+	// Load file in the background, the bitmap is not drawn until it is loaded (see Ft_Esd_Loader.h)
+	ft_bool_t Async : 1;
+
+	// (Runtime) Image is decoded on the host rather than by the coprocessor (see Ft_Esd_Decode.h)
+	ft_bool_t HostDecode : 1;
+
+	// Smaller version of the bitmap, stretched over the bitmap area while the bitmap is not loaded yet.
+	// Should be small enough to load immediately, and may have a placeholder of its own
+	struct Ft_Esd_BitmapInfo *Placeholder;
+
+	// Color filling the bitmap area while neither the bitmap nor a placeholder bitmap is loaded, transparent for none.
+	// A bitmap with a placeholder is loaded in the background, as if Async was set
+	ft_argb32_t PlaceholderColor;
+
 } Ft_Esd_BitmapInfo;
 
 ESD_TYPE(Ft_Esd_BitmapInfo *, Native = Pointer, Edit = Library)
 
+#ifdef EVE_FLASH_AVAILABLE
+// The bitmap is used directly from flash, without loading it into RAM_G
+#define ESD_BITMAPINFO_SUPPORT_DIRECT_FLASH(bitmapInfo) (bitmapInfo->Flash && ESD_IS_FORMAT_ASTC(bitmapInfo->Format))
+#endif
+
 ESD_TYPE(Ft_Esd_BitmapCell, Native = Struct, Edit = Library) // TODO: Struct support, expose values
 typedef struct
 {
@@ -93,6 +112,10 @@ ESD_FUNCTION(Ft_Esd_LoadBitmap, Type = ft_uint32_t, Include = "Ft_Esd_BitmapInfo
 ESD_PARAMETER(bitmapInfo, Type = Ft_Esd_BitmapInfo *)
 ft_uint32_t Ft_Esd_LoadBitmap(Ft_Esd_BitmapInfo *bitmapInfo);
 
+/// Load the bitmap data into the specified RAM_G address, without allocating it. Used to pack bitmaps together.
+/// Does not support bitmaps which are decoded by the coprocessor, or which have additional data
+ft_bool_t Ft_Esd_LoadBitmapAt(Ft_Esd_BitmapInfo *bitmapInfo, ft_uint32_t addr);
+
 /// A function to load palette data of bitmap into RAM_G
 ESD_FUNCTION(Ft_Esd_LoadPalette, Type = ft_uint32_t, Include = "Ft_Esd_BitmapInfo.h", DisplayName = "Load Palette to RAM_G", Category = EsdUtilities)
 ESD_PARAMETER(bitmapInfo, Type = Ft_Esd_BitmapInfo *)
@@ -39,11 +39,8 @@ ft_void_t Ft_Gpu_CoCmd_DlStart(EVE_HalContext *phost)
 
 ft_void_t Ft_Gpu_CoCmd_Append(EVE_HalContext *phost, ft_uint32_t ptr, ft_uint32_t num)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_APPEND);
-	Gpu_Copro_SendCmd(phost, ptr);
-	Gpu_Copro_SendCmd(phost, num);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_APPEND, ptr, num);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_Swap(EVE_HalContext *phost)
@@ -53,35 +50,23 @@ ft_void_t Ft_Gpu_CoCmd_Swap(EVE_HalContext *phost)
 
 ft_void_t Ft_Gpu_CoCmd_Sketch(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_uint16_t w, ft_uint16_t h, ft_uint32_t ptr, ft_uint16_t format)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 5);
-	Gpu_Copro_SendCmd(phost, CMD_SKETCH);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, ptr);
-	Gpu_Copro_SendCmd(phost, format);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 5));
+	EVE_CmdWords5 cmd = EVE_CoCmd_encSketch(x, y, w, h, ptr, format);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 #if (EVE_MODEL == EVE_FT801)
 ft_void_t Ft_Gpu_CoCmd_CSketch(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_uint16_t w, ft_uint16_t h, ft_uint32_t ptr, ft_uint16_t format, ft_uint16_t freq)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 5);
-	Gpu_Copro_SendCmd(phost, CMD_CSKETCH);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, ptr);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)freq << 16) | (format & 0xffff)));
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 5));
+	EVE_CmdWords5 cmd = EVE_CoCmd_encCSketch(x, y, w, h, ptr, format, freq);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
 #if (EVE_MODEL >= EVE_FT810)
 ft_void_t Ft_Gpu_CoCmd_PlayVideo(EVE_HalContext *phost, ft_uint32_t options)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_PLAYVIDEO);
-	Gpu_Copro_SendCmd(phost, options);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_PLAYVIDEO, options);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
@@ -126,48 +111,33 @@ ft_bool_t Ft_Gpu_CoCmd_AnimStart(EVE_HalContext *phost, int32_t ch, uint32_t aop
 		return FT_FALSE;
 	}
 
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 4);
-	Gpu_Copro_SendCmd(phost, CMD_ANIMSTART);
-	Gpu_Copro_SendCmd(phost, ch);
-	Gpu_Copro_SendCmd(phost, aoptr);
-	Gpu_Copro_SendCmd(phost, loop);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 4));
+	EVE_CmdWords4 cmd = EVE_CoCmd_enc3(CMD_ANIMSTART, ch, aoptr, loop);
+	EVE_Cmd_wrEncoded(phost, cmd);
 	return EVE_Cmd_waitFlush(phost);
 }
 
 void Ft_Gpu_CoCmd_AnimStop(EVE_HalContext *phost, int32_t ch)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_ANIMSTOP);
-	Gpu_Copro_SendCmd(phost, ch);
-	Gpu_CoCmd_EndFunc(phost, CMD_SIZE * 2);
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_ANIMSTOP, ch);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 void Ft_Gpu_CoCmd_AnimXY(EVE_HalContext *phost, int32_t ch, int16_t x, int16_t y)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_ANIMXY);
-	Gpu_Copro_SendCmd(phost, ch);
-	Gpu_Copro_SendCmd(phost, ((uint32_t)y << 16) | (x & 0xFFFF));
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_encAnimXY(ch, x, y);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 void Ft_Gpu_CoCmd_AnimDraw(EVE_HalContext *phost, int32_t ch)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_ANIMDRAW);
-	Gpu_Copro_SendCmd(phost, ch);
-	Gpu_CoCmd_EndFunc(phost, CMD_SIZE * 2);
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_ANIMDRAW, ch);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 void Ft_Gpu_CoCmd_AnimFrame(EVE_HalContext *phost, int16_t x, int16_t y, uint32_t aoptr, uint32_t frame)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 4);
-	Gpu_Copro_SendCmd(phost, CMD_ANIMFRAME);
-	Gpu_Copro_SendCmd(phost, ((uint32_t)y << 16) | (x & 0xFFFF));
-	Gpu_Copro_SendCmd(phost, aoptr);
-	Gpu_Copro_SendCmd(phost, frame);
-	Gpu_CoCmd_EndFunc(phost, CMD_SIZE * 4);
+	EVE_CmdWords4 cmd = EVE_CoCmd_encAnimFrame(x, y, aoptr, frame);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
@@ -198,11 +168,8 @@ ft_void_t Ft_Gpu_CoCmd_VideoStart(EVE_HalContext *phost)
 
 ft_void_t Ft_Gpu_CoCmd_VideoFrame(EVE_HalContext *phost, ft_uint32_t dst, ft_uint32_t ptr)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_VIDEOFRAME);
-	Gpu_Copro_SendCmd(phost, dst);
-	Gpu_Copro_SendCmd(phost, ptr);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_VIDEOFRAME, dst, ptr);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
@@ -249,30 +216,14 @@ bool ESD_Cmd_getPtr(uint32_t *result)
 
 ft_void_t Ft_Gpu_CoCmd_TouchTransform(EVE_HalContext *phost, ft_int32_t x0, ft_int32_t y0, ft_int32_t x1, ft_int32_t y1, ft_int32_t x2, ft_int32_t y2, ft_int32_t tx0, ft_int32_t ty0, ft_int32_t tx1, ft_int32_t ty1, ft_int32_t tx2, ft_int32_t ty2, ft_uint16_t result)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 6 * 2 + CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_TOUCH_TRANSFORM);
-	Gpu_Copro_SendCmd(phost, x0);
-	Gpu_Copro_SendCmd(phost, y0);
-	Gpu_Copro_SendCmd(phost, x1);
-	Gpu_Copro_SendCmd(phost, y1);
-	Gpu_Copro_SendCmd(phost, x2);
-	Gpu_Copro_SendCmd(phost, y2);
-	Gpu_Copro_SendCmd(phost, tx0);
-	Gpu_Copro_SendCmd(phost, ty0);
-	Gpu_Copro_SendCmd(phost, tx1);
-	Gpu_Copro_SendCmd(phost, ty1);
-	Gpu_Copro_SendCmd(phost, tx2);
-	Gpu_Copro_SendCmd(phost, ty2);
-	Gpu_Copro_SendCmd(phost, result);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 6 * 2 + CMD_SIZE * 2));
+	EVE_CmdWords14 cmd = EVE_CoCmd_encTransform(CMD_TOUCH_TRANSFORM, x0, y0, x1, y1, x2, y2, tx0, ty0, tx1, ty1, tx2, ty2, result);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_Interrupt(EVE_HalContext *phost, ft_uint32_t ms)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_INTERRUPT);
-	Gpu_Copro_SendCmd(phost, ms);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_INTERRUPT, ms);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 bool ESD_Cmd_getMatrix(int32_t *m)
@@ -308,30 +259,21 @@ ft_void_t Ft_Gpu_CoCmd_Sync(EVE_HalContext *phost)
 
 ft_void_t Ft_Gpu_CoCmd_Track(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t h, ft_int16_t tag)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 4);
-	Gpu_Copro_SendCmd(phost, CMD_TRACK);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, tag);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 4));
+	EVE_CmdWords4 cmd = EVE_CoCmd_encTrack(x, y, w, h, tag);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 #if (EVE_MODEL >= EVE_FT810)
 ft_void_t Ft_Gpu_CoCmd_Int_RAMShared(EVE_HalContext *phost, ft_uint32_t ptr)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_INT_RAMSHARED);
-	Gpu_Copro_SendCmd(phost, ptr);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_INT_RAMSHARED, ptr);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_Int_SWLoadImage(EVE_HalContext *phost, ft_uint32_t ptr, ft_uint32_t options)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_INT_SWLOADIMAGE);
-	Gpu_Copro_SendCmd(phost, ptr);
-	Gpu_Copro_SendCmd(phost, options);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_INT_SWLOADIMAGE, ptr, options);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
@@ -34,40 +34,26 @@
 
 ft_void_t Ft_Gpu_CoCmd_MemCpy(EVE_HalContext *phost, ft_uint32_t dest, ft_uint32_t src, ft_uint32_t num)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_MEMCPY);
-	EVE_Cmd_wr32(phost, dest);
-	EVE_Cmd_wr32(phost, src);
-	EVE_Cmd_wr32(phost, num);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords4 cmd = EVE_CoCmd_enc3(CMD_MEMCPY, dest, src, num);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_MemSet(EVE_HalContext *phost, ft_uint32_t ptr, ft_uint32_t value, ft_uint32_t num)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_MEMSET);
-	EVE_Cmd_wr32(phost, ptr);
-	EVE_Cmd_wr32(phost, value);
-	EVE_Cmd_wr32(phost, num);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords4 cmd = EVE_CoCmd_enc3(CMD_MEMSET, ptr, value, num);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_MemZero(EVE_HalContext *phost, ft_uint32_t ptr, ft_uint32_t num)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_MEMZERO);
-	EVE_Cmd_wr32(phost, ptr);
-	EVE_Cmd_wr32(phost, num);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_MEMZERO, ptr, num);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_MemWrite(EVE_HalContext *phost, ft_uint32_t ptr, ft_uint32_t num)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_MEMWRITE);
-	EVE_Cmd_wr32(phost, ptr);
-	EVE_Cmd_wr32(phost, num);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_MEMWRITE, ptr, num);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 bool ESD_Cmd_memCrc(ft_uint32_t ptr, ft_uint32_t num, ft_uint32_t *result)
@@ -92,52 +78,35 @@ bool ESD_Cmd_memCrc(ft_uint32_t ptr, ft_uint32_t num, ft_uint32_t *result)
 
 ft_void_t Ft_Gpu_CoCmd_LoadImage(EVE_HalContext *phost, ft_uint32_t ptr, ft_uint32_t options)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_LOADIMAGE);
-	EVE_Cmd_wr32(phost, ptr);
-	EVE_Cmd_wr32(phost, options);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_LOADIMAGE, ptr, options);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_Inflate(EVE_HalContext *phost, ft_uint32_t ptr)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_INFLATE);
-	EVE_Cmd_wr32(phost, ptr);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_INFLATE, ptr);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 #if (EVE_MODEL >= EVE_FT810)
 ft_void_t Ft_Gpu_CoCmd_MediaFifo(EVE_HalContext *phost, ft_uint32_t ptr, ft_uint32_t size)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_MEDIAFIFO);
-	EVE_Cmd_wr32(phost, ptr);
-	EVE_Cmd_wr32(phost, size);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_MEDIAFIFO, ptr, size);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
 ft_void_t Ft_Gpu_CoCmd_Snapshot(EVE_HalContext *phost, ft_uint32_t ptr)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_SNAPSHOT);
-	EVE_Cmd_wr32(phost, ptr);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_SNAPSHOT, ptr);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 #if (EVE_MODEL >= EVE_FT810)
 ft_void_t Ft_Gpu_CoCmd_Snapshot2(EVE_HalContext *phost, ft_uint32_t fmt, ft_uint32_t ptr, ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t h)
 {
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_SNAPSHOT2);
-	EVE_Cmd_wr32(phost, fmt);
-	EVE_Cmd_wr32(phost, ptr);
-	EVE_Cmd_wr16(phost, x);
-	EVE_Cmd_wr16(phost, y);
-	EVE_Cmd_wr16(phost, w);
-	EVE_Cmd_wr16(phost, h);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords5 cmd = EVE_CoCmd_encSnapshot2(fmt, ptr, x, y, w, h);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
@@ -192,12 +161,8 @@ ft_bool_t Ft_Gpu_CoCmd_FlashRead(EVE_HalContext *phost, ft_uint32_t dst, ft_uint
 {
 	if (!EVE_Cmd_waitFlush(phost))
 		return false; // Coprocessor must be ready
-	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_FLASHREAD);
-	EVE_Cmd_wr32(phost, dst);
-	EVE_Cmd_wr32(phost, src);
-	EVE_Cmd_wr32(phost, size);
-	EVE_Cmd_endFunc(phost);
+	EVE_CmdWords4 cmd = EVE_CoCmd_enc3(CMD_FLASHREAD, dst, src, size);
+	EVE_Cmd_wrEncoded(phost, cmd);
 	return EVE_Cmd_waitFlush(phost);
 }
 
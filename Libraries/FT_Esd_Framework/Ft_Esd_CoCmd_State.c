@@ -32,6 +32,8 @@
 #include "Ft_Esd_CoCmd.h"
 #include "Gpu_Hal.h"
 
+#include "FT_Esd_Dl.h"
+
 ft_void_t Ft_Gpu_CoCmd_ColdStart(EVE_HalContext *phost)
 {
 	Eve_CoCmd_SendCmd(phost, CMD_COLDSTART);
@@ -44,143 +46,100 @@ ft_void_t Ft_Gpu_CoCmd_LoadIdentity(EVE_HalContext *phost)
 
 ft_void_t Ft_Gpu_CoCmd_Translate(EVE_HalContext *phost, ft_int32_t tx, ft_int32_t ty)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_TRANSLATE);
-	Gpu_Copro_SendCmd(phost, tx);
-	Gpu_Copro_SendCmd(phost, ty);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_TRANSLATE, tx, ty);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_Rotate(EVE_HalContext *phost, ft_int32_t a)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_ROTATE);
-	Gpu_Copro_SendCmd(phost, a);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_ROTATE, a);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_Scale(EVE_HalContext *phost, ft_int32_t sx, ft_int32_t sy)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_SCALE);
-	Gpu_Copro_SendCmd(phost, sx);
-	Gpu_Copro_SendCmd(phost, sy);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_SCALE, sx, sy);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_SetMatrix(EVE_HalContext *phost)
 {
 	Eve_CoCmd_SendCmd(phost, CMD_SETMATRIX);
+
+	// Writes BITMAP_TRANSFORM_A to BITMAP_TRANSFORM_F
+	Esd_InvalidateBitmapTransform();
 }
 
 #if (EVE_MODEL >= EVE_FT810)
 ft_void_t Ft_Gpu_CoCmd_SetRotate(EVE_HalContext *phost, ft_uint32_t r)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_SETROTATE);
-	Gpu_Copro_SendCmd(phost, r);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_SETROTATE, r);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
 ft_void_t Ft_Gpu_CoCmd_BitmapTransform(EVE_HalContext *phost, ft_int32_t x0, ft_int32_t y0, ft_int32_t x1, ft_int32_t y1, ft_int32_t x2, ft_int32_t y2, ft_int32_t tx0, ft_int32_t ty0, ft_int32_t tx1, ft_int32_t ty1, ft_int32_t tx2, ft_int32_t ty2, ft_uint16_t result)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 6 * 2 + CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_BITMAP_TRANSFORM);
-	Gpu_Copro_SendCmd(phost, x0);
-	Gpu_Copro_SendCmd(phost, y0);
-	Gpu_Copro_SendCmd(phost, x1);
-	Gpu_Copro_SendCmd(phost, y1);
-	Gpu_Copro_SendCmd(phost, x2);
-	Gpu_Copro_SendCmd(phost, y2);
-	Gpu_Copro_SendCmd(phost, tx0);
-	Gpu_Copro_SendCmd(phost, ty0);
-	Gpu_Copro_SendCmd(phost, tx1);
-	Gpu_Copro_SendCmd(phost, ty1);
-	Gpu_Copro_SendCmd(phost, tx2);
-	Gpu_Copro_SendCmd(phost, ty2);
-	Gpu_Copro_SendCmd(phost, result);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 6 * 2 + CMD_SIZE * 2));
+	EVE_CmdWords14 cmd = EVE_CoCmd_encTransform(CMD_BITMAP_TRANSFORM, x0, y0, x1, y1, x2, y2, tx0, ty0, tx1, ty1, tx2, ty2, result);
+	EVE_Cmd_wrEncoded(phost, cmd);
+
+	// Writes BITMAP_TRANSFORM_A to BITMAP_TRANSFORM_F
+	Esd_InvalidateBitmapTransform();
 }
 
 ft_void_t Ft_Gpu_CoCmd_FgColor(EVE_HalContext *phost, ft_uint32_t c)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_FGCOLOR);
-	Gpu_Copro_SendCmd(phost, c);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_FGCOLOR, c);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_BgColor(EVE_HalContext *phost, ft_uint32_t c)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_BGCOLOR);
-	Gpu_Copro_SendCmd(phost, c);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_BGCOLOR, c);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_GradColor(EVE_HalContext *phost, ft_uint32_t c)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_GRADCOLOR);
-	Gpu_Copro_SendCmd(phost, c);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_GRADCOLOR, c);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_SetFont(EVE_HalContext *phost, ft_uint32_t font, ft_uint32_t ptr)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_SETFONT);
-	Gpu_Copro_SendCmd(phost, font);
-	Gpu_Copro_SendCmd(phost, ptr);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_SETFONT, font, ptr);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 #if (EVE_MODEL >= EVE_FT810)
 ft_void_t Ft_Gpu_CoCmd_SetFont2(EVE_HalContext *phost, ft_uint32_t font, ft_uint32_t ptr, ft_uint32_t firstchar)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 4);
-	Gpu_Copro_SendCmd(phost, CMD_SETFONT2);
-	Gpu_Copro_SendCmd(phost, font);
-	Gpu_Copro_SendCmd(phost, ptr);
-	Gpu_Copro_SendCmd(phost, firstchar);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 4));
+	EVE_CmdWords4 cmd = EVE_CoCmd_enc3(CMD_SETFONT2, font, ptr, firstchar);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_SetBase(EVE_HalContext *phost, ft_uint32_t base)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_SETBASE);
-	Gpu_Copro_SendCmd(phost, base);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_SETBASE, base);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_SetBitmap(EVE_HalContext *phost, ft_uint32_t source, ft_uint16_t fmt, ft_uint16_t w, ft_uint16_t h)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 4);
-	Gpu_Copro_SendCmd(phost, CMD_SETBITMAP);
-	Gpu_Copro_SendCmd(phost, source);
-	EVE_Cmd_wr16(phost, fmt);
-	EVE_Cmd_wr16(phost, w);
-	Gpu_Copro_SendCmd(phost, h);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 4));
+	EVE_CmdWords4 cmd = EVE_CoCmd_encSetBitmap(source, fmt, w, h);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_SetScratch(EVE_HalContext *phost, ft_uint32_t handle)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 2);
-	Gpu_Copro_SendCmd(phost, CMD_SETSCRATCH);
-	Gpu_Copro_SendCmd(phost, handle);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 2));
+	EVE_CmdWords2 cmd = EVE_CoCmd_enc1(CMD_SETSCRATCH, handle);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 
 ft_void_t Ft_Gpu_CoCmd_RomFont(EVE_HalContext *phost, ft_uint32_t font, ft_uint32_t romslot)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_ROMFONT);
-	Gpu_Copro_SendCmd(phost, font);
-	Gpu_Copro_SendCmd(phost, romslot);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_enc2(CMD_ROMFONT, font, romslot);
+	EVE_Cmd_wrEncoded(phost, cmd);
 }
 #endif
 
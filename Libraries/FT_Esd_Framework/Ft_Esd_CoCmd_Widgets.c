@@ -41,13 +41,8 @@ extern ft_uint8_t Ft_Esd_Primitive;
 
 ft_void_t Ft_Gpu_CoCmd_Gradient(EVE_HalContext *phost, ft_int16_t x0, ft_int16_t y0, ft_uint32_t rgb0, ft_int16_t x1, ft_int16_t y1, ft_uint32_t rgb1)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 5);
-	Gpu_Copro_SendCmd(phost, CMD_GRADIENT);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y0 << 16) | (x0 & 0xffff)));
-	Gpu_Copro_SendCmd(phost, rgb0);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y1 << 16) | (x1 & 0xffff)));
-	Gpu_Copro_SendCmd(phost, rgb1);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 5));
+	EVE_CmdWords5 cmd = EVE_CoCmd_encGradient(x0, y0, rgb0, x1, y1, rgb1);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
@@ -56,11 +51,8 @@ ft_void_t Ft_Gpu_CoCmd_Gradient(EVE_HalContext *phost, ft_int16_t x0, ft_int16_t
 
 ft_void_t Ft_Gpu_CoCmd_Spinner(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_uint16_t style, ft_uint16_t scale)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 3);
-	Gpu_Copro_SendCmd(phost, CMD_SPINNER);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)scale << 16) | (style & 0xffff)));
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 3));
+	EVE_CmdWords3 cmd = EVE_CoCmd_encSpinner(x, y, style, scale);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
@@ -103,12 +95,9 @@ void Gpu_CoCmd_Text(Gpu_Hal_Context_t *phost, int16_t x, int16_t y, int16_t font
 	    //printf("num = %d %d\n",num, (len + 1 + 3) & ~3);
 #endif
 
+	EVE_CmdWords3 cmd = EVE_CoCmd_encText(x, y, font, options);
 	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_TEXT);
-	EVE_Cmd_wr16(phost, x);
-	EVE_Cmd_wr16(phost, y);
-	EVE_Cmd_wr16(phost, font);
-	EVE_Cmd_wr16(phost, options);
+	EVE_Cmd_wrEncoded(phost, cmd);
 	EVE_Cmd_wrString(phost, s, EVE_CMD_STRING_MAX);
 #if (EVE_MODEL >= EVE_BT815)
 	for (i = 0; i < num; i++)
@@ -131,12 +120,9 @@ ft_void_t Ft_Gpu_CoCmd_Text(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, f
 		return;
 	}
 
+	EVE_CmdWords3 cmd = EVE_CoCmd_encText(x, y, font, options);
 	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_TEXT);
-	EVE_Cmd_wr16(phost, x);
-	EVE_Cmd_wr16(phost, y);
-	EVE_Cmd_wr16(phost, font);
-	EVE_Cmd_wr16(phost, options);
+	EVE_Cmd_wrEncoded(phost, cmd);
 	uint16_t transfered = EVE_Cmd_wrString(phost, s, EVE_CMD_STRING_MAX);
 	EVE_Cmd_endFunc(phost);
 	// eve_printf_debug(" -- strlen: %i, transfered: %i\n", (int)strlen(s), (int)transfered);
@@ -157,16 +143,9 @@ ft_void_t Ft_Gpu_CoCmd_Text_S(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y,
 		return;
 	}
 
+	EVE_CmdWords3 cmd = EVE_CoCmd_encText(x, y, font, options);
 	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_TEXT);
-	// eve_printf_debug("wp: %i\n", EVE_Cmd_wp(phost));
-	EVE_Cmd_wr16(phost, x);
-	// eve_printf_debug("wp: %i\n", EVE_Cmd_wp(phost));
-	EVE_Cmd_wr16(phost, y);
-	// eve_printf_debug("wp: %i\n", EVE_Cmd_wp(phost));
-	EVE_Cmd_wr16(phost, font);
-	// eve_printf_debug("wp: %i\n", EVE_Cmd_wp(phost));
-	EVE_Cmd_wr16(phost, options);
+	EVE_Cmd_wrEncoded(phost, cmd);
 	// eve_printf_debug("wp: %i\n", EVE_Cmd_wp(phost));
 	uint16_t transfered = EVE_Cmd_wrString(phost, s, length);
 	EVE_Cmd_endFunc(phost);
@@ -200,12 +179,8 @@ ft_void_t Ft_Gpu_CoCmd_Number(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y,
 		return;
 	}
 
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 4);
-	Gpu_Copro_SendCmd(phost, CMD_NUMBER);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)options << 16) | (font & 0xffff)));
-	Gpu_Copro_SendCmd(phost, n);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 4));
+	EVE_CmdWords4 cmd = EVE_CoCmd_encNumber(x, y, font, options, n);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
@@ -223,14 +198,9 @@ void Gpu_CoCmd_Toggle(Gpu_Hal_Context_t *phost, int16_t x, int16_t y, int16_t w,
 	num = (options & OPT_FORMAT) ? (countArgs(s)) : (0); //Only check % characters if option OPT_FORMAT is set
 #endif
 
+	EVE_CmdWords4 cmd = EVE_CoCmd_encToggle(x, y, w, font, options, state);
 	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_TOGGLE);
-	EVE_Cmd_wr16(phost, x);
-	EVE_Cmd_wr16(phost, y);
-	EVE_Cmd_wr16(phost, w);
-	EVE_Cmd_wr16(phost, font);
-	EVE_Cmd_wr16(phost, options);
-	EVE_Cmd_wr16(phost, state);
+	EVE_Cmd_wrEncoded(phost, cmd);
 	EVE_Cmd_wrString(phost, s, EVE_CMD_STRING_MAX);
 #if (EVE_MODEL >= EVE_BT815)
 	for (i = 0; i < num; i++)
@@ -246,14 +216,9 @@ void Gpu_CoCmd_Toggle(Gpu_Hal_Context_t *phost, int16_t x, int16_t y, int16_t w,
 
 ft_void_t Ft_Gpu_CoCmd_Toggle(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t font, ft_uint16_t options, ft_uint16_t state, const ft_char8_t *s)
 {
+	EVE_CmdWords4 cmd = EVE_CoCmd_encToggle(x, y, w, font, options, state);
 	EVE_Cmd_startFunc(phost);
-	EVE_Cmd_wr32(phost, CMD_TOGGLE);
-	EVE_Cmd_wr16(phost, x);
-	EVE_Cmd_wr16(phost, y);
-	EVE_Cmd_wr16(phost, w);
-	EVE_Cmd_wr16(phost, font);
-	EVE_Cmd_wr16(phost, options);
-	EVE_Cmd_wr16(phost, state);
+	EVE_Cmd_wrEncoded(phost, cmd);
 	EVE_Cmd_wrString(phost, s, EVE_CMD_STRING_MAX);
 	EVE_Cmd_endFunc(phost);
 
@@ -264,13 +229,8 @@ ft_void_t Ft_Gpu_CoCmd_Toggle(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y,
 
 ft_void_t Ft_Gpu_CoCmd_Slider(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t h, ft_uint16_t options, ft_uint16_t val, ft_uint16_t range)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 5);
-	Gpu_Copro_SendCmd(phost, CMD_SLIDER);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)val << 16) | (options & 0xffff)));
-	Gpu_Copro_SendCmd(phost, range);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 5));
+	EVE_CmdWords5 cmd = EVE_CoCmd_encSlider(x, y, w, h, options, val, range);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
@@ -289,11 +249,9 @@ void Gpu_CoCmd_Button(Gpu_Hal_Context_t *phost, int16_t x, int16_t y, int16_t w,
 	num = (options & OPT_FORMAT) ? (countArgs(s)) : (0); //Only check % characters if option OPT_FORMAT is set
 #endif
 
+	EVE_CmdWords4 cmd = EVE_CoCmd_encButton(x, y, w, h, font, options);
 	EVE_Cmd_startFunc(phost);
-	Gpu_Copro_SendCmd(phost, CMD_BUTTON);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)options << 16) | (font & 0xffff)));
+	EVE_Cmd_wrEncoded(phost, cmd);
 	Gpu_CoCmd_SendStr(phost, s);
 #if (EVE_MODEL >= EVE_BT815)
 	for (i = 0; i < num; i++)
@@ -309,11 +267,9 @@ void Gpu_CoCmd_Button(Gpu_Hal_Context_t *phost, int16_t x, int16_t y, int16_t w,
 
 ft_void_t Ft_Gpu_CoCmd_Button(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t h, ft_int16_t font, ft_uint16_t options, const ft_char8_t *s)
 {
+	EVE_CmdWords4 cmd = EVE_CoCmd_encButton(x, y, w, h, font, options);
 	EVE_Cmd_startFunc(phost);
-	Gpu_Copro_SendCmd(phost, CMD_BUTTON);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)options << 16) | (font & 0xffff)));
+	EVE_Cmd_wrEncoded(phost, cmd);
 	Gpu_CoCmd_SendStr(phost, s);
 	EVE_Cmd_endFunc(phost);
 
@@ -324,11 +280,9 @@ ft_void_t Ft_Gpu_CoCmd_Button(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y,
 
 ft_void_t Ft_Gpu_CoCmd_Keys(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t h, ft_int16_t font, ft_uint16_t options, const ft_char8_t *s)
 {
+	EVE_CmdWords4 cmd = EVE_CoCmd_encKeys(x, y, w, h, font, options);
 	EVE_Cmd_startFunc(phost);
-	Gpu_Copro_SendCmd(phost, CMD_KEYS);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)options << 16) | (font & 0xffff)));
+	EVE_Cmd_wrEncoded(phost, cmd);
 	Gpu_CoCmd_SendStr(phost, s);
 	EVE_Cmd_endFunc(phost);
 
@@ -339,12 +293,8 @@ ft_void_t Ft_Gpu_CoCmd_Keys(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, f
 
 ft_void_t Ft_Gpu_CoCmd_Dial(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t r, ft_uint16_t options, ft_uint16_t val)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 4);
-	Gpu_Copro_SendCmd(phost, CMD_DIAL);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)options << 16) | (r & 0xffff)));
-	Gpu_Copro_SendCmd(phost, val);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 4));
+	EVE_CmdWords4 cmd = EVE_CoCmd_encDial(x, y, r, options, val);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
@@ -354,13 +304,8 @@ ft_void_t Ft_Gpu_CoCmd_Dial(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, f
 /* Error handling for val is not done, so better to always use range of 65535 in order that needle is drawn within display region */
 ft_void_t Ft_Gpu_CoCmd_Gauge(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t r, ft_uint16_t options, ft_uint16_t major, ft_uint16_t minor, ft_uint16_t val, ft_uint16_t range)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 5);
-	Gpu_Copro_SendCmd(phost, CMD_GAUGE);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)options << 16) | (r & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)minor << 16) | (major & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)range << 16) | (val & 0xffff)));
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 5));
+	EVE_CmdWords5 cmd = EVE_CoCmd_encGauge(x, y, r, options, major, minor, val, range);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
@@ -369,13 +314,8 @@ ft_void_t Ft_Gpu_CoCmd_Gauge(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y,
 
 ft_void_t Ft_Gpu_CoCmd_Clock(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t r, ft_uint16_t options, ft_uint16_t h, ft_uint16_t m, ft_uint16_t s, ft_uint16_t ms)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 5);
-	Gpu_Copro_SendCmd(phost, CMD_CLOCK);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)options << 16) | (r & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)m << 16) | (h & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)ms << 16) | (s & 0xffff)));
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 5));
+	EVE_CmdWords5 cmd = EVE_CoCmd_encClock(x, y, r, options, h, m, s, ms);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
@@ -384,13 +324,8 @@ ft_void_t Ft_Gpu_CoCmd_Clock(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y,
 
 ft_void_t Ft_Gpu_CoCmd_Scrollbar(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t h, ft_uint16_t options, ft_uint16_t val, ft_uint16_t size, ft_uint16_t range)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 5);
-	Gpu_Copro_SendCmd(phost, CMD_SCROLLBAR);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)val << 16) | (options & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)range << 16) | (size & 0xffff)));
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 5));
+	EVE_CmdWords5 cmd = EVE_CoCmd_encScrollbar(x, y, w, h, options, val, size, range);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
@@ -399,13 +334,8 @@ ft_void_t Ft_Gpu_CoCmd_Scrollbar(EVE_HalContext *phost, ft_int16_t x, ft_int16_t
 
 ft_void_t Ft_Gpu_CoCmd_Progress(EVE_HalContext *phost, ft_int16_t x, ft_int16_t y, ft_int16_t w, ft_int16_t h, ft_uint16_t options, ft_uint16_t val, ft_uint16_t range)
 {
-	Gpu_CoCmd_StartFunc(phost, CMD_SIZE * 5);
-	Gpu_Copro_SendCmd(phost, CMD_PROGRESS);
-	Gpu_Copro_SendCmd(phost, (((uint32_t)y << 16) | (x & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)h << 16) | (w & 0xffff)));
-	Gpu_Copro_SendCmd(phost, (((uint32_t)val << 16) | (options & 0xffff)));
-	Gpu_Copro_SendCmd(phost, range);
-	Gpu_CoCmd_EndFunc(phost, (CMD_SIZE * 5));
+	EVE_CmdWords5 cmd = EVE_CoCmd_encProgress(x, y, w, h, options, val, range);
+	EVE_Cmd_wrEncoded(phost, cmd);
 
 #if ESD_DL_OPTIMIZE
 	Ft_Esd_Primitive = 0;
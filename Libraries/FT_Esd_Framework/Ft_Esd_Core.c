@@ -37,6 +37,8 @@
 #include "Ft_Esd_CoCmd.h"
 #include "Ft_Esd_BitmapHandle.h"
 #include "Ft_Esd_TouchTag.h"
+#include "Ft_Esd_Prefetch.h"
+#include "Ft_Esd_Loader.h"
 
 //
 // Globals
@@ -73,6 +75,7 @@ void Esd_ResetGpuState();
 void Esd_ResetCoState(); // TODO: Call after coprocessor reset procedure
 
 extern void Ft_Esd_Widget_ProcessFree(); // TODO: Bind from widgets
+extern void Ft_Esd_Widget_LayoutFrameStart();
 
 extern void Ft_Esd_Timer_CancelGlobal(); // TODO: Bind from widgets
 extern void Ft_Esd_Timer_UpdateGlobal(); // TODO: Bind from widgets
@@ -101,6 +104,8 @@ bool cbCmdWait(struct EVE_HalContext *phost)
 	/* Loop an idle task instead of doing nothing */
 	if (ec->Idle)
 		ec->Idle(ec->UserContext);
+	/* Keep the coprocessor busy with the image being streamed */
+	Esd_Loader_Feed();
 	/* EVE_Hal_idle(&ec->HalContext); */ /* Already called by EVE HAL */
 	ec->SwapIdled = true;
 
@@ -159,11 +164,21 @@ void Esd_Initialize(Esd_Context *ec, Esd_Parameters *ep)
 	Ft_Esd_GpuAlloc_Reset(&ec->GpuAlloc);
 
 	Esd_BitmapHandle_Initialize();
+	Esd_BitmapHandle_Reset(&ec->HandleState);
 	Esd_ResetCoState();
 }
 
+#if ESD_GPUALLOC_COMPACT_BUDGET
+static void cbGpuMoved(void *context, Ft_Esd_GpuHandle handle)
+{
+	Esd_Context *ec = (Esd_Context *)context;
+	Esd_BitmapHandle_GpuMoved(&ec->HandleState, handle);
+}
+#endif
+
 void Esd_Release(Esd_Context *ec)
 {
+	Esd_Loader_Release();
 	Ft_Gpu_Hal_Close(&ec->HalContext);
 	memset(ec, 0, sizeof(Esd_Context));
 
@@ -227,6 +242,7 @@ void Esd_Update(Esd_Context *ec)
 	// Ft_Gpu_CoCmd_LoadIdentity(phost); // ?
 	Esd_ResetGpuState();
 	Ft_Esd_Widget_ProcessFree(); // TODO: Link this back up!!!
+	Ft_Esd_Widget_LayoutFrameStart();
 	Esd_BitmapHandle_FrameStart(&ec->HandleState);
 
 	if (ec->ShowLogo)
@@ -248,6 +264,8 @@ void Esd_Update(Esd_Context *ec)
 			ec->Idle(ec->UserContext);
 		EVE_Hal_idle(phost);
 	}
+	Esd_Prefetch_Idle(); // Load resources of the next page
+	Esd_Loader_Update(); // Upload resources which have been read in the background
 
 	// Update GUI state before render
 	ec->LoopState = ESD_LOOPSTATE_UPDATE;
@@ -255,6 +273,10 @@ void Esd_Update(Esd_Context *ec)
 	ec->DeltaMs = ms - ec->Millis;
 	ec->Millis = ms;
 	Ft_Esd_GpuAlloc_Update(Ft_Esd_GAlloc); // Run GC
+#if ESD_GPUALLOC_COMPACT_BUDGET
+	if (Ft_Esd_GAlloc->FragmentedSize) // Defragment after an allocation failed for lack of a large enough free block
+		Ft_Esd_GpuAlloc_Compact(Ft_Esd_GAlloc, ESD_GPUALLOC_COMPACT_BUDGET, cbGpuMoved, ec);
+#endif
 	Ft_Esd_TouchTag_Update(NULL); // Update touch
 	if (ec->Update)
 		ec->Update(ec->UserContext);
@@ -337,6 +359,11 @@ bool Esd_WaitSwap(Esd_Context *ec)
 		Esd_ResetCoState();
 		Esd_BitmapHandle_Reset(&ec->HandleState);
 
+#if ESD_GPUALLOC_RESIDENCY
+		/* RAM_G usually survives, only reload what no longer matches */
+		Ft_Esd_GpuAlloc_Verify(&ec->GpuAlloc);
+#endif
+
 #if _DEBUG
 		/* Show error for a while */
 		EVE_sleep(1000);
@@ -0,0 +1,154 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#include "Ft_Esd_Decode.h"
+
+#if ESD_DECODE_HOST
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+	// Total time and number of pixels loaded through each path
+	ft_uint32_t HostMs;
+	ft_uint32_t HostPixels;
+	ft_uint32_t CoMs;
+	ft_uint32_t CoPixels;
+} Esd_DecodeCost;
+
+static Esd_ImageDecoder s_Decoder;
+
+// Only accessed from the main thread
+static Esd_DecodeCost s_DecodeCost[2];
+
+void Esd_SetImageDecoder(Esd_ImageDecoder decoder)
+{
+	s_Decoder = decoder;
+}
+
+ft_bool_t Esd_Decode_Prefer(ft_uint8_t kind)
+{
+	Esd_DecodeCost *cost = &s_DecodeCost[kind];
+	ft_uint32_t parallel;
+
+	if (!s_Decoder)
+		return FT_FALSE;
+
+	// Try each path once, then use the one with the lowest cost per pixel.
+	// Both costs cover reading the file, decoding, and writing the bitmap into RAM_G.
+	// The host only gains from its worker threads when other images are decoded at the same time
+	if (!cost->HostPixels)
+		return FT_TRUE;
+	if (!cost->CoPixels)
+		return FT_FALSE;
+	parallel = min(Esd_Loader_Decoding() + 1, ESD_LOADER_THREADS);
+	return (ft_uint64_t)cost->HostMs * cost->CoPixels
+	    <= (ft_uint64_t)cost->CoMs * cost->HostPixels * parallel;
+}
+
+void Esd_Decode_Measure(ft_uint8_t kind, ft_bool_t host, ft_uint32_t pixels, ft_uint32_t ms)
+{
+	Esd_DecodeCost *cost = &s_DecodeCost[kind];
+
+	// Halve the totals before they overflow, which also favours recent measurements
+	if (cost->HostPixels > 0x40000000UL || cost->CoPixels > 0x40000000UL)
+	{
+		cost->HostMs >>= 1;
+		cost->HostPixels >>= 1;
+		cost->CoMs >>= 1;
+		cost->CoPixels >>= 1;
+	}
+
+	if (host)
+	{
+		cost->HostMs += ms;
+		cost->HostPixels += pixels;
+	}
+	else
+	{
+		cost->CoMs += ms;
+		cost->CoPixels += pixels;
+	}
+}
+
+ft_uint8_t Esd_Decode_Kind(const ft_uint8_t *data, ft_uint32_t size)
+{
+	static const ft_uint8_t signature[4] = { 0x89, 'P', 'N', 'G' };
+	return (size >= 4 && !memcmp(data, signature, 4)) ? ESD_DECODE_PNG : ESD_DECODE_JPEG;
+}
+
+// Pick the smallest format which keeps the content of the image
+static ft_uint32_t pickFormat(const ft_uint8_t *rgba, ft_uint32_t pixels)
+{
+	ft_bool_t gray = FT_TRUE;
+	ft_bool_t opaque = FT_TRUE;
+	ft_bool_t mask = FT_TRUE;
+
+	for (ft_uint32_t i = 0; i < pixels; ++i, rgba += 4)
+	{
+		gray = gray && rgba[0] == rgba[1] && rgba[1] == rgba[2];
+		opaque = opaque && rgba[3] == 0xFF;
+		mask = mask && (rgba[3] == 0x00 || rgba[3] == 0xFF);
+	}
+
+	if (opaque)
+		return gray ? L8 : RGB565;
+	return mask ? ARGB1555 : ARGB4;
+}
+
+// Convert in place, the converted pixels are never larger than the source pixels
+static void convertPixels(ft_uint8_t *rgba, ft_uint32_t pixels, ft_uint32_t format)
+{
+	const ft_uint8_t *src = rgba;
+	ft_uint8_t *dst = rgba;
+	ft_uint16_t value;
+
+	for (ft_uint32_t i = 0; i < pixels; ++i, src += 4)
+	{
+		switch (format)
+		{
+		case L8:
+			*dst++ = src[0];
+			continue;
+		case RGB565:
+			value = ((src[0] >> 3) << 11) | ((src[1] >> 2) << 5) | (src[2] >> 3);
+			break;
+		case ARGB1555:
+			value = ((src[3] >> 7) << 15) | ((src[0] >> 3) << 10) | ((src[1] >> 3) << 5) | (src[2] >> 3);
+			break;
+		default: // ARGB4
+			value = ((src[3] >> 4) << 12) | ((src[0] >> 4) << 8) | ((src[1] >> 4) << 4) | (src[2] >> 4);
+			break;
+		}
+		*dst++ = value & 0xFF;
+		*dst++ = value >> 8;
+	}
+}
+
+ft_uint8_t *Esd_Decode_Image(const ft_uint8_t *data, ft_uint32_t size, ft_uint32_t *format, ft_uint32_t *bitmapSize, ft_uint32_t *pixels)
+{
+	Esd_ImageDecoder decoder = s_Decoder;
+	ft_uint32_t width, height;
+	ft_uint8_t *rgba;
+
+	if (!decoder)
+		return NULL;
+
+	rgba = decoder(data, size, &width, &height);
+	if (!rgba)
+		return NULL;
+
+	*pixels = width * height;
+	*format = pickFormat(rgba, *pixels);
+	*bitmapSize = *pixels * (*format == L8 ? 1 : 2);
+	convertPixels(rgba, *pixels, *format);
+	return rgba;
+}
+
+#endif
+
+/* end of file */
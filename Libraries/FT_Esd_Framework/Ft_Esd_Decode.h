@@ -0,0 +1,63 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#ifndef ESD_DECODE_H
+#define ESD_DECODE_H
+
+#include "Ft_Esd.h"
+#include "Ft_Esd_Loader.h"
+
+// Decode JPEG and PNG images on the host instead of using CMD_LOADIMAGE. The images are decoded by the loader
+// worker threads, converted to the smallest bitmap format which keeps the content (L8, RGB565, ARGB1555 or ARGB4),
+// and uploaded as raw data, so the command buffer stays free for rendering. The decoder itself is provided by the
+// application, for example using libpng or stb_image. Both paths are timed, and each image is loaded through the
+// path which has been the fastest so far. The image is not drawn until it is decoded
+// Disabled by default. Requires the background loader
+#ifndef ESD_DECODE_HOST
+#define ESD_DECODE_HOST 0
+#endif
+#if ESD_DECODE_HOST && !ESD_LOADER_ASYNC
+#undef ESD_DECODE_HOST
+#define ESD_DECODE_HOST 0
+#endif
+
+// Kind of image, the cost is measured separately for each
+#define ESD_DECODE_JPEG 0
+#define ESD_DECODE_PNG 1
+
+#if ESD_DECODE_HOST
+
+/// Decode an image file into 8-bit RGBA pixels, allocated with malloc.
+/// Returns NULL if the image cannot be decoded. Called from the loader worker threads
+typedef ft_uint8_t *(*Esd_ImageDecoder)(const ft_uint8_t *data, ft_uint32_t size, ft_uint32_t *width, ft_uint32_t *height);
+
+/// Set the decoder used to decode images on the host, NULL to always use the coprocessor
+void Esd_SetImageDecoder(Esd_ImageDecoder decoder);
+
+/// Check if an image should be decoded on the host
+ft_bool_t Esd_Decode_Prefer(ft_uint8_t kind);
+
+/// Record the time in milliseconds an image took to load, on the host or using the coprocessor
+void Esd_Decode_Measure(ft_uint8_t kind, ft_bool_t host, ft_uint32_t pixels, ft_uint32_t ms);
+
+/// Tell the kind of image from the start of the file
+ft_uint8_t Esd_Decode_Kind(const ft_uint8_t *data, ft_uint32_t size);
+
+/// Decode an image and convert it into a bitmap format. Returns the bitmap data allocated with malloc, or NULL on failure
+ft_uint8_t *Esd_Decode_Image(const ft_uint8_t *data, ft_uint32_t size, ft_uint32_t *format, ft_uint32_t *bitmapSize, ft_uint32_t *pixels);
+
+#else
+
+#define Esd_Decode_Prefer(kind) FT_FALSE
+#define Esd_Decode_Measure(kind, host, pixels, ms) eve_noop()
+#define Esd_Decode_Kind(data, size) ESD_DECODE_JPEG
+#define Esd_Decode_Image(data, size, format, bitmapSize, pixels) NULL
+
+#endif
+
+#endif /* #ifndef ESD_DECODE_H */
+
+/* end of file */
@@ -9,131 +9,459 @@ Allocation mechanism for RAM_G.
 
 #include "FT_Platform.h"
 #include "FT_Gpu.h"
+#include "Ft_Esd_CoCmd.h"
 
 #ifdef ESD_SIMULATION
 static int s_ErrorGpuAllocFailed = 0;
 #endif
 
+extern EVE_HalContext *Ft_Esd_Host;
+
+// Free block which was left behind by compaction. It may still be on display until the next frame,
+// so it is not reused or merged until the next Update
+#define GA_PENDING_FLAG 0x8000
+
+static void nextSeq(Ft_Esd_GpuAllocRef *ref)
+{
+	ref->Seq = (ref->Seq + 1) & GA_SEQ_MASK;
+
+	// Skip seq 0 to simplify invalid values
+	if (ref->Seq == 0)
+		ref->Seq = 1;
+}
+
+// Size class of a free block, the index of the highest set bit
+static int sizeClass(uint32_t length)
+{
+	int sc = 0;
+	while (length >>= 1)
+		++sc;
+	return sc;
+}
+
+static void linkFree(Ft_Esd_GpuAlloc *ga, uint16_t idx)
+{
+	Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+	int sc = sizeClass(entry->Length);
+	entry->PrevFree = GA_NIL;
+	entry->NextFree = ga->FreeLists[sc];
+	if (entry->NextFree != GA_NIL)
+		ga->AllocEntries[entry->NextFree].PrevFree = idx;
+	ga->FreeLists[sc] = idx;
+	ga->FreeMask |= (1UL << sc);
+}
+
+static void unlinkFree(Ft_Esd_GpuAlloc *ga, uint16_t idx)
+{
+	Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+	if (entry->PrevFree != GA_NIL)
+	{
+		ga->AllocEntries[entry->PrevFree].NextFree = entry->NextFree;
+	}
+	else
+	{
+		int sc = sizeClass(entry->Length);
+		ga->FreeLists[sc] = entry->NextFree;
+		if (entry->NextFree == GA_NIL)
+			ga->FreeMask &= ~(1UL << sc);
+	}
+	if (entry->NextFree != GA_NIL)
+		ga->AllocEntries[entry->NextFree].PrevFree = entry->PrevFree;
+}
+
+// Link a GC allocation as the most recently used
+static void linkUsed(Ft_Esd_GpuAlloc *ga, uint16_t idx)
+{
+	Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+	entry->PrevUsed = ga->MostUsed;
+	entry->NextUsed = GA_NIL;
+	if (ga->MostUsed != GA_NIL)
+		ga->AllocEntries[ga->MostUsed].NextUsed = idx;
+	else
+		ga->LeastUsed = idx;
+	ga->MostUsed = idx;
+}
+
+static void unlinkUsed(Ft_Esd_GpuAlloc *ga, uint16_t idx)
+{
+	Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+	if (entry->PrevUsed != GA_NIL)
+		ga->AllocEntries[entry->PrevUsed].NextUsed = entry->NextUsed;
+	else
+		ga->LeastUsed = entry->NextUsed;
+	if (entry->NextUsed != GA_NIL)
+		ga->AllocEntries[entry->NextUsed].PrevUsed = entry->PrevUsed;
+	else
+		ga->MostUsed = entry->PrevUsed;
+	entry->PrevUsed = GA_NIL;
+	entry->NextUsed = GA_NIL;
+}
+
+// Take an unused entry, it is not yet linked into the address order
+static uint16_t newEntry(Ft_Esd_GpuAlloc *ga)
+{
+	uint16_t idx = ga->UnusedEntry;
+	if (idx != GA_NIL)
+	{
+		ga->UnusedEntry = ga->AllocEntries[idx].NextFree;
+		++ga->NbAllocEntries;
+	}
+	return idx;
+}
+
+// Unlink an entry from the address order and return it to the unused entries
+static void deleteEntry(Ft_Esd_GpuAlloc *ga, uint16_t idx)
+{
+	Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+	if (entry->Prev != GA_NIL)
+		ga->AllocEntries[entry->Prev].Next = entry->Next;
+	else
+		ga->FirstEntry = entry->Next;
+	if (entry->Next != GA_NIL)
+		ga->AllocEntries[entry->Next].Prev = entry->Prev;
+	entry->Address = RAM_G_SIZE;
+	entry->Length = 0;
+	entry->Id = MAX_NUM_ALLOCATIONS;
+	entry->Flags = 0;
+	entry->Prev = GA_NIL;
+	entry->Next = GA_NIL;
+	entry->PrevFree = GA_NIL;
+	entry->NextFree = ga->UnusedEntry;
+	ga->UnusedEntry = idx;
+	--ga->NbAllocEntries;
+}
+
+// Insert a new free entry after an entry, and link it into the free lists
+static void insertFree(Ft_Esd_GpuAlloc *ga, uint16_t prevIdx, uint16_t freeIdx, uint32_t length)
+{
+	Ft_Esd_GpuAllocEntry *prev = &ga->AllocEntries[prevIdx];
+	Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[freeIdx];
+	entry->Address = prev->Address + prev->Length;
+	entry->Length = length;
+	entry->Id = MAX_NUM_ALLOCATIONS;
+	entry->Flags = 0;
+	entry->Prev = prevIdx;
+	entry->Next = prev->Next;
+	if (prev->Next != GA_NIL)
+		ga->AllocEntries[prev->Next].Prev = freeIdx;
+	prev->Next = freeIdx;
+	linkFree(ga, freeIdx);
+}
+
+static bool isFree(Ft_Esd_GpuAlloc *ga, uint16_t idx)
+{
+	return idx != GA_NIL
+	    && ga->AllocEntries[idx].Id == MAX_NUM_ALLOCATIONS
+	    && !(ga->AllocEntries[idx].Flags & GA_PENDING_FLAG);
+}
+
+// Merge an unlinked free entry with neighbouring free blocks, and link it into the free lists.
+// Returns the resulting free entry
+static uint16_t releaseFree(Ft_Esd_GpuAlloc *ga, uint16_t idx)
+{
+	Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+	entry->Id = MAX_NUM_ALLOCATIONS;
+	entry->Flags = 0;
+
+	// Collapse neighbouring entries
+	if (isFree(ga, entry->Next))
+	{
+		// Next entry is free, add to collapse
+		uint16_t next = entry->Next;
+		unlinkFree(ga, next);
+		entry->Length += ga->AllocEntries[next].Length;
+		deleteEntry(ga, next);
+	}
+	if (isFree(ga, entry->Prev))
+	{
+		// Previous entry is free, add to collapse
+		uint16_t prev = entry->Prev;
+		unlinkFree(ga, prev);
+		ga->AllocEntries[prev].Length += entry->Length;
+		deleteEntry(ga, idx);
+		idx = prev;
+	}
+
+	linkFree(ga, idx);
+	return idx;
+}
+
+// Find the smallest free block which fits the size, within the smallest size class that has one
+static uint16_t findFree(Ft_Esd_GpuAlloc *ga, uint32_t size)
+{
+	int sc = sizeClass(size);
+	uint16_t best = GA_NIL;
+	uint16_t idx;
+	uint32_t mask;
+
+	// Blocks in the same size class may be smaller than the requested size
+	for (idx = ga->FreeLists[sc]; idx != GA_NIL; idx = ga->AllocEntries[idx].NextFree)
+	{
+		uint32_t length = ga->AllocEntries[idx].Length;
+		if (length >= size && (best == GA_NIL || length < ga->AllocEntries[best].Length))
+		{
+			best = idx;
+			if (length == size)
+				break;
+		}
+	}
+	if (best != GA_NIL)
+		return best;
+
+	// Any block in a larger size class fits
+	mask = (sc + 1 < GA_SIZE_CLASSES) ? (ga->FreeMask & ~((2UL << sc) - 1)) : 0;
+	if (!mask)
+		return GA_NIL;
+	for (sc = sc + 1; !(mask & (1UL << sc)); ++sc)
+		;
+	for (idx = ga->FreeLists[sc]; idx != GA_NIL; idx = ga->AllocEntries[idx].NextFree)
+	{
+		if (best == GA_NIL || ga->AllocEntries[idx].Length < ga->AllocEntries[best].Length)
+			best = idx;
+	}
+	return best;
+}
+
+// Length of the largest free block
+static uint32_t largestFree(Ft_Esd_GpuAlloc *ga)
+{
+	uint32_t largest = 0;
+	uint16_t idx;
+	int sc;
+
+	// Any block in the highest size class is larger than all blocks below it
+	for (sc = GA_SIZE_CLASSES - 1; sc >= 0; --sc)
+	{
+		if (ga->FreeMask & (1UL << sc))
+		{
+			for (idx = ga->FreeLists[sc]; idx != GA_NIL; idx = ga->AllocEntries[idx].NextFree)
+				largest = max(largest, ga->AllocEntries[idx].Length);
+			break;
+		}
+	}
+	return largest;
+}
+
+static uint16_t freeId(Ft_Esd_GpuAlloc *ga, uint16_t id);
+
+// Find the least recently used GC allocation which is neither used in this frame nor on display.
+// The list is in order of LastUsed, so only the front needs to be checked
+static uint16_t findEvictable(Ft_Esd_GpuAlloc *ga)
+{
+	uint16_t idx = ga->LeastUsed;
+	if (idx != GA_NIL && (ga->Frame - ga->AllocEntries[idx].LastUsed) >= 2)
+		return idx;
+	return GA_NIL;
+}
+
+static bool evict(Ft_Esd_GpuAlloc *ga)
+{
+	uint16_t idx = findEvictable(ga);
+	if (idx == GA_NIL)
+		return false;
+	freeId(ga, ga->AllocEntries[idx].Id);
+	++ga->Evictions;
+	return true;
+}
+
+#if ESD_GPUALLOC_RESIDENCY
+
+// Remember the sealed allocations, they are adopted again when their contents still match
+static void recordResidents(Ft_Esd_GpuAlloc *ga)
+{
+	uint16_t idx;
+	uint16_t i;
+
+	if (ga->NbResidents > MAX_NUM_ALLOCATIONS)
+		ga->NbResidents = 0; // Not initialized
+
+	for (idx = ga->FirstEntry; ga->NbAllocEntries && idx != GA_NIL; idx = ga->AllocEntries[idx].Next)
+	{
+		Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+		if (entry->Id >= MAX_NUM_ALLOCATIONS || !entry->Key)
+			continue;
+
+		// Replace the previous record of the same resource
+		for (i = 0; i < ga->NbResidents && ga->Residents[i].Key != entry->Key; ++i)
+			;
+		if (i == MAX_NUM_ALLOCATIONS)
+			break;
+		if (i == ga->NbResidents)
+			++ga->NbResidents;
+		ga->Residents[i].Key = entry->Key;
+		ga->Residents[i].Address = entry->Address;
+		ga->Residents[i].Length = entry->Length;
+		ga->Residents[i].Crc = entry->Crc;
+	}
+}
+
+#endif
+
 void Ft_Esd_GpuAlloc_Reset(Ft_Esd_GpuAlloc *ga)
 {
-	int id, idx;
+	int id, idx, sc;
 
 #ifdef ESD_SIMULATION
 	s_ErrorGpuAllocFailed = 0;
 #endif
 
+#if ESD_GPUALLOC_RESIDENCY
+	recordResidents(ga);
+#endif
+
 	for (id = 0; id < MAX_NUM_ALLOCATIONS; ++id)
 	{
-		ga->AllocRefs[id].Idx = MAX_NUM_ALLOCATIONS;
-		++ga->AllocRefs[id].Seq; // Seq is always cycled, initial value not important
-
-		// Skip seq 0 to simplify invalid values
-		if (ga->AllocRefs[id].Seq == 0)
-			ga->AllocRefs[id].Seq = 1;
+		ga->AllocRefs[id].Idx = GA_NIL;
+		ga->AllocRefs[id].NextId = (id + 1 < MAX_NUM_ALLOCATIONS) ? (id + 1) : GA_NIL;
+		nextSeq(&ga->AllocRefs[id]); // Seq is always cycled, initial value not important
 	}
+	ga->UnusedId = 0;
 
-	for (idx = 0; idx < MAX_NUM_ALLOCATIONS; ++idx)
+	for (idx = 0; idx < GA_MAX_ENTRIES; ++idx)
 	{
 		ga->AllocEntries[idx].Address = RAM_G_SIZE;
 		ga->AllocEntries[idx].Length = 0;
 		ga->AllocEntries[idx].Id = MAX_NUM_ALLOCATIONS;
 		ga->AllocEntries[idx].Flags = 0;
+		ga->AllocEntries[idx].LastUsed = 0;
+#if ESD_GPUALLOC_OWNER
+		ga->AllocEntries[idx].Owner = NULL;
+		ga->AllocEntries[idx].OwnerName = NULL;
+#endif
+#if ESD_GPUALLOC_RESIDENCY
+		ga->AllocEntries[idx].Key = NULL;
+		ga->AllocEntries[idx].Crc = 0;
+#endif
+		ga->AllocEntries[idx].Prev = GA_NIL;
+		ga->AllocEntries[idx].Next = GA_NIL;
+		ga->AllocEntries[idx].PrevFree = GA_NIL;
+		ga->AllocEntries[idx].NextFree = (idx + 1 < GA_MAX_ENTRIES) ? (idx + 1) : GA_NIL;
+		ga->AllocEntries[idx].PrevUsed = GA_NIL;
+		ga->AllocEntries[idx].NextUsed = GA_NIL;
 	}
 
+	for (sc = 0; sc < GA_SIZE_CLASSES; ++sc)
+		ga->FreeLists[sc] = GA_NIL;
+	ga->FreeMask = 0;
+	ga->LeastUsed = GA_NIL;
+	ga->MostUsed = GA_NIL;
+
+	ga->Frame = 0;
+	ga->Retention = ESD_GPUALLOC_RETENTION;
+	ga->FragmentedSize = 0;
+	ga->Hits = 0;
+	ga->Misses = 0;
+	ga->Evictions = 0;
+	ga->Allocations = 0;
+	ga->FrameAllocations = 0;
+	ga->FrameEvictions = 0;
+	ga->FrameStartAllocations = 0;
+	ga->FrameStartEvictions = 0;
+	ga->Used = 0;
+	ga->HighWater = 0;
+	ga->Adoptions = 0;
+
 	// First allocation entry is unallocated entry of entire RAM_G_SIZE
 	ga->AllocEntries[0].Address = 0;
 	ga->AllocEntries[0].Length = RAM_G_SIZE;
+	ga->FirstEntry = 0;
+	ga->UnusedEntry = 1;
 	ga->NbAllocEntries = 1;
+	linkFree(ga, 0);
 }
 
-void Ft_Esd_GpuAlloc_InsertFree(Ft_Esd_GpuAlloc *ga, uint32_t atidx, uint32_t size)
+// Allocate the start of a free block, there must be an unused Id
+static Ft_Esd_GpuHandle allocEntry(Ft_Esd_GpuAlloc *ga, uint16_t idx, uint32_t size, uint16_t flags)
 {
-	uint32_t idx;
-
-	eve_assert(ga->NbAllocEntries >= 1);
+	uint16_t id = ga->UnusedId;
+	uint32_t remaining;
+	Ft_Esd_GpuAllocEntry *entry;
+	Ft_Esd_GpuHandle ret;
 
-	// First move entries one step forward
-	for (idx = (ga->NbAllocEntries - 1); idx >= atidx; --idx)
+	// Allocate this block
+	entry = &ga->AllocEntries[idx];
+	unlinkFree(ga, idx);
+	remaining = entry->Length - size;
+	entry->Length = size;
+	entry->Id = id;
+	flags |= GA_USED_FLAG;
+	entry->Flags = flags;
+	entry->LastUsed = ga->Frame;
+	ga->UnusedId = ga->AllocRefs[id].NextId;
+	ga->AllocRefs[id].Idx = idx;
+	nextSeq(&ga->AllocRefs[id]);
+	if (flags & GA_GC_FLAG)
+		linkUsed(ga, idx);
+
+	// Insert free space entry after, the block keeps the remaining space
+	// in the rare case where compaction has left no unused entries
+	if (remaining)
 	{
-		int id = ga->AllocEntries[idx].Id;
-		if (id < MAX_NUM_ALLOCATIONS)
-		{
-			// Move reference idx one ahead
-			++ga->AllocRefs[id].Idx;
-		}
-		ga->AllocEntries[idx + 1] = ga->AllocEntries[idx];
+		uint16_t freeIdx = newEntry(ga);
+		if (freeIdx != GA_NIL)
+			insertFree(ga, idx, freeIdx, remaining);
+		else
+			entry->Length += remaining;
 	}
 
-	// Set the free space entry
-	ga->AllocEntries[atidx].Address = ga->AllocEntries[atidx - 1].Address + ga->AllocEntries[atidx - 1].Length;
-	ga->AllocEntries[atidx].Length = size;
-	ga->AllocEntries[atidx].Id = MAX_NUM_ALLOCATIONS;
-	ga->AllocEntries[atidx].Flags = 0;
-	++ga->NbAllocEntries;
+#if ESD_GPUALLOC_OWNER
+	entry->Owner = NULL;
+	entry->OwnerName = NULL;
+#endif
+#if ESD_GPUALLOC_RESIDENCY
+	entry->Key = NULL;
+	entry->Crc = 0;
+#endif
+	++ga->Allocations;
+	ga->Used += entry->Length;
+	if (ga->Used > ga->HighWater)
+		ga->HighWater = ga->Used;
+
+#ifdef ESD_SIMULATION
+	s_ErrorGpuAllocFailed = 0;
+#endif
+
+	// eve_printf_debug("Alloc id %i\n", id);
+
+	// Return the valid gpu ram handle
+	ret.Id = id;
+	ret.Seq = ga->AllocRefs[id].Seq;
+	return ret;
 }
 
 Ft_Esd_GpuHandle Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GpuAlloc *ga, uint32_t size, uint16_t flags)
 {
-	uint32_t idx;
+	uint16_t idx;
 	Ft_Esd_GpuHandle ret;
 
-	if (ga->NbAllocEntries >= MAX_NUM_ALLOCATIONS)
-	{
-		goto ReturnInvalidHandle;
-	}
+	++ga->Misses;
 
 	// Always align size to 4 bytes
 	size = (size + 3UL) & ~3UL;
+	if (!size)
+		size = 4;
 
-	// Scan through the AllocEntries, find the first open allocation that is large enough
-	for (idx = 0; idx < ga->NbAllocEntries; ++idx)
+	// Evict unused allocations until there is an unused handle and enough space
+	while (ga->UnusedId == GA_NIL)
 	{
-		// Check if allocation entry is unallocated and large enough
-		if (ga->AllocEntries[idx].Id == MAX_NUM_ALLOCATIONS
-		    && ga->AllocEntries[idx].Length >= size)
+		if (!evict(ga))
 		{
-			// Find an unused handle
-			int id;
-			for (id = 0; id < MAX_NUM_ALLOCATIONS; ++id)
-			{
-				if (ga->AllocRefs[id].Idx == MAX_NUM_ALLOCATIONS)
-				{
-					// Allocate this block
-					uint32_t remaining = ga->AllocEntries[idx].Length - size;
-					ga->AllocEntries[idx].Length = size;
-					ga->AllocEntries[idx].Id = id;
-					flags |= GA_USED_FLAG;
-					ga->AllocEntries[idx].Flags = flags;
-					ga->AllocRefs[id].Idx = idx;
-					++ga->AllocRefs[id].Seq;
-
-					// Skip seq 0 to simplify invalid values
-					if (ga->AllocRefs[id].Seq == 0)
-						ga->AllocRefs[id].Seq = 1;
-
-					// Insert free space entry after
-					if (remaining)
-					{
-						Ft_Esd_GpuAlloc_InsertFree(ga, idx + 1, remaining);
-					}
-
-#ifdef ESD_SIMULATION
-					s_ErrorGpuAllocFailed = 0;
-#endif
-
-					// eve_printf_debug("Alloc id %i\n", id);
-
-					// Return the valid gpu ram handle
-					ret.Id = id;
-					ret.Seq = ga->AllocRefs[id].Seq;
-					return ret;
-				}
-			}
-
-			// No invalid handle found
+			// No unused handle
 			goto ReturnInvalidHandle;
 		}
 	}
+	while ((idx = findFree(ga, size)) == GA_NIL)
+	{
+		if (!evict(ga))
+		{
+			// No space left, or no free block large enough
+			if (RAM_G_SIZE - ga->Used >= size)
+				ga->FragmentedSize = size;
+			goto ReturnInvalidHandle;
+		}
+	}
+
+	return allocEntry(ga, idx, size, flags);
 
 	// No space left, return an invalid allocation handle...
 ReturnInvalidHandle:
@@ -159,72 +487,47 @@ uint32_t Ft_Esd_GpuAlloc_Get(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle)
 		{
 			uint16_t id = handle.Id;
 			uint16_t idx = ga->AllocRefs[id].Idx;
-			ga->AllocEntries[idx].Flags |= GA_USED_FLAG;
-			return ga->AllocEntries[idx].Address;
+			Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+			if (!(entry->Flags & GA_USED_FLAG))
+				++ga->Hits;
+			entry->Flags |= GA_USED_FLAG;
+			if (entry->LastUsed != ga->Frame && (entry->Flags & GA_GC_FLAG))
+			{
+				// Move to the back of the least recently used list
+				unlinkUsed(ga, idx);
+				linkUsed(ga, idx);
+			}
+			entry->LastUsed = ga->Frame;
+			return entry->Address;
 		}
 	}
 
 	return ~0;
 }
 
-void Ft_Esd_GpuAlloc_CollapseFree(Ft_Esd_GpuAlloc *ga, uint32_t idxat)
+// Free an allocated entry, merging it with neighbouring free blocks. Returns the resulting free entry
+static uint16_t freeId(Ft_Esd_GpuAlloc *ga, uint16_t id)
 {
-	int shift = 0;
-	if (idxat + 1 < ga->NbAllocEntries && ga->AllocEntries[idxat + 1].Id == MAX_NUM_ALLOCATIONS)
-	{
-		// Next entry is free, add to collapse
-		++shift;
-		ga->AllocEntries[idxat].Length += ga->AllocEntries[idxat + 1].Length;
-	}
-	if (idxat > 0 && ga->AllocEntries[idxat - 1].Id == MAX_NUM_ALLOCATIONS)
-	{
-		// Previous entry is free, add to collapse
-		--idxat;
-		++shift;
-		ga->AllocEntries[idxat].Length += ga->AllocEntries[idxat + 1].Length;
-	}
-	if (shift)
-	{
-		// Collapse indices
-		uint32_t idx;
-		ga->NbAllocEntries -= shift;
-		for (idx = idxat + 1; idx < ga->NbAllocEntries; ++idx)
-		{
-			int id;
-			ga->AllocEntries[idx] = ga->AllocEntries[idx + shift];
-			id = ga->AllocEntries[idx].Id;
-			if (id < MAX_NUM_ALLOCATIONS)
-			{
-				ga->AllocRefs[id].Idx = idx;
-			}
-		}
-	}
-}
+	uint16_t idx = ga->AllocRefs[id].Idx;
 
-void Ft_Esd_GpuAlloc_FreeId(Ft_Esd_GpuAlloc *ga, int id)
-{
 	// eve_printf_debug("Free id %i\n", id);
 
 #ifdef ESD_SIMULATION
 	s_ErrorGpuAllocFailed = 0;
 #endif
 
-	int idx = ga->AllocRefs[id].Idx;
+	ga->Used -= ga->AllocEntries[idx].Length;
+	if (ga->AllocEntries[idx].Flags & GA_GC_FLAG)
+		unlinkUsed(ga, idx);
 
 	// Invalidate handle reference
-	ga->AllocRefs[id].Idx = MAX_NUM_ALLOCATIONS;
-	++ga->AllocRefs[id].Seq;
-
-	// Skip seq 0 to simplify invalid values
-	if (ga->AllocRefs[id].Seq == 0)
-		ga->AllocRefs[id].Seq = 1;
+	ga->AllocRefs[id].Idx = GA_NIL;
+	ga->AllocRefs[id].NextId = ga->UnusedId;
+	ga->UnusedId = id;
+	nextSeq(&ga->AllocRefs[id]);
 
 	// Free entry
-	ga->AllocEntries[idx].Id = MAX_NUM_ALLOCATIONS;
-	ga->AllocEntries[idx].Flags = 0;
-
-	// Collapse neighbouring entries
-	Ft_Esd_GpuAlloc_CollapseFree(ga, idx);
+	return releaseFree(ga, idx);
 }
 
 void Ft_Esd_GpuAlloc_Free(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle)
@@ -233,74 +536,421 @@ void Ft_Esd_GpuAlloc_Free(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle)
 	if (id < MAX_NUM_ALLOCATIONS
 	    && ga->AllocRefs[id].Seq == handle.Seq)
 	{
-		Ft_Esd_GpuAlloc_FreeId(ga, id);
+		freeId(ga, id);
 	}
 }
 
 void Ft_Esd_GpuAlloc_Update(Ft_Esd_GpuAlloc *ga)
 {
-	uint32_t idx;
-	for (idx = 0; idx < ga->NbAllocEntries; ++idx)
+	uint32_t retained = 0;
+	uint16_t idx = ga->FirstEntry;
+	while (idx != GA_NIL)
 	{
+		Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+
+		// Space left behind by compaction in the previous frame is no longer on display
+		if (entry->Flags & GA_PENDING_FLAG)
+		{
+			idx = releaseFree(ga, idx);
+			idx = ga->AllocEntries[idx].Next;
+			continue;
+		}
+
 		// Check if allocation entry is allocated
-		if (ga->AllocEntries[idx].Id < MAX_NUM_ALLOCATIONS)
+		if (entry->Id < MAX_NUM_ALLOCATIONS)
 		{
-			// If GC flag is set and used flag is not set, free this memory
-			if (ga->AllocEntries[idx].Flags & GA_GC_FLAG)
-			{
-				if (!(ga->AllocEntries[idx].Flags & GA_USED_FLAG))
-				{
-					Ft_Esd_GpuAlloc_FreeId(ga, ga->AllocEntries[idx].Id);
-
-					// Due to free collapse, the current idx may become another allocated entry
-					--idx;
-					continue;
-				}
-			}
+			// Count the memory kept by unused GC allocations
+			if ((entry->Flags & GA_GC_FLAG) && !(entry->Flags & GA_USED_FLAG))
+				retained += entry->Length;
 
 			// Always clear the used flag on update
-			ga->AllocEntries[idx].Flags &= ~GA_USED_FLAG;
+			entry->Flags &= ~GA_USED_FLAG;
+		}
+
+		idx = entry->Next;
+	}
+
+	++ga->Frame;
+
+	// Compaction is no longer needed once the failed allocation fits,
+	// the space left behind by compaction was released above
+	if (ga->FragmentedSize && largestFree(ga) >= ga->FragmentedSize)
+		ga->FragmentedSize = 0;
+
+	// Evict least recently used allocations while over the retention budget,
+	// allocations used during the last frame are on display and are not evicted
+	while (retained > ga->Retention)
+	{
+		idx = findEvictable(ga);
+		if (idx == GA_NIL)
+			break;
+		retained -= ga->AllocEntries[idx].Length;
+		freeId(ga, ga->AllocEntries[idx].Id);
+		++ga->Evictions;
+	}
+
+	// Count the allocations and evictions of the frame which ended, including the evictions above
+	ga->FrameAllocations = ga->Allocations - ga->FrameStartAllocations;
+	ga->FrameEvictions = ga->Evictions - ga->FrameStartEvictions;
+	ga->FrameStartAllocations = ga->Allocations;
+	ga->FrameStartEvictions = ga->Evictions;
+
+#if ESD_GPUALLOC_DUMP_INTERVAL
+	if (!(ga->Frame % ESD_GPUALLOC_DUMP_INTERVAL))
+		Ft_Esd_GpuAlloc_Print(ga);
+#endif
+}
+
+void Ft_Esd_GpuAlloc_Pin(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle, bool pinned)
+{
+	if (handle.Id < MAX_NUM_ALLOCATIONS
+	    && ga->AllocRefs[handle.Id].Seq == handle.Seq)
+	{
+		uint16_t idx = ga->AllocRefs[handle.Id].Idx;
+		if (pinned)
+			ga->AllocEntries[idx].Flags |= GA_PINNED_FLAG;
+		else
+			ga->AllocEntries[idx].Flags &= ~GA_PINNED_FLAG;
+	}
+}
+
+// Find the smallest free block below an address which fits the size, using the free lists.
+// Blocks in a larger size class are all larger, so the first size class with a fitting block has the best fit
+static uint16_t findFreeBelow(Ft_Esd_GpuAlloc *ga, uint32_t size, uint32_t address)
+{
+	int sc;
+	for (sc = sizeClass(size); sc < GA_SIZE_CLASSES; ++sc)
+	{
+		uint16_t best = GA_NIL;
+		uint16_t idx;
+		if (!(ga->FreeMask & (1UL << sc)))
+			continue;
+		for (idx = ga->FreeLists[sc]; idx != GA_NIL; idx = ga->AllocEntries[idx].NextFree)
+		{
+			Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+			if (entry->Address < address && entry->Length >= size
+			    && (best == GA_NIL || entry->Length < ga->AllocEntries[best].Length))
+			{
+				best = idx;
+			}
 		}
+		if (best != GA_NIL)
+			return best;
 	}
+	return GA_NIL;
 }
 
-// Get total used GPU RAM
-uint32_t Ft_Esd_GpuAlloc_GetTotalUsed(Ft_Esd_GpuAlloc *ga)
+uint32_t Ft_Esd_GpuAlloc_Compact(Ft_Esd_GpuAlloc *ga, uint32_t budget, Ft_Esd_GpuAlloc_MovedCallback moved, void *context)
 {
 	uint32_t total = 0;
-	uint32_t idx;
-	for (idx = 0; idx < ga->NbAllocEntries; ++idx)
+	uint16_t idx = ga->FirstEntry;
+
+	// Move allocations down starting from the highest address, which grows the free space at the top
+	while (idx != GA_NIL && ga->AllocEntries[idx].Next != GA_NIL)
+		idx = ga->AllocEntries[idx].Next;
+
+	while (idx != GA_NIL && total < budget)
 	{
-		// Check if allocation entry is allocated
-		if (ga->AllocEntries[idx].Id < MAX_NUM_ALLOCATIONS)
+		Ft_Esd_GpuAllocEntry *source = &ga->AllocEntries[idx];
+		Ft_Esd_GpuAllocEntry *entry;
+		Ft_Esd_GpuHandle handle;
+		uint16_t freeIdx;
+		uint16_t remainingIdx = GA_NIL;
+		uint32_t remaining;
+		uint16_t prev = source->Prev;
+
+		if (source->Id >= MAX_NUM_ALLOCATIONS
+		    || (source->Flags & GA_PINNED_FLAG)
+		    || source->Length > budget - total)
+		{
+			idx = prev;
+			continue;
+		}
+
+		// Only moves into free space below the source, which does not overlap it,
+		// so the previous frame can still display the allocation at the old address
+		freeIdx = findFreeBelow(ga, source->Length, source->Address);
+		if (freeIdx == GA_NIL)
+		{
+			idx = prev;
+			continue;
+		}
+		entry = &ga->AllocEntries[freeIdx];
+		remaining = entry->Length - source->Length;
+		if (remaining)
+		{
+			remainingIdx = newEntry(ga);
+			if (remainingIdx == GA_NIL)
+				break;
+		}
+
+		Ft_Gpu_CoCmd_MemCpy(Ft_Esd_Host, entry->Address, source->Address, source->Length);
+		total += source->Length;
+
+		// The free entry takes over the allocation
+		unlinkFree(ga, freeIdx);
+		entry->Length = source->Length;
+		entry->Id = source->Id;
+		entry->Flags = source->Flags;
+		entry->LastUsed = source->LastUsed;
+#if ESD_GPUALLOC_OWNER
+		entry->Owner = source->Owner;
+		entry->OwnerName = source->OwnerName;
+#endif
+#if ESD_GPUALLOC_RESIDENCY
+		entry->Key = source->Key;
+		entry->Crc = source->Crc;
+#endif
+		ga->AllocRefs[entry->Id].Idx = freeIdx;
+		if (source->Flags & GA_GC_FLAG)
 		{
-			// Add the size of the allocated block to the total
-			total += (uint32_t)ga->AllocEntries[idx].Length;
+			// Take the place of the source in the least recently used list
+			entry->PrevUsed = source->PrevUsed;
+			entry->NextUsed = source->NextUsed;
+			if (entry->PrevUsed != GA_NIL)
+				ga->AllocEntries[entry->PrevUsed].NextUsed = freeIdx;
+			else
+				ga->LeastUsed = freeIdx;
+			if (entry->NextUsed != GA_NIL)
+				ga->AllocEntries[entry->NextUsed].PrevUsed = freeIdx;
+			else
+				ga->MostUsed = freeIdx;
+			source->PrevUsed = GA_NIL;
+			source->NextUsed = GA_NIL;
 		}
+		if (remaining)
+			insertFree(ga, freeIdx, remainingIdx, remaining);
+
+		// The source is released on the next Update
+		source->Id = MAX_NUM_ALLOCATIONS;
+		source->Flags = GA_PENDING_FLAG;
+
+		handle.Id = entry->Id;
+		handle.Seq = ga->AllocRefs[entry->Id].Seq;
+		if (moved)
+			moved(context, handle);
+
+		// Continue with the allocation below
+		idx = prev;
 	}
+
+	// Stop compacting when nothing more can be moved
+	if (!total)
+		ga->FragmentedSize = 0;
+
 	return total;
 }
 
+// Get total used GPU RAM
+uint32_t Ft_Esd_GpuAlloc_GetTotalUsed(Ft_Esd_GpuAlloc *ga)
+{
+	return ga->Used;
+}
+
 // Get total GPU RAM
 uint32_t Ft_Esd_GpuAlloc_GetTotal(Ft_Esd_GpuAlloc *ga)
 {
 	return RAM_G_SIZE;
 }
 
+void Ft_Esd_GpuAlloc_GetStats(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuAllocStats *stats)
+{
+	uint32_t largest = largestFree(ga);
+	uint16_t idx;
+
+	stats->Total = RAM_G_SIZE;
+	stats->Used = ga->Used;
+	stats->Free = RAM_G_SIZE - ga->Used;
+	stats->LargestFree = largest;
+	stats->Fragmentation = stats->Free ? (100 - (uint32_t)(((uint64_t)largest * 100) / stats->Free)) : 0;
+	stats->NbAllocations = 0;
+	for (idx = ga->FirstEntry; idx != GA_NIL; idx = ga->AllocEntries[idx].Next)
+	{
+		if (ga->AllocEntries[idx].Id < MAX_NUM_ALLOCATIONS)
+			++stats->NbAllocations;
+	}
+	stats->Capacity = MAX_NUM_ALLOCATIONS;
+	stats->HighWater = ga->HighWater;
+	stats->Hits = ga->Hits;
+	stats->Misses = ga->Misses;
+	stats->Evictions = ga->Evictions;
+	stats->Adoptions = ga->Adoptions;
+	stats->FrameAllocations = ga->FrameAllocations;
+	stats->FrameEvictions = ga->FrameEvictions;
+}
+
+#if ESD_GPUALLOC_RESIDENCY
+
+uint32_t Ft_Esd_GpuAlloc_Crc(uint32_t crc, const uint8_t *data, uint32_t size)
+{
+	// CRC-32, same as CMD_MEMCRC, one nibble at a time
+	static const uint32_t table[16] = {
+		0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+		0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+	};
+	crc = ~crc;
+	while (size--)
+	{
+		crc ^= *data++;
+		crc = (crc >> 4) ^ table[crc & 0xF];
+		crc = (crc >> 4) ^ table[crc & 0xF];
+	}
+	return ~crc;
+}
+
+void Ft_Esd_GpuAlloc_SetCrc(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle *handle, uint32_t crc)
+{
+	if (handle->Id < MAX_NUM_ALLOCATIONS
+	    && ga->AllocRefs[handle->Id].Seq == handle->Seq)
+	{
+		uint16_t idx = ga->AllocRefs[handle->Id].Idx;
+		ga->AllocEntries[idx].Key = handle;
+		ga->AllocEntries[idx].Crc = crc;
+	}
+}
+
+void Ft_Esd_GpuAlloc_Seal(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle *handle)
+{
+	uint32_t addr = Ft_Esd_GpuAlloc_Get(ga, *handle);
+	uint32_t crc;
+	if (addr != GA_INVALID
+	    && ESD_Cmd_memCrc(addr, ga->AllocEntries[ga->AllocRefs[handle->Id].Idx].Length, &crc))
+	{
+		Ft_Esd_GpuAlloc_SetCrc(ga, handle, crc);
+	}
+}
+
+// Find the free space at an exact address, splitting off the free space before it.
+// Returns the free entry which starts at the address
+static uint16_t findFreeAt(Ft_Esd_GpuAlloc *ga, uint32_t address, uint32_t size)
+{
+	uint16_t idx;
+	for (idx = ga->FirstEntry; idx != GA_NIL; idx = ga->AllocEntries[idx].Next)
+	{
+		Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+		uint32_t before = address - entry->Address;
+		uint32_t length = entry->Length;
+		uint16_t freeIdx;
+
+		if (address < entry->Address || before >= length)
+			continue;
+		if (!isFree(ga, idx) || before + size > length)
+			return GA_NIL;
+		if (!before)
+			return idx;
+
+		freeIdx = newEntry(ga);
+		if (freeIdx == GA_NIL)
+			return GA_NIL;
+		unlinkFree(ga, idx);
+		entry->Length = before;
+		linkFree(ga, idx);
+		insertFree(ga, idx, freeIdx, length - before);
+		return freeIdx;
+	}
+	return GA_NIL;
+}
+
+uint32_t Ft_Esd_GpuAlloc_Adopt(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle *handle, uint16_t flags)
+{
+	Ft_Esd_GpuAllocResident resident;
+	uint16_t idx;
+	uint16_t i;
+	uint32_t crc;
+
+	for (i = 0; i < ga->NbResidents && ga->Residents[i].Key != handle; ++i)
+		;
+	if (i >= ga->NbResidents)
+		return GA_INVALID;
+
+	// The record is used only once, whether the contents match or not
+	resident = ga->Residents[i];
+	ga->Residents[i] = ga->Residents[--ga->NbResidents];
+	if (ga->UnusedId == GA_NIL)
+		return GA_INVALID;
+	idx = findFreeAt(ga, resident.Address, resident.Length);
+	if (idx == GA_NIL)
+		return GA_INVALID;
+
+	// Claim the space first, so the check sees the same block that will be used
+	*handle = allocEntry(ga, idx, resident.Length, flags);
+	if (!ESD_Cmd_memCrc(resident.Address, resident.Length, &crc) || crc != resident.Crc)
+	{
+		Ft_Esd_GpuAlloc_Free(ga, *handle);
+		return GA_INVALID;
+	}
+
+	Ft_Esd_GpuAlloc_SetCrc(ga, handle, crc);
+	++ga->Adoptions;
+	return resident.Address;
+}
+
+uint32_t Ft_Esd_GpuAlloc_Verify(Ft_Esd_GpuAlloc *ga)
+{
+	uint32_t freed = 0;
+	uint16_t idx = ga->FirstEntry;
+	while (idx != GA_NIL)
+	{
+		Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+		uint32_t crc;
+		if (entry->Id < MAX_NUM_ALLOCATIONS && entry->Key
+		    && !(ESD_Cmd_memCrc(entry->Address, entry->Length, &crc) && crc == entry->Crc))
+		{
+			// Contents were lost, the owner loads it again
+			idx = freeId(ga, entry->Id);
+			++freed;
+		}
+		idx = ga->AllocEntries[idx].Next;
+	}
+	return freed;
+}
+
+#endif
+
+#if ESD_GPUALLOC_OWNER
+void Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle, const void *owner, const char *name)
+{
+	if (handle.Id < MAX_NUM_ALLOCATIONS
+	    && ga->AllocRefs[handle.Id].Seq == handle.Seq)
+	{
+		uint16_t idx = ga->AllocRefs[handle.Id].Idx;
+		ga->AllocEntries[idx].Owner = owner;
+		ga->AllocEntries[idx].OwnerName = name;
+	}
+}
+#endif
+
 #ifndef NDEBUG
 void Ft_Esd_GpuAlloc_Print(Ft_Esd_GpuAlloc *ga)
 {
-	uint32_t idx;
-	eve_printf_debug("GpuAlloc:\n");
-	for (idx = 0; idx < ga->NbAllocEntries; ++idx)
+	Ft_Esd_GpuAllocStats stats;
+#if defined(_DEBUG)
+	uint16_t idx;
+#endif
+	Ft_Esd_GpuAlloc_GetStats(ga, &stats);
+	eve_printf_debug("GpuAlloc: used %i, free %i, largest free %i, fragmentation %i%%, allocations %i / %i, high water %i\n",
+	    (int)stats.Used, (int)stats.Free, (int)stats.LargestFree, (int)stats.Fragmentation,
+	    (int)stats.NbAllocations, (int)stats.Capacity, (int)stats.HighWater);
+	eve_printf_debug("GpuAlloc: hits %i, misses %i, evictions %i, adoptions %i, last frame allocations %i, evictions %i\n",
+	    (int)stats.Hits, (int)stats.Misses, (int)stats.Evictions, (int)stats.Adoptions,
+	    (int)stats.FrameAllocations, (int)stats.FrameEvictions);
+#if defined(_DEBUG)
+	// The entries are only listed when debug printing is enabled
+	for (idx = ga->FirstEntry; idx != GA_NIL; idx = ga->AllocEntries[idx].Next)
 	{
-		eve_printf_debug("%i: id: %i, addr: %i, len: %i, flags: %i\n",
-		    idx,
-		    (int)ga->AllocEntries[idx].Id,
-		    (int)ga->AllocEntries[idx].Address,
-		    (int)ga->AllocEntries[idx].Length,
-		    (int)ga->AllocEntries[idx].Flags);
+		Ft_Esd_GpuAllocEntry *entry = &ga->AllocEntries[idx];
+#if ESD_GPUALLOC_OWNER
+		eve_printf_debug("%i: id: %i, addr: %i, len: %i, flags: %i, unused: %i, owner: %p, %s\n",
+		    idx, (int)entry->Id, (int)entry->Address, (int)entry->Length, (int)entry->Flags,
+		    (int)(ga->Frame - entry->LastUsed), entry->Owner,
+		    entry->OwnerName ? entry->OwnerName : "<unnamed>");
+#else
+		eve_printf_debug("%i: id: %i, addr: %i, len: %i, flags: %i, unused: %i\n",
+		    idx, (int)entry->Id, (int)entry->Address, (int)entry->Length, (int)entry->Flags,
+		    (int)(ga->Frame - entry->LastUsed));
+#endif
 	}
+#endif
 }
 #endif
 
@@ -6,7 +6,12 @@ Allocation returns a handle, consisting part of the allocation index and a seque
 Handle can be turned into an address using Ft_Esd_GpuAlloc_Get. This call should be repeated each frame,
 since the allocation may be invalidated by a graphics device reset, or the allocation may be moved by a memory
 defragmentation process.
-Supports up to MAX_NUM_ALLOCATIONS simultaneous allocations.
+Supports up to MAX_NUM_ALLOCATIONS simultaneous allocations, which may be overridden in the project defines.
+
+Free blocks are kept in segregated free lists by power of two size class. Allocation takes the best fit
+in the smallest size class that has a large enough block. Blocks are linked in address order, so that
+neighbouring free blocks are merged without moving any other entries. Handle lookup is a direct table index.
+GC allocations are also linked in least recently used order, so eviction takes the front of that list.
 
 The regular use pattern is to call Ft_Esd_GpuAlloc_Get using a stored handle during the render stage whenever an image is required.
 This function may be called with an invalid handle. Valid handles may become invalid between render stages when not in use.
@@ -17,6 +22,15 @@ and Ft_Esd_GpuAlloc_Get must be called again with the new handle to get the new
 When not using the GA_GC_FLAG, you must call Ft_Esd_GpuAlloc_Free manually when the memory is no longer in use.
 Either allocation option does not guarantee that memory will remain persistently allocated. Graphics memory can be reset whenever necessary.
 
+Ft_Esd_GpuAlloc_Compact moves allocations down into free space between frames, the handle remains valid but
+the address changes. It is only needed when FragmentedSize is set by a failed allocation. Anything which keeps the address on the device, such as a bitmap handle, must be set up again.
+Allocations with GA_PINNED_FLAG are never moved.
+
+An allocation may be sealed with the CRC of its contents, keyed by the address of the handle which the owner stores.
+Ft_Esd_GpuAlloc_Reset remembers the sealed allocations, and the owner may then adopt the block again with
+Ft_Esd_GpuAlloc_Adopt instead of reloading it, when CMD_MEMCRC shows that RAM_G still holds the same contents.
+After a coprocessor reset, Ft_Esd_GpuAlloc_Verify frees only the sealed allocations which no longer match.
+
 */
 
 #ifndef FT_ESD_GPUALLOC_H
@@ -24,9 +38,63 @@ Either allocation option does not guarantee that memory will remain persistently
 
 #include "EVE_IntTypes.h"
 
+// Maximum number of simultaneous allocations, at most GA_MAX_ID
+#ifndef MAX_NUM_ALLOCATIONS
 #define MAX_NUM_ALLOCATIONS 64UL
+#endif
+
+// Number of bits of the handle Id and Seq
+#define GA_ID_BITS 12
+#define GA_SEQ_BITS 20
+#define GA_MAX_ID ((1UL << GA_ID_BITS) - 1)
+#define GA_SEQ_MASK ((1UL << GA_SEQ_BITS) - 1)
+
+#if (MAX_NUM_ALLOCATIONS > GA_MAX_ID)
+#error MAX_NUM_ALLOCATIONS does not fit in the Ft_Esd_GpuHandle Id
+#endif
 
-// Set the GC flag. This automatically frees the allocation when the USED flag is not set during Update.
+// Number of allocation entries, including free blocks in between allocations
+#define GA_MAX_ENTRIES (MAX_NUM_ALLOCATIONS * 2UL + 1UL)
+
+// Maximum number of bytes moved by compaction per frame, 0 to disable compaction.
+// Compaction only runs after an allocation failed while enough memory was free in total
+#ifndef ESD_GPUALLOC_COMPACT_BUDGET
+#define ESD_GPUALLOC_COMPACT_BUDGET (64UL * 1024UL)
+#endif
+
+// Number of bytes which unused GC allocations may keep occupied, 0 to free them after one unused frame
+#ifndef ESD_GPUALLOC_RETENTION
+#define ESD_GPUALLOC_RETENTION RAM_G_SIZE
+#endif
+
+// Record the owner of each allocation, for Ft_Esd_GpuAlloc_Print
+#ifndef ESD_GPUALLOC_OWNER
+#ifndef NDEBUG
+#define ESD_GPUALLOC_OWNER 1
+#else
+#define ESD_GPUALLOC_OWNER 0
+#endif
+#endif
+
+// Print the allocations and statistics every this number of frames, 0 to disable
+#ifndef ESD_GPUALLOC_DUMP_INTERVAL
+#define ESD_GPUALLOC_DUMP_INTERVAL 0
+#endif
+
+// Remember the contents of sealed allocations across Reset, see Ft_Esd_GpuAlloc_Adopt.
+// Disabled by default, sealing a loaded resource waits for CMD_MEMCRC on the coprocessor
+#ifndef ESD_GPUALLOC_RESIDENCY
+#define ESD_GPUALLOC_RESIDENCY 0
+#endif
+
+// Number of free list size classes, one per power of two
+#define GA_SIZE_CLASSES 32
+
+// Entry index which refers to no entry
+#define GA_NIL 0xFFFF
+
+// Set the GC flag. This allows the allocation to be evicted when it was not used during the last frame,
+// least recently used first, when space is needed or when the unused allocations exceed the retention budget.
 // Using this flag means you must call Ft_Esd_GpuAlloc_Get on each frame to keep the allocation alive
 #define GA_GC_FLAG 1
 
@@ -36,24 +104,31 @@ Either allocation option does not guarantee that memory will remain persistently
 // Low priority flag is set when the allocation may be discarded when low on RAM (not yet implemented).
 #define GA_LOW_FLAG 4
 
-// Address which is returned when the allocation is invalid (~0).
-#define GA_INVALID ~0UL
+// Pinned flag is set when the allocation must not be moved by compaction
+#define GA_PINNED_FLAG 8
+
+// Address which is returned when the allocation is invalid (~0), as a 32-bit address.
+#define GA_INVALID ((uint32_t)~0UL)
 
 // Handle to a gpu memory allocation
 typedef struct
 {
 	/// Id in the allocation reference table
-	uint32_t Id : 8;
+	uint32_t Id : GA_ID_BITS;
 	/// Sequence number used to invalidate handles
-	uint32_t Seq : 24;
+	uint32_t Seq : GA_SEQ_BITS;
 
 } Ft_Esd_GpuHandle;
 
 // Internal information about a gpu memory allocation handle
 typedef struct
 {
-	uint32_t Idx : 8;
-	uint32_t Seq : 24;
+	/// Sequence number of the current allocation using this Id
+	uint32_t Seq;
+	/// Allocation entry, GA_NIL when the Id is not in use
+	uint16_t Idx;
+	/// Next unused Id, when the Id is not in use
+	uint16_t NextId;
 
 } Ft_Esd_GpuAllocRef;
 
@@ -62,23 +137,127 @@ typedef struct
 {
 	uint32_t Address;
 	uint32_t Length;
+	/// Allocation Id, MAX_NUM_ALLOCATIONS when the block is free
 	uint16_t Id;
 	uint16_t Flags;
+	/// Neighbouring entries in address order
+	uint16_t Prev;
+	uint16_t Next;
+	/// Neighbouring free blocks in the same size class, when the block is free.
+	/// Unused entries are chained through NextFree
+	uint16_t PrevFree;
+	uint16_t NextFree;
+	/// Neighbouring GC allocations, from least to most recently used
+	uint16_t PrevUsed;
+	uint16_t NextUsed;
+	/// Frame in which the allocation was last used
+	uint32_t LastUsed;
+#if ESD_GPUALLOC_OWNER
+	/// Structure which owns the allocation, and a name to identify it
+	const void *Owner;
+	const char *OwnerName;
+#endif
+#if ESD_GPUALLOC_RESIDENCY
+	/// Handle of the owner when the allocation is sealed, and the CRC of the contents
+	const void *Key;
+	uint32_t Crc;
+#endif
 
 } Ft_Esd_GpuAllocEntry;
 
+// Sealed allocation which was in RAM_G before the last Reset
+typedef struct
+{
+	const void *Key;
+	uint32_t Address;
+	uint32_t Length;
+	uint32_t Crc;
+
+} Ft_Esd_GpuAllocResident;
+
 typedef struct
 {
 	/// Reference to an allocation entry, by allocation Id
 	Ft_Esd_GpuAllocRef AllocRefs[MAX_NUM_ALLOCATIONS];
-	/// Allocation map,
-	Ft_Esd_GpuAllocEntry AllocEntries[MAX_NUM_ALLOCATIONS];
+	/// Allocation entries, linked in address order
+	Ft_Esd_GpuAllocEntry AllocEntries[GA_MAX_ENTRIES];
 	/// Number of valid alloc entries
 	uint32_t NbAllocEntries;
+	/// First entry in address order
+	uint16_t FirstEntry;
+	/// First unused entry
+	uint16_t UnusedEntry;
+	/// First unused Id
+	uint16_t UnusedId;
+	/// Free blocks by size class
+	uint16_t FreeLists[GA_SIZE_CLASSES];
+	/// Bit set for each size class which has free blocks
+	uint32_t FreeMask;
+	/// Least and most recently used GC allocations, the eviction candidates are taken from the front
+	uint16_t LeastUsed;
+	uint16_t MostUsed;
+	/// Frame counter, advanced on every Update
+	uint32_t Frame;
+	/// Number of bytes which unused GC allocations may keep occupied, may be changed after Reset
+	uint32_t Retention;
+	/// Size of the last allocation which failed while enough memory was free in total,
+	/// cleared by Ft_Esd_GpuAlloc_Compact once a large enough free block is available
+	uint32_t FragmentedSize;
+	/// Number of times an allocation from an earlier frame was first used in a frame
+	uint32_t Hits;
+	/// Number of allocation requests, including failed ones. A miss is the load that follows an invalid handle,
+	/// so both counters are counted at most once per resource per frame
+	uint32_t Misses;
+	/// Number of GC allocations which were evicted
+	uint32_t Evictions;
+	/// Number of successful allocations
+	uint32_t Allocations;
+	/// Number of allocations and evictions during the last frame
+	uint32_t FrameAllocations;
+	uint32_t FrameEvictions;
+	/// Counters at the start of the current frame
+	uint32_t FrameStartAllocations;
+	uint32_t FrameStartEvictions;
+	/// Number of allocated bytes, and the highest number since Reset
+	uint32_t Used;
+	uint32_t HighWater;
+	/// Number of allocations adopted again after Reset
+	uint32_t Adoptions;
+#if ESD_GPUALLOC_RESIDENCY
+	/// Sealed allocations from before the last Reset which have not been adopted yet, kept across Reset
+	Ft_Esd_GpuAllocResident Residents[MAX_NUM_ALLOCATIONS];
+	uint16_t NbResidents;
+#endif
 
 } Ft_Esd_GpuAlloc;
 
-// Initialize or reset gpu ram allocation mechanism
+// Gpu memory statistics
+typedef struct
+{
+	uint32_t Total;
+	uint32_t Used;
+	uint32_t Free;
+	/// Largest free block, the largest allocation which can succeed without eviction
+	uint32_t LargestFree;
+	/// Percentage of free memory outside the largest free block
+	uint32_t Fragmentation;
+	/// Number of allocations, and the maximum number of allocations
+	uint32_t NbAllocations;
+	uint32_t Capacity;
+	/// Highest number of allocated bytes since Reset
+	uint32_t HighWater;
+	/// Cache counters since Reset, see Ft_Esd_GpuAlloc
+	uint32_t Hits;
+	uint32_t Misses;
+	uint32_t Evictions;
+	uint32_t Adoptions;
+	/// Number of allocations (loads and reloads) and evictions during the last frame
+	uint32_t FrameAllocations;
+	uint32_t FrameEvictions;
+
+} Ft_Esd_GpuAllocStats;
+
+// Initialize or reset gpu ram allocation mechanism. The structure must be zeroed before it is first reset
 void Ft_Esd_GpuAlloc_Reset(Ft_Esd_GpuAlloc *ga);
 
 // Run basic garbage collection and any other mechanisms, call first in the Update cycle, after the frame is fully rendered and swapped
@@ -93,12 +272,58 @@ void Ft_Esd_GpuAlloc_Free(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle);
 // Get ram address from handle. Returns ~0 when invalid.
 uint32_t Ft_Esd_GpuAlloc_Get(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle);
 
+// Set or clear the pinned flag of a gpu ram block
+void Ft_Esd_GpuAlloc_Pin(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle, bool pinned);
+
+// Called for each allocation which was moved by compaction
+typedef void (*Ft_Esd_GpuAlloc_MovedCallback)(void *context, Ft_Esd_GpuHandle handle);
+
+// Move allocations down into free space using CMD_MEMCPY, up to approximately the budget in bytes.
+// Call in between frames, after Update. Returns the number of bytes moved
+uint32_t Ft_Esd_GpuAlloc_Compact(Ft_Esd_GpuAlloc *ga, uint32_t budget, Ft_Esd_GpuAlloc_MovedCallback moved, void *context);
+
 // Get total used GPU RAM
 uint32_t Ft_Esd_GpuAlloc_GetTotalUsed(Ft_Esd_GpuAlloc *ga);
 
 // Get total GPU RAM
 uint32_t Ft_Esd_GpuAlloc_GetTotal(Ft_Esd_GpuAlloc *ga);
 
+// Get gpu memory statistics
+void Ft_Esd_GpuAlloc_GetStats(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuAllocStats *stats);
+
+#if ESD_GPUALLOC_RESIDENCY
+
+// Update a CRC-32 as calculated by CMD_MEMCRC, starting from 0
+uint32_t Ft_Esd_GpuAlloc_Crc(uint32_t crc, const uint8_t *data, uint32_t size);
+
+// Seal an allocation with the CRC of its whole length, calculated on the host while loading
+void Ft_Esd_GpuAlloc_SetCrc(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle *handle, uint32_t crc);
+
+// Seal an allocation after it was loaded, using CMD_MEMCRC
+void Ft_Esd_GpuAlloc_Seal(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle *handle);
+
+// Allocate the block which was sealed with this handle before the last Reset, if RAM_G still holds the same contents.
+// Sets the handle and returns the address, or returns GA_INVALID when the contents must be loaded
+uint32_t Ft_Esd_GpuAlloc_Adopt(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle *handle, uint16_t flags);
+
+// Check the sealed allocations after a coprocessor reset, and free the ones which no longer match.
+// Returns the number of allocations which were freed
+uint32_t Ft_Esd_GpuAlloc_Verify(Ft_Esd_GpuAlloc *ga);
+
+#else
+#define Ft_Esd_GpuAlloc_SetCrc(ga, handle, crc) eve_noop()
+#define Ft_Esd_GpuAlloc_Seal(ga, handle) eve_noop()
+#define Ft_Esd_GpuAlloc_Adopt(ga, handle, flags) GA_INVALID
+#define Ft_Esd_GpuAlloc_Verify(ga) 0
+#endif
+
+// Name the owner of an allocation, such as the Ft_Esd_BitmapInfo or Esd_ResourceInfo, for Ft_Esd_GpuAlloc_Print
+#if ESD_GPUALLOC_OWNER
+void Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GpuAlloc *ga, Ft_Esd_GpuHandle handle, const void *owner, const char *name);
+#else
+#define Ft_Esd_GpuAlloc_SetOwner(ga, handle, owner, name) eve_noop()
+#endif
+
 #ifndef NDEBUG
 void Ft_Esd_GpuAlloc_Print(Ft_Esd_GpuAlloc *ga);
 #else
@@ -24,12 +24,12 @@ void Ft_Esd_Layout_Fixed_Update(Ft_Esd_Layout_Fixed *context)
 {
 	if (context->Widget.Recalculate)
 	{
-		context->Widget.Recalculate = 0;
 		Ft_Esd_Widget *child = context->Widget.First;
+		++Ft_Esd_LayoutStats.Recalculated;
 		while (child)
 		{
 			Ft_Esd_Widget *const next = child->Next;
-			if (child->Active)
+			if (child->Active && Ft_Esd_Widget_NeedsLayout(&context->Widget, child))
 			{
 				Ft_Esd_Widget_SetGlobalRect(child,
 				    context->Widget.GlobalX + child->LocalX,
@@ -39,6 +39,8 @@ void Ft_Esd_Layout_Fixed_Update(Ft_Esd_Layout_Fixed *context)
 			}
 			child = next;
 		}
+		context->Widget.Recalculate = 0;
+		context->Widget.RecalculateLocal = 0;
 	}
 	Ft_Esd_Widget_IterateChildActiveSlotReverse((Ft_Esd_Widget *)context, FT_ESD_WIDGET_UPDATE);
 }
@@ -9,7 +9,7 @@ static Ft_Esd_WidgetSlots s_Ft_Esd_Layout_Linear__Slots = {
 	(void (*)(void *))Ft_Esd_Layout_Linear_Render,
 	(void (*)(void *))Ft_Esd_Layout_Linear_Idle,
 	(void (*)(void *))Ft_Esd_Widget_Disable,
-	(void (*)(void *))Ft_Esd_Widget_End,
+	(void (*)(void *))Ft_Esd_Layout_Linear_End,
 };
 
 void Ft_Esd_Layout_Linear__Initializer(Ft_Esd_Layout_Linear *context)
@@ -28,6 +28,7 @@ void Ft_Esd_Layout_Linear__Initializer(Ft_Esd_Layout_Linear *context)
 	context->ChildClipping = ESD_CLIP_RENDER;
 	context->AutoResize = FT_FALSE;
 	context->LastValues = context->Values;
+	memset(&context->Index, 0, sizeof(Esd_SpatialIndex));
 }
 
 void Ft_Esd_Layout_Linear_Update(Ft_Esd_Layout_Linear *context)
@@ -42,6 +43,8 @@ void Ft_Esd_Layout_Linear_Update(Ft_Esd_Layout_Linear *context)
 		// eve_printf_debug("Recalculate Linear\n");
 
 		context->Widget.Recalculate = 0;
+		context->Widget.RecalculateLocal = 0; // Siblings move when the size of a child changes
+		++Ft_Esd_LayoutStats.Recalculated;
 
 		const ft_int16_t margin = max(0, min(min(context->Margin, // Margin must be within the rectangle and positive
 		                                         context->Widget.GlobalWidth >> 1),
@@ -361,10 +364,13 @@ void Ft_Esd_Layout_Linear_Update(Ft_Esd_Layout_Linear *context)
 				Ft_Esd_Widget_SetHeight((Ft_Esd_Widget *)context, childHeightTotalInclSpacing + (context->Margin * 2));
 			}
 		}
+
+		// Children follow each other along the layout direction
+		Esd_SpatialIndex_Build(&context->Index, &context->Widget, !(context->Orientation & ESD_ORIENTATION_HORIZONTAL));
 	}
 	if (context->ChildClipping & ESD_CLIP_UPDATE)
 	{
-		Ft_Esd_Widget_IterateChildVisibleSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_UPDATE);
+		Esd_SpatialIndex_IterateVisibleSlot(&context->Index, (Ft_Esd_Widget *)context, FT_ESD_WIDGET_UPDATE);
 	}
 	else
 	{
@@ -376,7 +382,7 @@ void Ft_Esd_Layout_Linear_Render(Ft_Esd_Layout_Linear *context)
 {
 	if (context->ChildClipping & ESD_CLIP_RENDER)
 	{
-		Ft_Esd_Widget_IterateChildVisibleSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_RENDER);
+		Esd_SpatialIndex_IterateVisibleSlot(&context->Index, (Ft_Esd_Widget *)context, FT_ESD_WIDGET_RENDER);
 	}
 	else
 	{
@@ -388,7 +394,7 @@ void Ft_Esd_Layout_Linear_Idle(Ft_Esd_Layout_Linear *context)
 {
 	if (context->ChildClipping & ESD_CLIP_IDLE)
 	{
-		Ft_Esd_Widget_IterateChildVisibleSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_IDLE);
+		Esd_SpatialIndex_IterateVisibleSlot(&context->Index, (Ft_Esd_Widget *)context, FT_ESD_WIDGET_IDLE);
 	}
 	else
 	{
@@ -396,6 +402,17 @@ void Ft_Esd_Layout_Linear_Idle(Ft_Esd_Layout_Linear *context)
 	}
 }
 
+void Ft_Esd_Layout_Linear_End(Ft_Esd_Layout_Linear *context)
+{
+	Esd_SpatialIndex_Release(&context->Index);
+	Ft_Esd_Widget_End((Ft_Esd_Widget *)context);
+}
+
+Ft_Esd_Widget *Ft_Esd_Layout_Linear_ChildAt(Ft_Esd_Layout_Linear *context, ft_int16_t x, ft_int16_t y)
+{
+	return Esd_SpatialIndex_ChildAt(&context->Index, (Ft_Esd_Widget *)context, x, y);
+}
+
 #ifdef ESD_SIMULATION
 #include <stdlib.h>
 
@@ -33,6 +33,7 @@
 #define FT_ESD_LAYOUT_LINEAR_H
 
 #include "Ft_Esd_Widget.h"
+#include "Ft_Esd_SpatialIndex.h"
 
 #define Ft_Esd_Layout_Linear_CLASSID 0xF3E88321
 ESD_SYMBOL(Ft_Esd_Layout_Linear_CLASSID, Type = esd_classid_t)
@@ -86,6 +87,9 @@ typedef struct
 
 	ft_int64_t LastValues;
 
+	// Children along the layout direction, for clipping
+	Esd_SpatialIndex Index;
+
 } Ft_Esd_Layout_Linear;
 
 void Ft_Esd_Layout_Linear__Initializer(Ft_Esd_Layout_Linear *context);
@@ -99,6 +103,12 @@ void Ft_Esd_Layout_Linear_Render(Ft_Esd_Layout_Linear *context);
 ESD_SLOT(Idle)
 void Ft_Esd_Layout_Linear_Idle(Ft_Esd_Layout_Linear *context);
 
+ESD_SLOT(End)
+void Ft_Esd_Layout_Linear_End(Ft_Esd_Layout_Linear *context);
+
+// Find the topmost child at the position, for touch lookup
+Ft_Esd_Widget *Ft_Esd_Layout_Linear_ChildAt(Ft_Esd_Layout_Linear *context, ft_int16_t x, ft_int16_t y);
+
 #endif /* FT_ESD_LAYOUT_LINEAR_H */
 
 /* end of file */
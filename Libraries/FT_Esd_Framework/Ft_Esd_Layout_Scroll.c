@@ -9,7 +9,7 @@ static Ft_Esd_WidgetSlots s_Ft_Esd_Layout_Scroll__Slots = {
 	(void (*)(void *))Ft_Esd_Layout_Scroll_Render,
 	(void (*)(void *))Ft_Esd_Layout_Scroll_Idle,
 	(void (*)(void *))Ft_Esd_Widget_Disable,
-	(void (*)(void *))Ft_Esd_Widget_End,
+	(void (*)(void *))Ft_Esd_Layout_Scroll_End,
 };
 
 void Ft_Esd_Layout_Scroll__Initializer(Ft_Esd_Layout_Scroll *context)
@@ -26,10 +26,39 @@ void Ft_Esd_Layout_Scroll__Initializer(Ft_Esd_Layout_Scroll *context)
 	context->ScrollX = 0;
 	context->ScrollY = 0;
 	context->Align = ESD_ALIGN_TOPFILL;
+	context->Translate = FT_FALSE;
 	context->Scissor = FT_FALSE;
 	context->ScrollXChanged = (void *)Ft_Esd_Noop;
 	context->ScrollYChanged = (void *)Ft_Esd_Noop;
 	context->LastValues = context->Values;
+	memset(&context->Index, 0, sizeof(Esd_SpatialIndex));
+}
+
+// The content is translated when rendering, vertex translation is not available on FT80x
+static ft_bool_t isTranslated(Ft_Esd_Layout_Scroll *context)
+{
+#if (EVE_MODEL >= EVE_FT810)
+	return context->Translate;
+#else
+	return FT_FALSE;
+#endif
+}
+
+// Switch to the coordinates of the translated content, the scissor rectangle is kept at the same position on screen
+static void enterContent(ft_int16_t scrollX, ft_int16_t scrollY)
+{
+	Ft_Esd_TranslateX -= scrollX;
+	Ft_Esd_TranslateY -= scrollY;
+	Ft_Esd_ScissorRect.X += scrollX;
+	Ft_Esd_ScissorRect.Y += scrollY;
+}
+
+static void leaveContent(ft_int16_t scrollX, ft_int16_t scrollY)
+{
+	Ft_Esd_TranslateX += scrollX;
+	Ft_Esd_TranslateY += scrollY;
+	Ft_Esd_ScissorRect.X -= scrollX;
+	Ft_Esd_ScissorRect.Y -= scrollY;
 }
 
 void Ft_Esd_Layout_Scroll_Recalculate(Ft_Esd_Layout_Scroll *context)
@@ -115,6 +144,12 @@ void Ft_Esd_Layout_Scroll_Recalculate(Ft_Esd_Layout_Scroll *context)
 	ft_int16_t scrollY = min(max(context->MinY, context->ScrollY), context->MaxY);
 	context->ScrollX = scrollX;
 	context->ScrollY = scrollY;
+	if (isTranslated(context))
+	{
+		// The content is placed as if not scrolled, so scrolling does not move any child widget
+		scrollX = 0;
+		scrollY = 0;
+	}
 	while (child)
 	{
 		if (child->Active)
@@ -162,67 +197,130 @@ void Ft_Esd_Layout_Scroll_Recalculate(Ft_Esd_Layout_Scroll *context)
 		}
 		child = child->Next;
 	}
+
+	// Index along the vertical axis, unless the layout only scrolls horizontally
+	Esd_SpatialIndex_Build(&context->Index, &context->Widget, (context->MinY != context->MaxY) || (context->MinX == context->MaxX));
+}
+
+// Position the children again, and store the clamped scroll values in LastScrollX and LastScrollY,
+// which are used until the next update. Notifies the owner when the scroll values changed
+static void applyScroll(Ft_Esd_Layout_Scroll *context)
+{
+	ft_int16_t lastScrollX = context->LastScrollX;
+	ft_int16_t lastScrollY = context->LastScrollY;
+	context->Widget.Recalculate = FT_FALSE;
+	Ft_Esd_Layout_Scroll_Recalculate(context);
+	context->LastValues = context->Values;
+	ft_int16_t scrollX = context->ScrollX;
+	ft_int16_t scrollY = context->ScrollY;
+	if (scrollX != lastScrollX)
+	{
+		context->ScrollXChanged(context->Owner, scrollX);
+	}
+	if (scrollY != lastScrollY)
+	{
+		context->ScrollYChanged(context->Owner, scrollY);
+	}
 }
 
 void Ft_Esd_Layout_Scroll_Update(Ft_Esd_Layout_Scroll *context)
 {
 	if (context->Widget.Recalculate || (context->Values != context->LastValues))
 	{
-		context->Widget.Recalculate = FT_FALSE;
-		ft_int16_t lastScrollX = context->LastScrollX;
-		ft_int16_t lastScrollY = context->LastScrollY;
-		context->LastValues = context->Values;
-		Ft_Esd_Layout_Scroll_Recalculate(context);
-		ft_int16_t scrollX = context->ScrollX;
-		ft_int16_t scrollY = context->ScrollY;
-		if (scrollX != lastScrollX)
-		{
-			context->ScrollXChanged(context->Owner, scrollX);
-		}
-		if (scrollY != lastScrollY)
-		{
-			context->ScrollYChanged(context->Owner, scrollY);
-		}
+		applyScroll(context);
+	}
+	if (isTranslated(context))
+	{
+		ft_int16_t scrollX = context->LastScrollX;
+		ft_int16_t scrollY = context->LastScrollY;
+		enterContent(scrollX, scrollY);
+		Ft_Esd_Widget_IterateChildActiveSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_UPDATE);
+		leaveContent(scrollX, scrollY);
+	}
+	else
+	{
+		Ft_Esd_Widget_IterateChildActiveSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_UPDATE);
 	}
-	Ft_Esd_Widget_IterateChildActiveSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_UPDATE);
 	if (context->Widget.Recalculate)
 	{
-		context->Widget.Recalculate = FT_FALSE;
-		ft_int16_t lastScrollX = context->ScrollX;
-		ft_int16_t lastScrollY = context->ScrollX;
-		Ft_Esd_Layout_Scroll_Recalculate(context);
-		ft_int16_t scrollX = context->ScrollX;
-		ft_int16_t scrollY = context->ScrollY;
-		if (scrollX != lastScrollX)
-		{
-			context->ScrollXChanged(context->Owner, scrollX);
-		}
-		if (scrollY != lastScrollY)
-		{
-			context->ScrollYChanged(context->Owner, scrollY);
-		}
+		applyScroll(context);
 	}
 }
 
-void Ft_Esd_Layout_Scroll_Render(Ft_Esd_Layout_Scroll *context)
+static void renderChildren(Ft_Esd_Layout_Scroll *context)
 {
-	Ft_Esd_Rect16 scissor;
+#if ESD_SPATIAL_INDEX
 	if (context->Scissor)
 	{
-		scissor = Ft_Esd_Dl_Scissor_Set(context->Widget.GlobalRect);
+		// Children outside the scissor are not visible, so they are skipped
+		Esd_SpatialIndex_IterateVisibleSlot(&context->Index, (Ft_Esd_Widget *)context, FT_ESD_WIDGET_RENDER);
+		return;
 	}
-
+#endif
 	Ft_Esd_Widget_IterateChildActiveValidSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_RENDER);
+}
 
+void Ft_Esd_Layout_Scroll_Render(Ft_Esd_Layout_Scroll *context)
+{
+	Ft_Esd_Rect16 scissor;
 	if (context->Scissor)
+		scissor = Ft_Esd_Dl_Scissor_Set(context->Widget.GlobalRect);
+
+#if (EVE_MODEL >= EVE_FT810)
+	if (context->Translate)
 	{
-		Ft_Esd_Dl_Scissor_Reset(scissor);
+		// Scroll values set after the last update are applied by the next update, as when not translated
+		ft_int16_t scrollX = context->LastScrollX;
+		ft_int16_t scrollY = context->LastScrollY;
+		enterContent(scrollX, scrollY);
+		Ft_Esd_Dl_VERTEX_TRANSLATE_X((ft_int32_t)Ft_Esd_TranslateX * 16);
+		Ft_Esd_Dl_VERTEX_TRANSLATE_Y((ft_int32_t)Ft_Esd_TranslateY * 16);
+		renderChildren(context);
+		leaveContent(scrollX, scrollY);
+		Ft_Esd_Dl_VERTEX_TRANSLATE_X((ft_int32_t)Ft_Esd_TranslateX * 16);
+		Ft_Esd_Dl_VERTEX_TRANSLATE_Y((ft_int32_t)Ft_Esd_TranslateY * 16);
 	}
+	else
+#endif
+	{
+		renderChildren(context);
+	}
+
+	if (context->Scissor)
+		Ft_Esd_Dl_Scissor_Reset(scissor);
 }
 
 void Ft_Esd_Layout_Scroll_Idle(Ft_Esd_Layout_Scroll *context)
 {
-	Ft_Esd_Widget_IterateChildActiveSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_IDLE);
+	if (isTranslated(context))
+	{
+		ft_int16_t scrollX = context->LastScrollX;
+		ft_int16_t scrollY = context->LastScrollY;
+		enterContent(scrollX, scrollY);
+		Ft_Esd_Widget_IterateChildActiveSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_IDLE);
+		leaveContent(scrollX, scrollY);
+	}
+	else
+	{
+		Ft_Esd_Widget_IterateChildActiveSlot((Ft_Esd_Widget *)context, FT_ESD_WIDGET_IDLE);
+	}
+}
+
+void Ft_Esd_Layout_Scroll_End(Ft_Esd_Layout_Scroll *context)
+{
+	Esd_SpatialIndex_Release(&context->Index);
+	Ft_Esd_Widget_End((Ft_Esd_Widget *)context);
+}
+
+Ft_Esd_Widget *Ft_Esd_Layout_Scroll_ChildAt(Ft_Esd_Layout_Scroll *context, ft_int16_t x, ft_int16_t y)
+{
+	if (isTranslated(context))
+	{
+		// Children are positioned in the coordinates of the content
+		x += context->LastScrollX;
+		y += context->LastScrollY;
+	}
+	return Esd_SpatialIndex_ChildAt(&context->Index, (Ft_Esd_Widget *)context, x, y);
 }
 
 ft_int16_t Ft_Esd_Layout_Scroll_Width(Ft_Esd_Layout_Scroll *context)
@@ -277,6 +375,8 @@ ft_uint8_t Ft_Esd_Layout_Scroll__Get_Align__ESD(void *context) { return ((Ft_Esd
 void Ft_Esd_Layout_Scroll__Set_Align__ESD(void *context, ft_uint8_t value) { ((Ft_Esd_Layout_Scroll__ESD *)context)->Instance.Align = value; }
 ft_bool_t Ft_Esd_Layout_Scroll__Get_Scissor__ESD(void *context) { return ((Ft_Esd_Layout_Scroll__ESD *)context)->Instance.Scissor; }
 void Ft_Esd_Layout_Scroll__Set_Scissor__ESD(void *context, ft_bool_t value) { ((Ft_Esd_Layout_Scroll__ESD *)context)->Instance.Scissor = value; }
+ft_bool_t Ft_Esd_Layout_Scroll__Get_Translate__ESD(void *context) { return ((Ft_Esd_Layout_Scroll__ESD *)context)->Instance.Translate; }
+void Ft_Esd_Layout_Scroll__Set_Translate__ESD(void *context, ft_bool_t value) { ((Ft_Esd_Layout_Scroll__ESD *)context)->Instance.Translate = value; }
 
 void Ft_Esd_Layout_Scroll__Destroy__ESD(void *context)
 {
@@ -33,6 +33,7 @@
 #define FT_ESD_LAYOUT_SCROLL_H
 
 #include "Ft_Esd_Widget.h"
+#include "Ft_Esd_SpatialIndex.h"
 
 #define Ft_Esd_Layout_Scroll_CLASSID 0xE08B661F
 ESD_SYMBOL(Ft_Esd_Layout_Scroll_CLASSID, Type = esd_classid_t)
@@ -73,6 +74,10 @@ typedef struct
 
 			ESD_VARIABLE(Align, Type = Esd_Align, Default = ESD_ALIGN_TOPFILL, Public)
 			ft_uint8_t Align; // 48
+
+			// Scroll by translating the rendered content instead of moving all child widgets, the child widgets keep their position while scrolling. Requires FT810 or later
+			ESD_VARIABLE(Translate, Type = ft_bool_t, Default = 0, Public)
+			ft_bool_t Translate; // 56
 		};
 
 		ft_uint64_t Values;
@@ -98,6 +103,9 @@ typedef struct
 		ft_int64_t LastValues;
 	};
 
+	// Children along the scroll direction, for clipping when Scissor is set
+	Esd_SpatialIndex Index;
+
 } Ft_Esd_Layout_Scroll;
 
 void Ft_Esd_Layout_Scroll__Initializer(Ft_Esd_Layout_Scroll *context);
@@ -111,6 +119,12 @@ void Ft_Esd_Layout_Scroll_Render(Ft_Esd_Layout_Scroll *context);
 ESD_SLOT(Idle)
 void Ft_Esd_Layout_Scroll_Idle(Ft_Esd_Layout_Scroll *context);
 
+ESD_SLOT(End)
+void Ft_Esd_Layout_Scroll_End(Ft_Esd_Layout_Scroll *context);
+
+// Find the topmost child at the position, for touch lookup. The position is in the same coordinates as the layout
+Ft_Esd_Widget *Ft_Esd_Layout_Scroll_ChildAt(Ft_Esd_Layout_Scroll *context, ft_int16_t x, ft_int16_t y);
+
 ESD_OUTPUT(RangeX, Type = ft_uint16_t)
 ft_uint16_t Ft_Esd_Layout_Scroll_RangeX(Ft_Esd_Layout_Scroll *context);
 
@@ -0,0 +1,766 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#include "Ft_Esd_Loader.h"
+#include "Ft_Esd_Core.h"
+#include "Ft_Esd_Decode.h"
+
+#if ESD_LOADER_ASYNC
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+extern EVE_HalContext *Ft_Esd_Host;
+extern Ft_Esd_GpuAlloc *Ft_Esd_GAlloc;
+
+#define ESD_LOADER_FREE 0
+#define ESD_LOADER_QUEUED 1 // Waiting for the worker
+#define ESD_LOADER_READING 2 // Owned by a worker
+#define ESD_LOADER_READY 3 // Data is in memory, uploading
+#define ESD_LOADER_FAILED 4 // File could not be read, kept until it is no longer requested
+#define ESD_LOADER_STREAMING 5 // Being written into the media FIFO
+
+typedef struct
+{
+	Ft_Esd_GpuHandle *GpuHandle; // Target handle, set when the upload is done
+	const char *File;
+	void *Owner;
+	ft_uint32_t Size; // Size in RAM_G
+	ft_uint16_t Flags; // Allocation flags
+	ft_bool_t Compressed;
+	ft_uint8_t Priority;
+	ft_uint8_t State;
+	ft_uint32_t Frame; // Last frame in which the job was requested
+
+	// File contents, set by the worker, or pointing into the asset pack
+	const ft_uint8_t *Data;
+	ft_uint32_t DataSize;
+	ft_bool_t Packed;
+
+	// Decoded image, the format is set when the upload is done
+	ft_int32_t *Format;
+	ft_uint32_t DecodedFormat;
+	ft_uint32_t Pixels;
+	ft_uint32_t DecodeMs; // Time to read and decode the file
+	ft_uint32_t UploadMs; // Time to write the bitmap into RAM_G
+	ft_uint8_t Kind;
+
+	// Image decoded by the coprocessor from the media FIFO
+	ft_bool_t Stream;
+
+	// Block being uploaded, and the number of bytes uploaded so far
+	Ft_Esd_GpuHandle Upload;
+	ft_uint32_t Uploaded;
+
+} Esd_LoaderJob;
+
+static Esd_LoaderJob s_LoaderJobs[ESD_LOADER_MAX];
+static ft_uint32_t s_LoaderFrame;
+static ft_bool_t s_LoaderStarted;
+static int s_LoaderNbThreads; // Number of worker threads which could be created
+static ft_bool_t s_LoaderQuit;
+
+#if ESD_LOADER_MEDIAFIFO
+// Only accessed from the main thread
+static Esd_LoaderJob *s_StreamJob;
+static Ft_Esd_GpuHandle s_StreamRing = { MAX_NUM_ALLOCATIONS, 0 };
+static ft_uint32_t s_StreamWp;
+// Image written completely during the last frame, kept pinned until the coprocessor has decoded it
+static Ft_Esd_GpuHandle *s_StreamDone;
+static Ft_Esd_GpuHandle s_StreamDoneUpload = { MAX_NUM_ALLOCATIONS, 0 };
+#endif
+
+// The workers only change jobs in the QUEUED and READING states, all other states belong to the main thread.
+// The lock is statically initialized, so it is valid before the workers are started and after they are stopped
+#if defined(_WIN32)
+static SRWLOCK s_LoaderLock = SRWLOCK_INIT;
+static CONDITION_VARIABLE s_LoaderWake = CONDITION_VARIABLE_INIT;
+static CONDITION_VARIABLE s_LoaderRead = CONDITION_VARIABLE_INIT;
+static HANDLE s_LoaderThreads[ESD_LOADER_THREADS];
+#define loaderLock() AcquireSRWLockExclusive(&s_LoaderLock)
+#define loaderUnlock() ReleaseSRWLockExclusive(&s_LoaderLock)
+#define loaderWait() SleepConditionVariableSRW(&s_LoaderWake, &s_LoaderLock, INFINITE, 0)
+#define loaderWake() WakeConditionVariable(&s_LoaderWake)
+#define loaderWakeAll() WakeAllConditionVariable(&s_LoaderWake)
+#define loaderWaitRead() SleepConditionVariableSRW(&s_LoaderRead, &s_LoaderLock, INFINITE, 0)
+#define loaderWakeRead() WakeAllConditionVariable(&s_LoaderRead)
+#else
+static pthread_mutex_t s_LoaderLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_LoaderWake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t s_LoaderRead = PTHREAD_COND_INITIALIZER;
+static pthread_t s_LoaderThreads[ESD_LOADER_THREADS];
+#define loaderLock() pthread_mutex_lock(&s_LoaderLock)
+#define loaderUnlock() pthread_mutex_unlock(&s_LoaderLock)
+#define loaderWait() pthread_cond_wait(&s_LoaderWake, &s_LoaderLock)
+#define loaderWake() pthread_cond_signal(&s_LoaderWake)
+#define loaderWakeAll() pthread_cond_broadcast(&s_LoaderWake)
+#define loaderWaitRead() pthread_cond_wait(&s_LoaderRead, &s_LoaderLock)
+#define loaderWakeRead() pthread_cond_broadcast(&s_LoaderRead)
+#endif
+
+// Find the job with the highest priority in the given state, most recently requested first
+static Esd_LoaderJob *nextJob(ft_uint8_t state)
+{
+	Esd_LoaderJob *best = NULL;
+	for (int i = 0; i < ESD_LOADER_MAX; ++i)
+	{
+		Esd_LoaderJob *job = &s_LoaderJobs[i];
+		if (job->State != state)
+			continue;
+		if (!best || job->Priority > best->Priority
+		    || (job->Priority == best->Priority && (ft_int32_t)(job->Frame - best->Frame) > 0))
+			best = job;
+	}
+	return best;
+}
+
+static ft_uint8_t *readFile(const char *file, ft_uint32_t *size)
+{
+	FILE *f;
+	ft_uint8_t *data;
+	long fileSize;
+
+#pragma warning(push)
+#pragma warning(disable : 4996)
+	f = fopen(file, "rb");
+#pragma warning(pop)
+	if (!f)
+		return NULL;
+
+	fseek(f, 0, SEEK_END);
+	fileSize = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	data = fileSize > 0 ? malloc(fileSize) : NULL;
+	if (data && fread(data, 1, fileSize, f) != (size_t)fileSize)
+	{
+		free(data);
+		data = NULL;
+	}
+	fclose(f);
+
+	*size = (ft_uint32_t)fileSize;
+	return data;
+}
+
+static void freeData(Esd_LoaderJob *job)
+{
+	if (!job->Packed)
+		free((void *)job->Data);
+	job->Data = NULL;
+}
+
+static void freeJob(Esd_LoaderJob *job)
+{
+	freeData(job);
+	memset(job, 0, sizeof(Esd_LoaderJob));
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI worker(LPVOID param)
+#else
+static void *worker(void *param)
+#endif
+{
+	(void)param;
+	loaderLock();
+	for (;;)
+	{
+		Esd_LoaderJob *job = nextJob(ESD_LOADER_QUEUED);
+		if (s_LoaderQuit)
+			break;
+		if (!job)
+		{
+			loaderWait();
+			continue;
+		}
+
+		// Read outside of the lock, the main thread does not touch jobs which are being read
+		const char *file = job->File;
+		const ft_uint8_t *source = job->Data; // Already set for files in the asset pack
+		ft_uint32_t sourceSize = job->DataSize;
+		ft_bool_t decode = job->Format && !job->Stream;
+		ft_uint8_t *data;
+		ft_uint32_t size = 0;
+		ft_uint32_t format = 0;
+		ft_uint32_t pixels = 0;
+		ft_uint32_t ms = 0;
+		ft_uint8_t kind = ESD_DECODE_JPEG;
+		job->State = ESD_LOADER_READING;
+		loaderUnlock();
+		if (decode)
+		{
+			// Time the read as well, the coprocessor path is timed from reading the file to the decoded bitmap
+			ft_uint32_t start = EVE_millis();
+			ft_uint8_t *read = source ? NULL : readFile(file, &sourceSize);
+			data = NULL;
+			if (source || read)
+			{
+				kind = Esd_Decode_Kind(source ? source : read, sourceSize);
+				data = Esd_Decode_Image(source ? source : read, sourceSize, &format, &size, &pixels);
+				ms = EVE_millis() - start;
+			}
+			free(read);
+		}
+		else
+		{
+			data = readFile(file, &size);
+		}
+		loaderLock();
+
+		if (decode)
+		{
+			// The decoded bitmap replaces the file, and sets the allocation size
+			freeData(job);
+			job->Packed = FT_FALSE;
+			job->Size = size;
+			job->DecodedFormat = format;
+			job->Pixels = pixels;
+			job->DecodeMs = ms;
+			job->Kind = kind;
+		}
+		job->Data = data;
+		job->DataSize = size;
+		job->State = data ? ESD_LOADER_READY : ESD_LOADER_FAILED;
+		loaderWakeRead();
+	}
+	loaderUnlock();
+	return 0;
+}
+
+static Esd_LoaderJob *findJob(Ft_Esd_GpuHandle *gpuHandle)
+{
+	for (int i = 0; i < ESD_LOADER_MAX; ++i)
+	{
+		if (s_LoaderJobs[i].State != ESD_LOADER_FREE && s_LoaderJobs[i].GpuHandle == gpuHandle)
+			return &s_LoaderJobs[i];
+	}
+	return NULL;
+}
+
+// Drop the jobs which point into the asset pack before it is closed, waiting for the images decoded from it
+static void closePack()
+{
+	loaderLock();
+	for (int i = 0; i < ESD_LOADER_MAX; ++i)
+	{
+		Esd_LoaderJob *job = &s_LoaderJobs[i];
+		while (job->State == ESD_LOADER_READING && job->Packed)
+			loaderWaitRead();
+		if (job->State != ESD_LOADER_FREE && job->Packed)
+		{
+#if ESD_LOADER_MEDIAFIFO
+			if (s_StreamJob == job)
+				s_StreamJob = NULL;
+#endif
+			Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, job->Upload);
+			freeJob(job);
+		}
+	}
+	loaderUnlock();
+}
+
+static void startLoader()
+{
+	if (s_LoaderStarted)
+		return;
+
+	s_LoaderStarted = FT_TRUE;
+	s_LoaderQuit = FT_FALSE;
+	EVE_Util_setPackCloseCallback(closePack);
+	while (s_LoaderNbThreads < ESD_LOADER_THREADS)
+	{
+#if defined(_WIN32)
+		s_LoaderThreads[s_LoaderNbThreads] = CreateThread(NULL, 0, worker, NULL, 0, NULL);
+		if (!s_LoaderThreads[s_LoaderNbThreads])
+			break;
+#else
+		if (pthread_create(&s_LoaderThreads[s_LoaderNbThreads], NULL, worker, NULL))
+			break;
+#endif
+		++s_LoaderNbThreads;
+	}
+	if (s_LoaderNbThreads < ESD_LOADER_THREADS)
+		eve_printf_debug("Started %i of %i loader threads\n", s_LoaderNbThreads, (int)ESD_LOADER_THREADS);
+}
+
+static ft_bool_t requestJob(Ft_Esd_GpuHandle *gpuHandle, const char *file, ft_bool_t compressed, ft_uint32_t size, ft_uint16_t flags, void *owner, ft_int32_t *format, ft_bool_t stream)
+{
+	ft_uint8_t priority = (Esd_CurrentContext->LoopState == ESD_LOOPSTATE_RENDER) ? ESD_LOADER_VISIBLE : ESD_LOADER_BACKGROUND;
+	const EVE_PackEntry *entry = EVE_Util_findPackEntry(file);
+	Esd_LoaderJob *job;
+
+	// Files in the asset pack are not read, but can only be uploaded in parts when the pack is mapped
+	if (entry && !EVE_Util_packData(entry))
+		return FT_FALSE;
+
+	// Use the other form of the file if it loads faster
+	if (entry && !format)
+	{
+		const EVE_PackEntry *preferred = EVE_Util_preferPackEntry(entry);
+		if (preferred != entry)
+		{
+			entry = preferred;
+			compressed = preferred->Compression == EVE_PACK_DEFLATE;
+		}
+	}
+
+	startLoader();
+	loaderLock();
+	job = findJob(gpuHandle);
+	if (job)
+	{
+		// Keep the highest priority it was requested with this frame
+		if (job->Frame != s_LoaderFrame || priority > job->Priority)
+			job->Priority = priority;
+		job->Frame = s_LoaderFrame;
+		loaderUnlock();
+
+		// An image which could not be decoded or streamed is loaded through the command buffer instead
+		return !(format && job->State == ESD_LOADER_FAILED);
+	}
+
+	// Files which must be read need a worker
+	if (!s_LoaderNbThreads && !(entry && (!format || stream)))
+	{
+		loaderUnlock();
+		return FT_FALSE;
+	}
+
+	for (int i = 0; !job && i < ESD_LOADER_MAX; ++i)
+	{
+		if (s_LoaderJobs[i].State == ESD_LOADER_FREE)
+			job = &s_LoaderJobs[i];
+	}
+	if (!job)
+	{
+		loaderUnlock();
+		return FT_FALSE;
+	}
+
+	job->GpuHandle = gpuHandle;
+	job->File = file;
+	job->Owner = owner;
+	job->Size = size;
+	job->Flags = flags;
+	job->Compressed = compressed;
+	job->Priority = priority;
+	job->Frame = s_LoaderFrame;
+	job->Upload.Id = MAX_NUM_ALLOCATIONS;
+	job->Upload.Seq = 0;
+	job->Format = format;
+	job->Stream = stream;
+	if (entry)
+	{
+		job->Data = EVE_Util_packData(entry);
+		job->DataSize = entry->Size;
+		job->Packed = FT_TRUE;
+		if (!format || stream)
+		{
+			job->State = ESD_LOADER_READY;
+			loaderUnlock();
+			return FT_TRUE;
+		}
+	}
+	job->State = ESD_LOADER_QUEUED;
+	loaderWake();
+	loaderUnlock();
+	return FT_TRUE;
+}
+
+ft_bool_t Esd_Loader_Request(Ft_Esd_GpuHandle *gpuHandle, const char *file, ft_bool_t compressed, ft_uint32_t size, ft_uint16_t flags, void *owner)
+{
+	return requestJob(gpuHandle, file, compressed, size, flags, owner, NULL, FT_FALSE);
+}
+
+ft_bool_t Esd_Loader_RequestImage(Ft_Esd_GpuHandle *gpuHandle, const char *file, ft_int32_t *format, ft_uint16_t flags, void *owner)
+{
+	return requestJob(gpuHandle, file, FT_FALSE, 0, flags, owner, format, FT_FALSE);
+}
+
+ft_uint32_t Esd_Loader_Decoding()
+{
+	ft_uint32_t count = 0;
+	loaderLock();
+	for (int i = 0; i < ESD_LOADER_MAX; ++i)
+	{
+		Esd_LoaderJob *job = &s_LoaderJobs[i];
+		if ((job->State == ESD_LOADER_QUEUED || job->State == ESD_LOADER_READING) && job->Format && !job->Stream)
+			++count;
+	}
+	loaderUnlock();
+	return count;
+}
+
+#if ESD_LOADER_MEDIAFIFO
+ft_bool_t Esd_Loader_StreamImage(Ft_Esd_GpuHandle *gpuHandle, const char *file, ft_int32_t *format, ft_uint32_t size, ft_uint16_t flags, void *owner)
+{
+	return requestJob(gpuHandle, file, FT_FALSE, size, flags, owner, format, FT_TRUE);
+}
+#endif
+
+#if ESD_GPUALLOC_RESIDENCY
+// Remember the contents of the upload, to adopt them again after a reset
+static void sealJob(Esd_LoaderJob *job, ft_uint32_t addr)
+{
+	static const ft_uint8_t zero[4] = { 0 };
+	ft_uint32_t pad = ((job->Size + 3UL) & ~3UL) - job->Size;
+	ft_uint32_t crc;
+
+	if (job->Compressed)
+	{
+		Ft_Esd_GpuAlloc_Seal(Ft_Esd_GAlloc, job->GpuHandle);
+		return;
+	}
+	if (job->DataSize < job->Size)
+		return;
+
+	// The data is still on the host, only the padding needs to be cleared to know the whole block
+	crc = Ft_Esd_GpuAlloc_Crc(0, job->Data, job->Size);
+	if (pad)
+	{
+		EVE_Hal_wrMem(Ft_Esd_Host, addr + job->Size, zero, pad);
+		crc = Ft_Esd_GpuAlloc_Crc(crc, zero, pad);
+	}
+	Ft_Esd_GpuAlloc_SetCrc(Ft_Esd_GAlloc, job->GpuHandle, crc);
+}
+#else
+#define sealJob(job, addr) eve_noop()
+#endif
+
+// Upload the next part of a job, returns false when it must wait for the next frame
+static ft_bool_t uploadJob(Esd_LoaderJob *job, ft_uint32_t *frameBytes)
+{
+	EVE_HalContext *phost = Ft_Esd_Host;
+	ft_uint32_t addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, job->Upload);
+	ft_uint32_t start;
+	ft_bool_t measure;
+
+	if (addr == GA_INVALID)
+	{
+		// Allocate on the first part, or again when the block was evicted
+		job->Upload = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, job->Size, job->Flags);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, job->Upload, job->Owner, job->File);
+		addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, job->Upload);
+		job->Uploaded = 0;
+		if (addr == GA_INVALID)
+			return FT_FALSE; // Out of memory, try again next frame
+	}
+
+	if (job->Compressed)
+	{
+		// The inflated data must be written to the command buffer at once
+		if (*frameBytes && *frameBytes + job->DataSize > ESD_LOADER_FRAME_BUDGET)
+			return FT_FALSE;
+		if (!EVE_Cmd_waitSpace(phost, 8))
+			return FT_FALSE;
+		measure = EVE_Cmd_rp(phost) == EVE_Cmd_wp(phost); // Only time the inflate itself
+		start = EVE_millis();
+		EVE_Cmd_wr32(phost, CMD_INFLATE);
+		EVE_Cmd_wr32(phost, addr);
+		if (!EVE_Cmd_wrMem(phost, job->Data, job->DataSize) || !EVE_Cmd_waitFlush(phost))
+		{
+			eve_printf_debug("Unable to inflate: %s\n", job->File);
+			Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, job->Upload);
+			freeData(job);
+			job->State = ESD_LOADER_FAILED;
+			return FT_TRUE;
+		}
+		if (measure)
+			EVE_Util_measureLoad(EVE_PACK_DEFLATE, job->DataSize, job->Size, EVE_millis() - start);
+		job->Uploaded = job->DataSize;
+		*frameBytes += job->DataSize;
+	}
+	else
+	{
+		ft_uint32_t size = min(job->DataSize, job->Size);
+		ft_uint32_t part = min(size - job->Uploaded, ESD_LOADER_FRAME_BUDGET - *frameBytes);
+		ft_uint32_t ms;
+		start = EVE_millis();
+		EVE_Hal_wrMem(phost, addr + job->Uploaded, job->Data + job->Uploaded, part);
+		ms = EVE_millis() - start;
+		EVE_Util_measureLoad(EVE_PACK_RAW, part, part, ms);
+		job->UploadMs += ms;
+		job->Uploaded += part;
+		*frameBytes += part;
+		if (job->Uploaded < size)
+			return FT_FALSE;
+	}
+
+	// Done, unless the resource was loaded some other way in the meantime
+	if (Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, *job->GpuHandle) == GA_INVALID)
+	{
+		*job->GpuHandle = job->Upload;
+		sealJob(job, addr);
+		if (job->Format)
+		{
+			*job->Format = job->DecodedFormat;
+			Esd_Decode_Measure(job->Kind, FT_TRUE, job->Pixels, job->DecodeMs + job->UploadMs);
+		}
+	}
+	else
+		Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, job->Upload);
+	freeJob(job);
+	return FT_TRUE;
+}
+
+#if ESD_LOADER_MEDIAFIFO
+
+// Tell the bitmap format the coprocessor decodes an image into, from the file header.
+// Returns -1 for images which are not streamed, such as paletted PNG images
+static ft_int32_t streamFormat(const ft_uint8_t *data, ft_uint32_t size)
+{
+	static const ft_uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	if (size >= 2 && data[0] == 0xFF && data[1] == 0xD8)
+		return RGB565;
+	if (size < 26 || memcmp(data, signature, 8))
+		return -1;
+
+	// Color type in the IHDR chunk
+	switch (data[25])
+	{
+	case 0: // Grayscale
+		return L8;
+	case 2: // Truecolor
+		return RGB565;
+	case 4: // Grayscale with alpha
+	case 6: // Truecolor with alpha
+		return ARGB4;
+	}
+	return -1;
+}
+
+static void failStream(Esd_LoaderJob *job)
+{
+	Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, job->Upload);
+	freeData(job);
+	job->State = ESD_LOADER_FAILED;
+	if (s_StreamJob == job)
+		s_StreamJob = NULL;
+}
+
+void Esd_Loader_Feed()
+{
+	EVE_HalContext *phost = Ft_Esd_Host;
+	Esd_LoaderJob *job = s_StreamJob;
+	ft_uint32_t ring, space;
+
+	if (!job)
+		return;
+
+	// Bytes which can be written without reaching the read pointer, all positions are multiples of four
+	ring = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, s_StreamRing);
+	space = (EVE_Hal_rd32(phost, REG_MEDIAFIFO_READ) - s_StreamWp - 4) & (ESD_LOADER_MEDIAFIFO_SIZE - 1);
+	while (space && job->Uploaded < job->DataSize)
+	{
+		static const ft_uint8_t zero[4] = { 0 };
+		ft_uint32_t remaining = job->DataSize - job->Uploaded;
+		ft_uint32_t part = min(min(space, remaining), ESD_LOADER_MEDIAFIFO_SIZE - s_StreamWp);
+		ft_uint32_t padded = (part + 3UL) & ~3UL;
+		EVE_Hal_wrMem(phost, ring + s_StreamWp, job->Data + job->Uploaded, part);
+		if (padded != part)
+			EVE_Hal_wrMem(phost, ring + s_StreamWp + part, zero, padded - part);
+		job->Uploaded += part;
+		s_StreamWp = (s_StreamWp + padded) & (ESD_LOADER_MEDIAFIFO_SIZE - 1);
+		space -= padded;
+	}
+	EVE_Hal_wr32(phost, REG_MEDIAFIFO_WRITE, s_StreamWp);
+
+	if (job->Uploaded < job->DataSize)
+		return;
+
+	// The whole file is written. Commands which use the bitmap come after CMD_LOADIMAGE, so it can be drawn already.
+	// Done, unless the resource was loaded some other way in the meantime.
+	// The coprocessor is still decoding, so the block is sealed and unpinned by the next Esd_Loader_Update
+	if (Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, *job->GpuHandle) == GA_INVALID)
+	{
+		*job->GpuHandle = job->Upload;
+		*job->Format = job->DecodedFormat;
+		s_StreamDone = job->GpuHandle;
+		s_StreamDoneUpload = job->Upload;
+	}
+	else
+		Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, job->Upload);
+	s_StreamJob = NULL;
+	freeJob(job);
+}
+
+// Start decoding an image from the media FIFO, returns false when it must wait for the next frame
+static ft_bool_t streamJob(Esd_LoaderJob *job, ft_uint32_t *frameBytes)
+{
+	EVE_HalContext *phost = Ft_Esd_Host;
+	ft_int32_t format = streamFormat(job->Data, job->DataSize);
+	ft_uint32_t addr, ring;
+
+	// One image at a time
+	if (s_StreamJob)
+		return FT_FALSE;
+
+	if (format < 0)
+	{
+		eve_printf_debug("Cannot stream image: %s\n", job->File);
+		failStream(job);
+		return FT_TRUE;
+	}
+
+	job->Upload = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, job->Size, job->Flags);
+	Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, job->Upload, job->Owner, job->File);
+	addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, job->Upload);
+	if (addr == GA_INVALID)
+		return FT_FALSE; // Out of memory, try again next frame
+	Ft_Esd_GpuAlloc_Pin(Ft_Esd_GAlloc, job->Upload, FT_TRUE);
+
+	// The ring must not move while the coprocessor reads from it
+	ring = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, s_StreamRing);
+	if (ring == GA_INVALID)
+	{
+		s_StreamRing = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, ESD_LOADER_MEDIAFIFO_SIZE, 0);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, s_StreamRing, &s_StreamRing, "<media fifo>");
+		Ft_Esd_GpuAlloc_Pin(Ft_Esd_GAlloc, s_StreamRing, FT_TRUE);
+		ring = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, s_StreamRing);
+		if (ring == GA_INVALID)
+		{
+			Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, job->Upload);
+			return FT_FALSE;
+		}
+	}
+
+	// Setting up the media FIFO resets the pointers, which must be done before any data is written
+	Ft_Gpu_CoCmd_MediaFifo(phost, ring, ESD_LOADER_MEDIAFIFO_SIZE);
+	if (!EVE_Cmd_waitFlush(phost))
+	{
+		failStream(job);
+		return FT_TRUE;
+	}
+	Ft_Gpu_CoCmd_LoadImage(phost, addr, OPT_MEDIAFIFO | OPT_NODL);
+
+	job->State = ESD_LOADER_STREAMING;
+	job->DecodedFormat = format;
+	job->Uploaded = 0;
+	s_StreamJob = job;
+	s_StreamWp = 0;
+	*frameBytes += job->DataSize;
+	Esd_Loader_Feed();
+	return FT_TRUE;
+}
+
+#endif
+
+void Esd_Loader_Update()
+{
+	ft_uint32_t frameBytes = 0;
+#if ESD_LOADER_MEDIAFIFO
+	ft_bool_t streaming = FT_FALSE;
+#endif
+
+	if (!s_LoaderStarted)
+		return;
+
+#if ESD_LOADER_MEDIAFIFO
+	// The previous frame waited for the coprocessor to finish, so a stream which is still open was interrupted
+	if (s_StreamJob)
+	{
+		eve_printf_debug("Image stream interrupted: %s\n", s_StreamJob->File);
+		failStream(s_StreamJob);
+	}
+
+	// The last streamed image is decoded by now, seal it like an image loaded through the command buffer
+	if (s_StreamDone)
+	{
+		Ft_Esd_GpuAlloc_Pin(Ft_Esd_GAlloc, s_StreamDoneUpload, FT_FALSE);
+		if (s_StreamDone->Id == s_StreamDoneUpload.Id && s_StreamDone->Seq == s_StreamDoneUpload.Seq)
+			Ft_Esd_GpuAlloc_Seal(Ft_Esd_GAlloc, s_StreamDone);
+		s_StreamDone = NULL;
+	}
+#endif
+
+	loaderLock();
+	++s_LoaderFrame;
+	for (int i = 0; i < ESD_LOADER_MAX; ++i)
+	{
+		// Drop jobs which are no longer requested, unless they are being read
+		Esd_LoaderJob *job = &s_LoaderJobs[i];
+		if (job->State != ESD_LOADER_FREE && job->State != ESD_LOADER_READING
+		    && s_LoaderFrame - job->Frame > ESD_LOADER_EXPIRE)
+		{
+			if (job->State == ESD_LOADER_READY)
+				Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, job->Upload);
+			freeJob(job);
+		}
+	}
+#if ESD_LOADER_MEDIAFIFO
+	// Release the ring once no more images are streamed, the coprocessor has read all of it by now
+	for (int i = 0; i < ESD_LOADER_MAX && !streaming; ++i)
+		streaming = s_LoaderJobs[i].State != ESD_LOADER_FREE && s_LoaderJobs[i].Stream;
+#endif
+	loaderUnlock();
+#if ESD_LOADER_MEDIAFIFO
+	if (!streaming)
+		Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, s_StreamRing);
+#endif
+
+	while (frameBytes < ESD_LOADER_FRAME_BUDGET)
+	{
+		Esd_LoaderJob *job;
+		loaderLock();
+		job = nextJob(ESD_LOADER_READY);
+		loaderUnlock();
+		if (!job)
+			break;
+#if ESD_LOADER_MEDIAFIFO
+		if (job->Stream)
+		{
+			if (!streamJob(job, &frameBytes))
+				break;
+			continue;
+		}
+#endif
+		if (!uploadJob(job, &frameBytes))
+			break;
+	}
+}
+
+void Esd_Loader_Release()
+{
+	if (!s_LoaderStarted)
+		return;
+
+	loaderLock();
+	s_LoaderQuit = FT_TRUE;
+	loaderWakeAll();
+	loaderUnlock();
+	for (int i = 0; i < s_LoaderNbThreads; ++i)
+	{
+#if defined(_WIN32)
+		WaitForSingleObject(s_LoaderThreads[i], INFINITE);
+		CloseHandle(s_LoaderThreads[i]);
+#else
+		pthread_join(s_LoaderThreads[i], NULL);
+#endif
+	}
+	EVE_Util_setPackCloseCallback(NULL);
+
+	// The allocator is reset with the context, only the memory needs to be released
+	for (int i = 0; i < ESD_LOADER_MAX; ++i)
+		freeData(&s_LoaderJobs[i]);
+	memset(s_LoaderJobs, 0, sizeof(s_LoaderJobs));
+	s_LoaderStarted = FT_FALSE;
+	s_LoaderNbThreads = 0;
+#if ESD_LOADER_MEDIAFIFO
+	s_StreamJob = NULL;
+	s_StreamRing.Id = MAX_NUM_ALLOCATIONS;
+	s_StreamRing.Seq = 0;
+	s_StreamDone = NULL;
+#endif
+}
+
+#endif
+
+/* end of file */
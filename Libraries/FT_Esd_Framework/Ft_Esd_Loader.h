@@ -0,0 +1,124 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#ifndef ESD_LOADER_H
+#define ESD_LOADER_H
+
+#include "Ft_Esd.h"
+#include "Ft_Esd_GpuAlloc.h"
+
+// Load files into RAM_G without stalling the frame. A request for a file which is not loaded yet queues a job
+// and returns immediately, the caller draws a placeholder until the resource is ready. Worker threads read the
+// files into memory, and Esd_Loader_Update uploads the data between frames, at most ESD_LOADER_FRAME_BUDGET bytes
+// per frame. Files requested during the render pass are on screen, and are read and uploaded first.
+// Disabled by default, resources are then loaded synchronously. Only available on Windows and on platforms with
+// pthreads, which must be linked by the application (-lpthread)
+#ifndef ESD_LOADER_ASYNC
+#define ESD_LOADER_ASYNC 0
+#endif
+#if ESD_LOADER_ASYNC && !(defined(_WIN32) || defined(__unix__))
+#error ESD_LOADER_ASYNC requires threads
+#endif
+
+// Maximum number of bytes uploaded per frame, a compressed file is always uploaded at once
+#ifndef ESD_LOADER_FRAME_BUDGET
+#define ESD_LOADER_FRAME_BUDGET (32UL * 1024UL)
+#endif
+
+// Number of worker threads, images decoded on the host use all of them (see Ft_Esd_Decode.h)
+#ifndef ESD_LOADER_THREADS
+#define ESD_LOADER_THREADS 4
+#endif
+
+// Stream large JPEG and PNG images to the coprocessor through the media FIFO, a ring buffer in RAM_G, instead of
+// writing the whole file into the command buffer at once. The ring is fed between frames and whenever the command
+// buffer is waited on, so render commands can be written while the image is decoded. Only images which take at
+// least ESD_LOADER_MEDIAFIFO_MIN bytes in RAM_G are streamed. Disabled by default.
+// Requires FT81x or later and the background loader
+#ifndef ESD_LOADER_MEDIAFIFO
+#define ESD_LOADER_MEDIAFIFO 0
+#endif
+#if ESD_LOADER_MEDIAFIFO && (!ESD_LOADER_ASYNC || (EVE_MODEL < EVE_FT810))
+#undef ESD_LOADER_MEDIAFIFO
+#define ESD_LOADER_MEDIAFIFO 0
+#endif
+
+// Size of the media FIFO ring buffer, must be a power of two. Only allocated while an image is streamed
+#ifndef ESD_LOADER_MEDIAFIFO_SIZE
+#define ESD_LOADER_MEDIAFIFO_SIZE (16UL * 1024UL)
+#endif
+#if ESD_LOADER_MEDIAFIFO && ((ESD_LOADER_MEDIAFIFO_SIZE < 4) || (ESD_LOADER_MEDIAFIFO_SIZE & (ESD_LOADER_MEDIAFIFO_SIZE - 1)))
+#error ESD_LOADER_MEDIAFIFO_SIZE must be a power of two
+#endif
+
+// Minimum decoded size of an image to stream it
+#ifndef ESD_LOADER_MEDIAFIFO_MIN
+#define ESD_LOADER_MEDIAFIFO_MIN (64UL * 1024UL)
+#endif
+
+// Maximum number of queued jobs
+#ifndef ESD_LOADER_MAX
+#define ESD_LOADER_MAX 32
+#endif
+
+// Number of frames after which a job which is no longer requested is dropped
+#ifndef ESD_LOADER_EXPIRE
+#define ESD_LOADER_EXPIRE 60
+#endif
+
+// Priority of a job, resources requested during render are visible
+#define ESD_LOADER_BACKGROUND 0
+#define ESD_LOADER_VISIBLE 1
+
+#if ESD_LOADER_ASYNC
+
+/// Request a file to be loaded into RAM_G in the background. The target handle is set once the upload is done,
+/// and must remain valid until then. Returns false when the file cannot be loaded in the background right now,
+/// because the queue is full or the file is in an asset pack which is not mapped. The caller loads it directly instead.
+/// Jobs for files in the asset pack are dropped when the pack is closed, the caller requests the file again
+ft_bool_t Esd_Loader_Request(Ft_Esd_GpuHandle *gpuHandle, const char *file, ft_bool_t compressed, ft_uint32_t size, ft_uint16_t flags, void *owner);
+
+/// Request an image file to be decoded on the host and uploaded as a bitmap. The format is set to the bitmap format
+/// of the decoded image once the upload is done. Returns false when the image cannot be decoded in the background,
+/// the caller loads it using the coprocessor instead
+ft_bool_t Esd_Loader_RequestImage(Ft_Esd_GpuHandle *gpuHandle, const char *file, ft_int32_t *format, ft_uint16_t flags, void *owner);
+
+/// Number of images which are queued or being read to be decoded on the host
+ft_uint32_t Esd_Loader_Decoding();
+
+#if ESD_LOADER_MEDIAFIFO
+
+/// Request an image file to be streamed to the coprocessor through the media FIFO. The format is set to the bitmap
+/// format the coprocessor decodes the image into once the whole file has been written. Returns false when the image
+/// cannot be streamed, the caller loads it through the command buffer instead
+ft_bool_t Esd_Loader_StreamImage(Ft_Esd_GpuHandle *gpuHandle, const char *file, ft_int32_t *format, ft_uint32_t size, ft_uint16_t flags, void *owner);
+
+/// Write more of the streamed image into the media FIFO, called while waiting for the coprocessor
+void Esd_Loader_Feed();
+
+#else
+
+#define Esd_Loader_Feed() eve_noop()
+
+#endif
+
+/// Upload the files which have been read, called by Esd_Update during the idle phase
+void Esd_Loader_Update();
+
+/// Stop the worker threads and drop all jobs
+void Esd_Loader_Release();
+
+#else
+
+#define Esd_Loader_Feed() eve_noop()
+#define Esd_Loader_Update() eve_noop()
+#define Esd_Loader_Release() eve_noop()
+
+#endif
+
+#endif /* #ifndef ESD_LOADER_H */
+
+/* end of file */
@@ -0,0 +1,195 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#include "Ft_Esd_Prefetch.h"
+#include "Ft_Esd_GpuAlloc.h"
+
+extern Ft_Esd_GpuAlloc *Ft_Esd_GAlloc;
+
+static const Esd_ResourceSet *s_PrefetchSet;
+static ft_uint16_t s_PrefetchNext; // Next item to load
+static ft_uint32_t s_PrefetchUsed; // Bytes used by the loaded items
+static ft_bool_t s_PrefetchFull; // Budget reached
+
+#if (EVE_MODEL >= EVE_FT810)
+static ft_bool_t hasPalette(Ft_Esd_BitmapInfo *bitmapInfo)
+{
+#ifdef EVE_FLASH_AVAILABLE
+	if (bitmapInfo->Flash)
+		return bitmapInfo->PaletteFlashAddress != FA_INVALID;
+#endif
+	return !!bitmapInfo->PaletteFile;
+}
+#endif
+
+static ft_uint32_t itemSize(const Esd_PrefetchItem *item)
+{
+	switch (item->Type)
+	{
+	case ESD_PREFETCH_BITMAP:
+	{
+		Ft_Esd_BitmapInfo *bitmapInfo = item->Info;
+		ft_uint32_t size = bitmapInfo->Size;
+#if (EVE_MODEL >= EVE_FT810)
+		if (hasPalette(bitmapInfo))
+			size += 256 * 4;
+#endif
+		return size;
+	}
+	case ESD_PREFETCH_FONT:
+	{
+		Esd_FontInfo *fontInfo = item->Info;
+		return fontInfo->FontResource.RawSize + fontInfo->GlyphResource.RawSize;
+	}
+	case ESD_PREFETCH_RESOURCE:
+		return ((Esd_ResourceInfo *)item->Info)->RawSize;
+	}
+	return 0;
+}
+
+// Mark the allocation as used, true when no allocation is needed
+static ft_bool_t resourceResident(Esd_ResourceInfo *resourceInfo)
+{
+	if (!resourceInfo->Compressed && resourceInfo->Type == ESD_RESOURCE_DIRECTFLASH)
+		return FT_TRUE;
+	return Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, resourceInfo->GpuHandle) != GA_INVALID;
+}
+
+// Mark the item as used without loading it, false when it has been evicted
+static ft_bool_t itemResident(const Esd_PrefetchItem *item)
+{
+	switch (item->Type)
+	{
+	case ESD_PREFETCH_BITMAP:
+	{
+		Ft_Esd_BitmapInfo *bitmapInfo = item->Info;
+		ft_bool_t resident = FT_TRUE;
+#ifdef EVE_FLASH_AVAILABLE
+		if (bitmapInfo->PreferRam || !ESD_BITMAPINFO_SUPPORT_DIRECT_FLASH(bitmapInfo))
+#endif
+			resident = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, bitmapInfo->GpuHandle) != GA_INVALID;
+#if (EVE_MODEL >= EVE_FT810)
+		if (hasPalette(bitmapInfo)
+		    && Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, bitmapInfo->PaletteGpuHandle) == GA_INVALID)
+			resident = FT_FALSE;
+#endif
+		return resident;
+	}
+	case ESD_PREFETCH_FONT:
+	{
+		Esd_FontInfo *fontInfo = item->Info;
+		ft_bool_t resident = resourceResident(&fontInfo->GlyphResource);
+		return resourceResident(&fontInfo->FontResource) && resident;
+	}
+	case ESD_PREFETCH_RESOURCE:
+		return resourceResident(item->Info);
+	}
+	return FT_TRUE;
+}
+
+// Load the item, or mark it as used when it is already loaded
+static void loadItem(const Esd_PrefetchItem *item)
+{
+	switch (item->Type)
+	{
+	case ESD_PREFETCH_BITMAP:
+	{
+		Ft_Esd_BitmapInfo *bitmapInfo = item->Info;
+		Ft_Esd_LoadBitmap(bitmapInfo);
+#if (EVE_MODEL >= EVE_FT810)
+		if (hasPalette(bitmapInfo))
+			Ft_Esd_LoadPalette(bitmapInfo);
+#endif
+		break;
+	}
+	case ESD_PREFETCH_FONT:
+		Esd_LoadFont(item->Info);
+		break;
+	case ESD_PREFETCH_RESOURCE:
+		Esd_LoadResource(item->Info, NULL);
+		break;
+	}
+}
+
+// Load the item if it fits the frame budget and the largest free block, without evicting anything
+static ft_bool_t loadItemBudget(const Esd_PrefetchItem *item, ft_uint32_t *frameBytes)
+{
+	ft_uint32_t size = itemSize(item);
+	Ft_Esd_GpuAllocStats stats;
+
+	if (*frameBytes && (*frameBytes + size > ESD_PREFETCH_FRAME_BUDGET))
+		return FT_FALSE;
+
+	// Do not evict anything for the prefetch, wait for space instead
+	Ft_Esd_GpuAlloc_GetStats(Ft_Esd_GAlloc, &stats);
+	if (stats.LargestFree < size)
+		return FT_FALSE;
+
+	loadItem(item);
+	*frameBytes += size;
+	return FT_TRUE;
+}
+
+void Esd_Prefetch(const Esd_ResourceSet *set)
+{
+	s_PrefetchSet = set;
+	s_PrefetchNext = 0;
+	s_PrefetchUsed = 0;
+	s_PrefetchFull = FT_FALSE;
+	if (set && set->NbItems > ESD_PREFETCH_MAX)
+		eve_printf_debug("Prefetch set of %i items truncated to %i\n", (int)set->NbItems, (int)ESD_PREFETCH_MAX);
+}
+
+void Esd_Prefetch_Cancel()
+{
+	s_PrefetchSet = NULL;
+}
+
+ft_bool_t Esd_Prefetch_Done()
+{
+	return !s_PrefetchSet
+	    || s_PrefetchFull
+	    || s_PrefetchNext >= min(s_PrefetchSet->NbItems, ESD_PREFETCH_MAX);
+}
+
+void Esd_Prefetch_Idle()
+{
+	ft_uint32_t frameBytes = 0;
+	ft_uint16_t nbItems;
+	ft_uint16_t i;
+
+	if (!s_PrefetchSet)
+		return;
+
+	// Keep the prefetched resources alive until the next page uses them. Resources which have been
+	// evicted anyway are reloaded within the same frame budget, so memory pressure does not thrash
+	for (i = 0; i < s_PrefetchNext; ++i)
+	{
+		const Esd_PrefetchItem *item = &s_PrefetchSet->Items[i];
+		if (!itemResident(item))
+			loadItemBudget(item, &frameBytes);
+	}
+
+	nbItems = min(s_PrefetchSet->NbItems, ESD_PREFETCH_MAX);
+	while (!s_PrefetchFull && s_PrefetchNext < nbItems)
+	{
+		const Esd_PrefetchItem *item = &s_PrefetchSet->Items[s_PrefetchNext];
+		ft_uint32_t size = itemSize(item);
+
+		if (s_PrefetchUsed + size > ESD_PREFETCH_BUDGET)
+		{
+			s_PrefetchFull = FT_TRUE;
+			break;
+		}
+		if (!loadItemBudget(item, &frameBytes))
+			break;
+
+		s_PrefetchUsed += size;
+		++s_PrefetchNext;
+	}
+}
+
+/* end of file */
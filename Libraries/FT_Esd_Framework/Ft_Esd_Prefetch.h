@@ -0,0 +1,71 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#ifndef ESD_PREFETCH_H
+#define ESD_PREFETCH_H
+
+#include "Ft_Esd.h"
+#include "Ft_Esd_BitmapInfo.h"
+#include "Ft_Esd_FontInfo.h"
+#include "Ft_Esd_ResourceInfo.h"
+
+// Prefetch the resources of the next page into RAM_G during the idle phase of the current page.
+// Commands cannot be written from the CbCmdWait callback, so the prefetch runs in Esd_Update,
+// loading at most ESD_PREFETCH_FRAME_BUDGET bytes per frame. Resources which have been prefetched
+// are kept alive until the request is cancelled or replaced, and never evict other allocations.
+// Prefetched resources which are evicted anyway are reloaded within the same frame budget
+
+// Maximum number of bytes of RAM_G used by the prefetched resources of a request
+#ifndef ESD_PREFETCH_BUDGET
+#define ESD_PREFETCH_BUDGET (RAM_G_SIZE / 4)
+#endif
+
+// Maximum number of bytes loaded per frame, a single resource is always allowed
+#ifndef ESD_PREFETCH_FRAME_BUDGET
+#define ESD_PREFETCH_FRAME_BUDGET (64UL * 1024UL)
+#endif
+
+// Maximum number of items in a resource set, further items are ignored
+#ifndef ESD_PREFETCH_MAX
+#define ESD_PREFETCH_MAX 64
+#endif
+
+// Type of resource in a resource set
+#define ESD_PREFETCH_BITMAP 0 // Ft_Esd_BitmapInfo, including the palette
+#define ESD_PREFETCH_FONT 1 // Esd_FontInfo
+#define ESD_PREFETCH_RESOURCE 2 // Esd_ResourceInfo
+
+typedef struct
+{
+	ft_uint8_t Type;
+	void *Info;
+
+} Esd_PrefetchItem;
+
+// Set of resources used by a page, in order of priority
+typedef struct
+{
+	const Esd_PrefetchItem *Items;
+	ft_uint16_t NbItems;
+
+} Esd_ResourceSet;
+
+/// Request the resources of the next page to be loaded, replacing any previous request.
+/// The set must remain valid until the request is cancelled or replaced
+void Esd_Prefetch(const Esd_ResourceSet *set);
+
+/// Cancel the current request, the prefetched resources are no longer kept alive
+void Esd_Prefetch_Cancel();
+
+/// Check if all the resources of the current request which fit the budget have been loaded
+ft_bool_t Esd_Prefetch_Done();
+
+/// Load the next resources of the current request, called by Esd_Update during the idle phase
+void Esd_Prefetch_Idle();
+
+#endif /* #ifndef ESD_PREFETCH_H */
+
+/* end of file */
@@ -62,44 +62,44 @@ ft_void_t Esd_Render_Circle_Stroke(
 #if (EVE_MODEL >= EVE_FT810)
 	Esd_Dl_VERTEX_FORMAT(4);
 #endif
-	Eve_CoCmd_SendCmd(phost, SAVE_CONTEXT());
+	Eve_CoCmd_SendDl(phost, SAVE_CONTEXT());
 
 	// Outer reset
-	Eve_CoCmd_SendCmd(phost, COLOR_MASK(0, 0, 0, 1));
-	Eve_CoCmd_SendCmd(phost, STENCIL_FUNC(ALWAYS, 0, 1));
-	Eve_CoCmd_SendCmd(phost, STENCIL_OP(REPLACE, REPLACE));
-	Eve_CoCmd_SendCmd(phost, LINE_WIDTH(outerRadius));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(phost, COLOR_MASK(0, 0, 0, 1));
+	Eve_CoCmd_SendDl(phost, STENCIL_FUNC(ALWAYS, 0, 1));
+	Eve_CoCmd_SendDl(phost, STENCIL_OP(REPLACE, REPLACE));
+	Eve_CoCmd_SendDl(phost, LINE_WIDTH(outerRadius));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x, y));
 
 	// Inner alpha quantity
-	Eve_CoCmd_SendCmd(phost, COLOR_MASK(0, 0, 0, 1));
-	Eve_CoCmd_SendCmd(phost, BLEND_FUNC(ONE, ZERO));
-	Eve_CoCmd_SendCmd(phost, POINT_SIZE(innerRadius + 32));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(phost, COLOR_MASK(0, 0, 0, 1));
+	Eve_CoCmd_SendDl(phost, BLEND_FUNC(ONE, ZERO));
+	Eve_CoCmd_SendDl(phost, POINT_SIZE(innerRadius + 32));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x, y));
 
 	// Inner alpha edge mask
-	Eve_CoCmd_SendCmd(phost, STENCIL_FUNC(ALWAYS, 1, 1));
-	Eve_CoCmd_SendCmd(phost, STENCIL_OP(REPLACE, REPLACE));
-	Eve_CoCmd_SendCmd(phost, BLEND_FUNC(ZERO, ONE_MINUS_SRC_ALPHA));
-	Eve_CoCmd_SendCmd(phost, COLOR_A(255));
-	Eve_CoCmd_SendCmd(phost, POINT_SIZE(innerRadius));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(phost, STENCIL_FUNC(ALWAYS, 1, 1));
+	Eve_CoCmd_SendDl(phost, STENCIL_OP(REPLACE, REPLACE));
+	Eve_CoCmd_SendDl(phost, BLEND_FUNC(ZERO, ONE_MINUS_SRC_ALPHA));
+	Eve_CoCmd_SendDl(phost, COLOR_A(255));
+	Eve_CoCmd_SendDl(phost, POINT_SIZE(innerRadius));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x, y));
 
 	// Inner color, outer circle stencil mask
-	Eve_CoCmd_SendCmd(phost, COLOR_MASK(1, 1, 1, 1));
-	Eve_CoCmd_SendCmd(phost, BLEND_FUNC(DST_ALPHA, ONE_MINUS_DST_ALPHA));
-	// Eve_CoCmd_SendCmd(phost, POINT_SIZE(innerRadius));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(phost, COLOR_MASK(1, 1, 1, 1));
+	Eve_CoCmd_SendDl(phost, BLEND_FUNC(DST_ALPHA, ONE_MINUS_DST_ALPHA));
+	// Eve_CoCmd_SendDl(phost, POINT_SIZE(innerRadius));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x, y));
 
 	// Outer circle
-	Eve_CoCmd_SendCmd(phost, STENCIL_FUNC(NOTEQUAL, 1, 255));
-	Eve_CoCmd_SendCmd(phost, BLEND_FUNC(SRC_ALPHA, ONE_MINUS_SRC_ALPHA));
-	Eve_CoCmd_SendCmd(phost, COLOR_A(ESD_DECOMPOSE_ALPHA(color)));
-	Eve_CoCmd_SendCmd(phost, POINT_SIZE(outerRadius));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(phost, STENCIL_FUNC(NOTEQUAL, 1, 255));
+	Eve_CoCmd_SendDl(phost, BLEND_FUNC(SRC_ALPHA, ONE_MINUS_SRC_ALPHA));
+	Eve_CoCmd_SendDl(phost, COLOR_A(ESD_DECOMPOSE_ALPHA(color)));
+	Eve_CoCmd_SendDl(phost, POINT_SIZE(outerRadius));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x, y));
 
 	// Restore rendering context, ESD display list optimizations functions should be used again after this.
-	Eve_CoCmd_SendCmd(phost, RESTORE_CONTEXT());
+	Eve_CoCmd_SendDl(phost, RESTORE_CONTEXT());
 	Esd_Dl_END();
 }
 
@@ -27,6 +27,7 @@ ft_void_t Esd_Render_MultiGradient(ft_int16_t x, ft_int16_t y, ft_int16_t width,
 		// Allocate enough memory for 32 gradients.
 		// Two bytes * four pixels * 64 gradients, 32 per frame flip.
 		s_MultiGradient_GpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, 2 * 4 * ESD_MULTIGRADIENT_MAX_NB, GA_GC_FLAG);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, s_MultiGradient_GpuHandle, &s_MultiGradient_GpuHandle, "MultiGradient");
 		addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, s_MultiGradient_GpuHandle);
 	}
 	if (addr == GA_INVALID)
@@ -100,9 +101,9 @@ ft_void_t Esd_Render_MultiGradient(ft_int16_t x, ft_int16_t y, ft_int16_t width,
 #endif
 
 #if (EVE_MODEL >= EVE_FT810)
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(x, y));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2F(x, y));
 #else
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2II(x, y, ESD_CO_SCRATCH_HANDLE, 0));
+	Eve_CoCmd_SendDl(Ft_Esd_Host, VERTEX2II(x, y, ESD_CO_SCRATCH_HANDLE, 0));
 #endif
 
 	// Restore rendering context, ESD display list optimizations functions should be used again after this.
@@ -127,25 +128,25 @@ ft_void_t Esd_Render_MultiGradient_Rounded(ft_int16_t x, ft_int16_t y, ft_int16_
 	// Esd_Dl_CLEAR(1, 0, 0);
 	// Esd_Dl_Scissor_Reset(scissor);
 	Esd_Dl_COLOR_ARGB(ESD_ARGB_WHITE);
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, COLOR_MASK(0, 0, 0, 1));
+	Esd_Dl_COLOR_MASK(0, 0, 0, 1);
 	Esd_Dl_LINE_WIDTH(16);
 	Esd_Dl_BEGIN(RECTS);
 	Esd_Dl_VERTEX2F_0(x, y);
 	Esd_Dl_VERTEX2F_0(x + width, y + height);
 	Esd_Dl_END();
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, COLOR_MASK(1, 1, 1, 1));
+	Esd_Dl_COLOR_MASK(1, 1, 1, 1);
 
 	// Draw rounded rectangle as masking shape
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, BLEND_FUNC(ZERO, ONE_MINUS_SRC_ALPHA));
+	Esd_Dl_BLEND_FUNC(ZERO, ONE_MINUS_SRC_ALPHA);
 	Ft_Esd_Render_RectangleF(x << 4, y << 4, width << 4, height << 4, radius, Ft_Esd_ColorARGB_Combine(0xFFFFFF, alpha));
 
 	// Draw color using mask alpha
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, BLEND_FUNC(ONE_MINUS_DST_ALPHA, ONE));
+	Esd_Dl_BLEND_FUNC(ONE_MINUS_DST_ALPHA, ONE);
 	Esd_Render_MultiGradient(x, y, width, height, topLeft | 0xFF000000, topRight | 0xFF000000, bottomLeft | 0xFF000000, bottomRight | 0xFF000000);
 
 	// Restore context
 	// Esd_Dl_RESTORE_CONTEXT();
-	Eve_CoCmd_SendCmd(Ft_Esd_Host, BLEND_FUNC(SRC_ALPHA, ONE_MINUS_SRC_ALPHA));
+	Esd_Dl_BLEND_FUNC(SRC_ALPHA, ONE_MINUS_SRC_ALPHA);
 }
 
 /* end of file */
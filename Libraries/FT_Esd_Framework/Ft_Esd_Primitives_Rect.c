@@ -75,48 +75,48 @@ ft_void_t Esd_Render_Rect_Stroke(
 #if (EVE_MODEL >= EVE_FT810)
 	Esd_Dl_VERTEX_FORMAT(4);
 #endif
-	Eve_CoCmd_SendCmd(phost, SAVE_CONTEXT());
+	Eve_CoCmd_SendDl(phost, SAVE_CONTEXT());
 
 	// Outer reset
-	Eve_CoCmd_SendCmd(phost, COLOR_MASK(0, 0, 0, 1));
-	Eve_CoCmd_SendCmd(phost, STENCIL_FUNC(ALWAYS, 0, 1));
-	Eve_CoCmd_SendCmd(phost, STENCIL_OP(REPLACE, REPLACE));
-	Eve_CoCmd_SendCmd(phost, LINE_WIDTH(outerRadius));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x0, y0));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x1, y1));
+	Eve_CoCmd_SendDl(phost, COLOR_MASK(0, 0, 0, 1));
+	Eve_CoCmd_SendDl(phost, STENCIL_FUNC(ALWAYS, 0, 1));
+	Eve_CoCmd_SendDl(phost, STENCIL_OP(REPLACE, REPLACE));
+	Eve_CoCmd_SendDl(phost, LINE_WIDTH(outerRadius));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x0, y0));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x1, y1));
 
 	// Inner alpha quantity
-	Eve_CoCmd_SendCmd(phost, BLEND_FUNC(ONE, ZERO));
-	Eve_CoCmd_SendCmd(phost, LINE_WIDTH(innerRadius + 32));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x0, y0));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x1, y1));
+	Eve_CoCmd_SendDl(phost, BLEND_FUNC(ONE, ZERO));
+	Eve_CoCmd_SendDl(phost, LINE_WIDTH(innerRadius + 32));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x0, y0));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x1, y1));
 
 	// Inner alpha edge mask
-	Eve_CoCmd_SendCmd(phost, STENCIL_FUNC(ALWAYS, 1, 1));
-	Eve_CoCmd_SendCmd(phost, STENCIL_OP(REPLACE, REPLACE));
-	Eve_CoCmd_SendCmd(phost, BLEND_FUNC(ZERO, ONE_MINUS_SRC_ALPHA));
-	Eve_CoCmd_SendCmd(phost, COLOR_A(255));
-	Eve_CoCmd_SendCmd(phost, LINE_WIDTH(innerRadius));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x0, y0));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x1, y1));
+	Eve_CoCmd_SendDl(phost, STENCIL_FUNC(ALWAYS, 1, 1));
+	Eve_CoCmd_SendDl(phost, STENCIL_OP(REPLACE, REPLACE));
+	Eve_CoCmd_SendDl(phost, BLEND_FUNC(ZERO, ONE_MINUS_SRC_ALPHA));
+	Eve_CoCmd_SendDl(phost, COLOR_A(255));
+	Eve_CoCmd_SendDl(phost, LINE_WIDTH(innerRadius));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x0, y0));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x1, y1));
 
 	// Inner color, outer rect stencil mask
-	Eve_CoCmd_SendCmd(phost, COLOR_MASK(1, 1, 1, 1));
-	Eve_CoCmd_SendCmd(phost, BLEND_FUNC(DST_ALPHA, ONE_MINUS_DST_ALPHA));
-	// Eve_CoCmd_SendCmd(phost, LINE_WIDTH(innerRadius));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x0, y0));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x1, y1));
+	Eve_CoCmd_SendDl(phost, COLOR_MASK(1, 1, 1, 1));
+	Eve_CoCmd_SendDl(phost, BLEND_FUNC(DST_ALPHA, ONE_MINUS_DST_ALPHA));
+	// Eve_CoCmd_SendDl(phost, LINE_WIDTH(innerRadius));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x0, y0));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x1, y1));
 
 	// Outer rect
-	Eve_CoCmd_SendCmd(phost, STENCIL_FUNC(NOTEQUAL, 1, 255));
-	Eve_CoCmd_SendCmd(phost, BLEND_FUNC(SRC_ALPHA, ONE_MINUS_SRC_ALPHA));
-	Eve_CoCmd_SendCmd(phost, COLOR_A(ESD_DECOMPOSE_ALPHA(color)));
-	Eve_CoCmd_SendCmd(phost, LINE_WIDTH(outerRadius));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x0, y0));
-	Eve_CoCmd_SendCmd(phost, VERTEX2F(x1, y1));
+	Eve_CoCmd_SendDl(phost, STENCIL_FUNC(NOTEQUAL, 1, 255));
+	Eve_CoCmd_SendDl(phost, BLEND_FUNC(SRC_ALPHA, ONE_MINUS_SRC_ALPHA));
+	Eve_CoCmd_SendDl(phost, COLOR_A(ESD_DECOMPOSE_ALPHA(color)));
+	Eve_CoCmd_SendDl(phost, LINE_WIDTH(outerRadius));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x0, y0));
+	Eve_CoCmd_SendDl(phost, VERTEX2F(x1, y1));
 
 	// Restore rendering context, ESD display list optimizations functions should be used again after this.
-	Eve_CoCmd_SendCmd(phost, RESTORE_CONTEXT());
+	Eve_CoCmd_SendDl(phost, RESTORE_CONTEXT());
 	Esd_Dl_END();
 }
 
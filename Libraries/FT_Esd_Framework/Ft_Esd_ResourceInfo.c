@@ -8,6 +8,7 @@ Author: Jan Boon <jan.boon@kaetemi.be>
 #include "FT_LoadFile.h"
 
 #include "Ft_Esd_CoCmd.h"
+#include "Ft_Esd_Loader.h"
 #ifndef NDEBUG
 #define ESD_RESOURCEINFO_DEBUG
 #endif
@@ -84,10 +85,23 @@ uint32_t Esd_LoadResource(Esd_ResourceInfo *resourceInfo, ft_uint32_t *imageForm
 		break;
 	}
 
+	// The contents may still be in RAM_G from before the allocator was reset,
+	// except the image format, which is only known after loading
+	if (!imageFormat)
+	{
+		addr = Ft_Esd_GpuAlloc_Adopt(Ft_Esd_GAlloc, &resourceInfo->GpuHandle,
+		    (resourceInfo->Persistent ? 0 : GA_GC_FLAG)
+		        | ((!resourceInfo->Compressed && ESD_RESOURCE_IS_FLASH(resourceInfo->Type)) ? GA_LOW_FLAG : 0));
+		if (addr != GA_INVALID)
+			return ESD_DL_RAM_G_ADDRESS(addr);
+	}
+
 	// Allocate gpu memory
 	resourceInfo->GpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, resourceInfo->RawSize,
 	    (resourceInfo->Persistent ? 0 : GA_GC_FLAG)
 	        | ((!resourceInfo->Compressed && ESD_RESOURCE_IS_FLASH(resourceInfo->Type)) ? GA_LOW_FLAG : 0));
+	Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, resourceInfo->GpuHandle, resourceInfo,
+	    (resourceInfo->Type == ESD_RESOURCE_FILE) ? resourceInfo->File : "<resource>");
 	addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, resourceInfo->GpuHandle);
 	if (addr == GA_INVALID)
 	{
@@ -162,6 +176,8 @@ uint32_t Esd_LoadResource(Esd_ResourceInfo *resourceInfo, ft_uint32_t *imageForm
 	// Return address if we found it
 	if (addr != GA_INVALID)
 	{
+		if (!imageFormat)
+			Ft_Esd_GpuAlloc_Seal(Ft_Esd_GAlloc, &resourceInfo->GpuHandle);
 		return ESD_DL_RAM_G_ADDRESS(addr);
 	}
 
@@ -182,6 +198,29 @@ uint32_t Esd_LoadResource(Esd_ResourceInfo *resourceInfo, ft_uint32_t *imageForm
 	return GA_INVALID;
 }
 
+uint32_t Esd_LoadResourceAsync(Esd_ResourceInfo *resourceInfo)
+{
+#if ESD_LOADER_ASYNC
+	if (resourceInfo && resourceInfo->Type == ESD_RESOURCE_FILE && resourceInfo->File
+	    && resourceInfo->Compressed != ESD_RESOURCE_IMAGE)
+	{
+		ft_uint32_t addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, resourceInfo->GpuHandle);
+		if (addr != GA_INVALID)
+			return ESD_DL_RAM_G_ADDRESS(addr);
+		addr = Ft_Esd_GpuAlloc_Adopt(Ft_Esd_GAlloc, &resourceInfo->GpuHandle, resourceInfo->Persistent ? 0 : GA_GC_FLAG);
+		if (addr != GA_INVALID)
+			return ESD_DL_RAM_G_ADDRESS(addr);
+
+		// Not loaded, queue this resource to be loaded in the background
+		if (Esd_Loader_Request(&resourceInfo->GpuHandle, resourceInfo->File, resourceInfo->Compressed == ESD_RESOURCE_DEFLATE,
+		        resourceInfo->RawSize, resourceInfo->Persistent ? 0 : GA_GC_FLAG, resourceInfo))
+			return GA_INVALID;
+	}
+#endif
+
+	return Esd_LoadResource(resourceInfo, NULL);
+}
+
 void Esd_FreeResource(Esd_ResourceInfo *resourceInfo)
 {
 	if (!resourceInfo)
@@ -191,6 +230,26 @@ void Esd_FreeResource(Esd_ResourceInfo *resourceInfo)
 	resourceInfo->GpuHandle.Id = MAX_NUM_ALLOCATIONS;
 }
 
+ft_bool_t Esd_BenchmarkLoad()
+{
+#if !defined(FT9XX_PLATFORM)
+	Ft_Esd_GpuHandle handle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, ESD_BENCHMARK_LOAD_SIZE, 0);
+	ft_uint32_t addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, handle);
+	ft_bool_t res;
+
+	if (addr == GA_INVALID)
+	{
+		esd_resourceinfo_printf("Unable to allocate space for load benchmark\n");
+		return FT_FALSE;
+	}
+	res = EVE_Util_benchmarkPack(Ft_Esd_Host, addr, ESD_BENCHMARK_LOAD_SIZE);
+	Ft_Esd_GpuAlloc_Free(Ft_Esd_GAlloc, handle);
+	return res;
+#else
+	return FT_FALSE;
+#endif
+}
+
 void Esd_ResourcePersist(Esd_ResourceInfo *resourceInfo)
 {
 	Esd_LoadResource(resourceInfo, false);
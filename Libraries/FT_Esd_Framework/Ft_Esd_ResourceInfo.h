@@ -85,19 +85,42 @@ ESD_TYPE(Esd_ResourceInfo *, Native = Pointer, Edit = Library)
 /// Returns the output image format if the resource is an image loaded through the coprocessor
 uint32_t Esd_LoadResource(Esd_ResourceInfo *resourceInfo, ft_uint32_t *imageFormat);
 
+/// Load resource data into RAM_G in the background. Returns GA_INVALID until the resource is loaded.
+/// Resources which cannot be loaded in the background are loaded immediately
+uint32_t Esd_LoadResourceAsync(Esd_ResourceInfo *resourceInfo);
+
 /// Free a currently loaded resource from RAM_G. Can be used to enforce reloading a resource.
 void Esd_FreeResource(Esd_ResourceInfo *resourceInfo);
 
+// Amount of RAM_G used while measuring the load throughput
+#ifndef ESD_BENCHMARK_LOAD_SIZE
+#define ESD_BENCHMARK_LOAD_SIZE (64UL * 1024UL)
+#endif
+
+/// Measure how fast raw and deflated data loads on this target, using the files in the open asset pack.
+/// Files which the pack stores both raw and deflated are then loaded in the fastest form
+ESD_FUNCTION(Esd_BenchmarkLoad, Type = ft_bool_t, DisplayName = "Benchmark Load", Category = EsdUtilities)
+ft_bool_t Esd_BenchmarkLoad();
+
 /// A function to make fonts persistent in memory by reloading the data if necessary, called during the Update cycle of each frame
 ESD_UPDATE(Esd_ResourcePersist, DisplayName = "Persist Resource", Category = EsdUtilities)
 ESD_PARAMETER(resourceInfo, Type = Esd_ResourceInfo *)
 void Esd_ResourcePersist(Esd_ResourceInfo *resourceInfo);
 
-// Number of available bitmap handles
+// Number of bitmap handles supported by the hardware. On FT810 and up, the ROM font handles 16 to 31 can be re-mapped
 #if (EVE_MODEL >= EVE_FT810)
-#define FT_ESD_BITMAPHANDLE_NB 32UL
+#define FT_ESD_BITMAPHANDLE_HW_NB 32UL
 #else
-#define FT_ESD_BITMAPHANDLE_NB 16UL
+#define FT_ESD_BITMAPHANDLE_HW_NB 16UL
+#endif
+
+// Number of available bitmap handles, including the scratch handle. Handles above this number are left to the application
+#ifndef FT_ESD_BITMAPHANDLE_NB
+#define FT_ESD_BITMAPHANDLE_NB FT_ESD_BITMAPHANDLE_HW_NB
+#endif
+
+#if (FT_ESD_BITMAPHANDLE_NB > FT_ESD_BITMAPHANDLE_HW_NB) || (FT_ESD_BITMAPHANDLE_NB < 16)
+#error FT_ESD_BITMAPHANDLE_NB must include the scratch handle 15 and may not exceed the hardware limit
 #endif
 
 // An invalid bitmap handle
@@ -0,0 +1,170 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#include "Ft_Esd_SpatialIndex.h"
+#include "FT_Esd_Dl.h"
+
+#if ESD_SPATIAL_INDEX
+
+static ft_bool_t isVisible(Ft_Esd_Widget *child)
+{
+	return child->Active && child->GlobalValid && Ft_Esd_Rect16_Intersects(child->GlobalRect, Ft_Esd_ScissorRect);
+}
+
+void Esd_SpatialIndex_Build(Esd_SpatialIndex *index, Ft_Esd_Widget *layout, ft_bool_t vertical)
+{
+	const ft_int32_t origin = vertical ? layout->GlobalY : layout->GlobalX;
+	ft_uint32_t count = 0;
+	Ft_Esd_Widget *child;
+
+	index->Valid = FT_FALSE;
+	index->Count = 0;
+	index->Vertical = vertical;
+
+	for (child = layout->First; child; child = child->Next)
+	{
+		if (child->Active)
+			++count;
+	}
+	if (count < ESD_SPATIAL_INDEX_MIN || count > ESD_SPATIAL_INDEX_SIZE)
+		return;
+
+	for (child = layout->First; child; child = child->Next)
+	{
+		Esd_SpatialEntry *entry;
+		ft_int32_t start, end;
+
+		if (!child->Active)
+			continue;
+
+		start = (vertical ? child->GlobalY : child->GlobalX) - origin;
+		end = start + (vertical ? child->GlobalHeight : child->GlobalWidth);
+		if (index->Count)
+		{
+			// Children which are not in drawing order along the axis cannot be found by a binary search
+			if (start < index->Entries[index->Count - 1].Start)
+				return;
+			if (end < index->Entries[index->Count - 1].End)
+				end = index->Entries[index->Count - 1].End;
+		}
+
+		entry = &index->Entries[index->Count++];
+		entry->Widget = child;
+		entry->Start = (ft_int16_t)start;
+		entry->End = (ft_int16_t)end;
+	}
+
+	index->Valid = FT_TRUE;
+}
+
+void Esd_SpatialIndex_Release(Esd_SpatialIndex *index)
+{
+	index->Count = 0;
+	index->Valid = FT_FALSE;
+}
+
+// Find the first child which ends after the position, the end of all preceding children is before it
+static ft_uint16_t findFirst(Esd_SpatialIndex *index, ft_int32_t position)
+{
+	ft_uint16_t low = 0;
+	ft_uint16_t high = index->Count;
+	while (low < high)
+	{
+		ft_uint16_t mid = (low + high) >> 1;
+		if (index->Entries[mid].End <= position)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return low;
+}
+
+// The layout positions its children again before the next render, until then the index may be out of date
+static ft_bool_t isValid(Esd_SpatialIndex *index, Ft_Esd_Widget *layout)
+{
+	return index->Valid && !layout->Recalculate;
+}
+
+// Continue through the linked list, the same as Ft_Esd_Widget_IterateChildVisibleSlot
+static void iterateList(Ft_Esd_Widget *child, int slot)
+{
+	while (child)
+	{
+		Ft_Esd_Widget *const next = child->Next;
+		if (isVisible(child))
+			child->Slots->Table[slot](child);
+		child = child->Parent ? child->Next : next;
+	}
+}
+
+void Esd_SpatialIndex_IterateVisibleSlot(Esd_SpatialIndex *index, Ft_Esd_Widget *layout, int slot)
+{
+	ft_int32_t origin, low, high;
+	ft_uint16_t i;
+
+	if (!isValid(index, layout))
+	{
+		Ft_Esd_Widget_IterateChildVisibleSlot(layout, slot);
+		return;
+	}
+
+	origin = index->Vertical ? layout->GlobalY : layout->GlobalX;
+	low = (index->Vertical ? Ft_Esd_ScissorRect.Y : Ft_Esd_ScissorRect.X) - origin;
+	high = low + (index->Vertical ? Ft_Esd_ScissorRect.Height : Ft_Esd_ScissorRect.Width);
+
+	for (i = findFirst(index, low); i < index->Count && index->Entries[i].Start < high; ++i)
+	{
+		Ft_Esd_Widget *const child = index->Entries[i].Widget;
+		if (isVisible(child))
+		{
+			Ft_Esd_Widget *const next = child->Next;
+			child->Slots->Table[slot](child);
+			if (layout->Recalculate)
+			{
+				// The children changed, the remaining children are found through the list
+				iterateList(child->Parent ? child->Next : next, slot);
+				return;
+			}
+		}
+	}
+}
+
+#endif
+
+Ft_Esd_Widget *Esd_SpatialIndex_ChildAt(Esd_SpatialIndex *index, Ft_Esd_Widget *layout, ft_int16_t x, ft_int16_t y)
+{
+	Ft_Esd_Rect16 point = { .X = x, .Y = y, .Width = 1, .Height = 1 };
+	Ft_Esd_Widget *found = NULL;
+	Ft_Esd_Widget *child;
+
+#if ESD_SPATIAL_INDEX
+	if (isValid(index, layout))
+	{
+		ft_int32_t position = index->Vertical ? (y - layout->GlobalY) : (x - layout->GlobalX);
+		ft_uint16_t i;
+
+		// Children are drawn in order, so the last one containing the position is on top
+		for (i = findFirst(index, position); i < index->Count && index->Entries[i].Start <= position; ++i)
+		{
+			child = index->Entries[i].Widget;
+			if (child->Active && child->GlobalValid && Ft_Esd_Rect16_Intersects(child->GlobalRect, point))
+				found = child;
+		}
+		return found;
+	}
+#else
+	(void)index;
+#endif
+
+	for (child = layout->First; child; child = child->Next)
+	{
+		if (child->Active && child->GlobalValid && Ft_Esd_Rect16_Intersects(child->GlobalRect, point))
+			found = child;
+	}
+	return found;
+}
+
+/* end of file */
@@ -0,0 +1,79 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#ifndef ESD_SPATIALINDEX_H
+#define ESD_SPATIALINDEX_H
+
+#include "Ft_Esd_Widget.h"
+
+// Keep the children of a layout as a list of intervals along one axis, so the children which intersect
+// the scissor rectangle or a position are found with a binary search instead of testing every child.
+// The intervals are relative to the layout, and remain valid while the layout is scrolled.
+// Only used when the children follow each other along the axis in the same order as they are drawn,
+// which is always the case for the linear layout. Otherwise all children are tested as before.
+// The scroll layout rarely benefits: its children are usually all placed at the same origin, and it needs
+// at least ESD_SPATIAL_INDEX_MIN children, typically when a list of items is placed directly in it.
+// Disabled by default, every layout then holds ESD_SPATIAL_INDEX_SIZE entries
+#ifndef ESD_SPATIAL_INDEX
+#define ESD_SPATIAL_INDEX 0
+#endif
+
+// Minimum number of children for building an index, testing a few children is faster than building it
+#ifndef ESD_SPATIAL_INDEX_MIN
+#define ESD_SPATIAL_INDEX_MIN 16
+#endif
+
+// Maximum number of children in an index, layouts with more active children test every child
+#ifndef ESD_SPATIAL_INDEX_SIZE
+#define ESD_SPATIAL_INDEX_SIZE 128
+#endif
+
+typedef struct
+{
+	Ft_Esd_Widget *Widget;
+	ft_int16_t Start; // Start of the child along the axis, relative to the layout
+	ft_int16_t End; // Largest end along the axis of this child and all preceding children
+
+} Esd_SpatialEntry;
+
+typedef struct
+{
+#if ESD_SPATIAL_INDEX
+	Esd_SpatialEntry Entries[ESD_SPATIAL_INDEX_SIZE];
+	ft_uint16_t Count;
+	ft_bool_t Vertical;
+#endif
+	ft_bool_t Valid;
+
+} Esd_SpatialIndex;
+
+#if ESD_SPATIAL_INDEX
+
+/// Index the active children of a layout along one axis, after the layout positioned them
+void Esd_SpatialIndex_Build(Esd_SpatialIndex *index, Ft_Esd_Widget *layout, ft_bool_t vertical);
+
+/// Clear the index, the children are tested one by one until it is built again
+void Esd_SpatialIndex_Release(Esd_SpatialIndex *index);
+
+/// Call the slot on the active children of the layout which are within the current scissor rectangle.
+/// Equivalent to Ft_Esd_Widget_IterateChildVisibleSlot, which is used when the index is not valid
+void Esd_SpatialIndex_IterateVisibleSlot(Esd_SpatialIndex *index, Ft_Esd_Widget *layout, int slot);
+
+#else
+
+#define Esd_SpatialIndex_Build(index, layout, vertical) eve_noop()
+#define Esd_SpatialIndex_Release(index) eve_noop()
+#define Esd_SpatialIndex_IterateVisibleSlot(index, layout, slot) Ft_Esd_Widget_IterateChildVisibleSlot(layout, slot)
+
+#endif
+
+/// Find the topmost active child of the layout which contains the position, for touch lookup.
+/// Returns NULL if there is none
+Ft_Esd_Widget *Esd_SpatialIndex_ChildAt(Esd_SpatialIndex *index, Ft_Esd_Widget *layout, ft_int16_t x, ft_int16_t y);
+
+#endif /* #ifndef ESD_SPATIALINDEX_H */
+
+/* end of file */
@@ -3,6 +3,7 @@
 #include "FT_Gpu_Hal.h"
 
 #include "Ft_Esd_Core.h"
+#include "FT_Esd_Dl.h"
 
 extern void Ft_Esd_Noop(void *context);
 
@@ -227,14 +228,16 @@ ft_uint8_t Ft_Esd_TouchTag_CurrentTag(Ft_Esd_TouchTag *context)
 	return s_GpuRegTouchTag;
 }
 
+// The touch position is mapped into the coordinates of the widget being processed when it is requested,
+// so widgets inside a scroll layout which translates its content can compare it with their global rectangle
 ft_int16_t Ft_Esd_TouchTag_TouchX(Ft_Esd_TouchTag *context)
 {
-	return s_TouchPos.X;
+	return s_TouchPos.X - Ft_Esd_TranslateX;
 }
 
 ft_int16_t Ft_Esd_TouchTag_TouchY(Ft_Esd_TouchTag *context)
 {
-	return s_TouchPos.Y;
+	return s_TouchPos.Y - Ft_Esd_TranslateY;
 }
 
 ft_int16_t Ft_Esd_TouchTag_TouchXDelta(Ft_Esd_TouchTag *context)
@@ -73,11 +73,11 @@ ft_uint8_t Ft_Esd_TouchTag_Tag(Ft_Esd_TouchTag *context);
 ESD_OUTPUT(CurrentTag, DisplayName = "Current Tag", Type = ft_uint8_t)
 ft_uint8_t Ft_Esd_TouchTag_CurrentTag(Ft_Esd_TouchTag *context);
 
-// Last touch X position, stays the same after touch has ended, context may be NULL
+// Last touch X position in the coordinates of the current widget, stays the same after touch has ended, context may be NULL
 ESD_OUTPUT(TouchX, DisplayName = "Touch X", Type = ft_int16_t)
 ft_int16_t Ft_Esd_TouchTag_TouchX(Ft_Esd_TouchTag *context);
 
-// Last touch Y position, context may be NULL
+// Last touch Y position in the coordinates of the current widget, context may be NULL
 ESD_OUTPUT(TouchY, DisplayName = "Touch Y", Type = ft_int16_t)
 ft_int16_t Ft_Esd_TouchTag_TouchY(Ft_Esd_TouchTag *context);
 
@@ -2,6 +2,7 @@
 
 #include "Ft_Esd_Widget.h"
 #include "FT_Esd_Dl.h"
+#include "Ft_Esd_WidgetTree.h"
 
 static Ft_Esd_WidgetSlots s_Ft_Esd_Widget__Slots = {
 	(void (*)(void *))Ft_Esd_Widget_Initialize,
@@ -16,98 +17,121 @@ static Ft_Esd_WidgetSlots s_Ft_Esd_Widget__Slots = {
 
 static Ft_Esd_Widget *s_Ft_Esd_Widget_FreeQueue = 0;
 
-void Ft_Esd_Widget_IterateChildSlot(Ft_Esd_Widget *context, int slot)
+Esd_LayoutStats Ft_Esd_LayoutStats;
+Esd_LayoutStats Ft_Esd_LastLayoutStats;
+
+#define ESD_ITERATE_ALL 0
+#define ESD_ITERATE_ACTIVE 1
+#define ESD_ITERATE_VALID 2
+#define ESD_ITERATE_VISIBLE 3
+
+static ft_bool_t iterateFilter(Ft_Esd_Widget *child, int filter)
 {
-	Ft_Esd_Widget *child = context->First;
-	while (child)
+	switch (filter)
 	{
-		Ft_Esd_Widget *const next = child->Next;
-		child->Slots->Table[slot](child);
-		child = child->Parent ? child->Next : next;
+	case ESD_ITERATE_ACTIVE:
+		return child->Active;
+	case ESD_ITERATE_VALID:
+		return child->Active && child->GlobalValid;
+	case ESD_ITERATE_VISIBLE:
+		return child->Active && child->GlobalValid && Ft_Esd_Rect16_Intersects(child->GlobalRect, Ft_Esd_ScissorRect);
 	}
+	return FT_TRUE;
 }
 
-void Ft_Esd_Widget_IterateChildSlotReverse(Ft_Esd_Widget *context, int slot)
+static void iterateList(Ft_Esd_Widget *child, int slot, int filter, ft_bool_t reverse)
 {
-	Ft_Esd_Widget *child = context->Last;
 	while (child)
 	{
-		Ft_Esd_Widget *const previous = child->Previous;
-		child->Slots->Table[slot](child);
-		child = child->Parent ? child->Previous : previous;
+		Ft_Esd_Widget *const next = reverse ? child->Previous : child->Next;
+		if (iterateFilter(child, filter))
+			child->Slots->Table[slot](child);
+		child = child->Parent ? (reverse ? child->Previous : child->Next) : next;
 	}
 }
 
-void Ft_Esd_Widget_IterateChildActiveSlot(Ft_Esd_Widget *context, int slot)
+#if ESD_WIDGET_TREE
+// Find the children in the flattened tree, the slot functions may change the tree,
+// in which case the remaining children are found through the linked list
+static void iterateTree(Esd_WidgetTree *tree, ft_uint16_t index, int slot, int filter, ft_bool_t reverse)
 {
-	Ft_Esd_Widget *child = context->First;
-	while (child)
+	ft_uint32_t version = tree->Version;
+	ft_uint16_t end = index + 1 + tree->Records[index].Skip;
+	ft_uint16_t i = reverse ? tree->Records[index].Last : index + 1;
+
+	while (reverse ? (i != ESD_WIDGET_TREE_NONE) : (i < end))
 	{
-		Ft_Esd_Widget *const next = child->Next;
-		if (child->Active)
+		Ft_Esd_Widget *const child = tree->Records[i].Widget;
+		const ft_uint16_t following = reverse ? tree->Records[i].Previous : (i + 1 + tree->Records[i].Skip);
+
+		// The Active flag is available without touching the widget
+		if (filter == ESD_ITERATE_ALL || (tree->Flags[i] && iterateFilter(child, filter)))
+		{
+			Ft_Esd_Widget *const next = reverse ? child->Previous : child->Next;
 			child->Slots->Table[slot](child);
-		child = child->Parent ? child->Next : next;
+			if (tree->Dirty || tree->Version != version)
+			{
+				iterateList(child->Parent ? (reverse ? child->Previous : child->Next) : next, slot, filter, reverse);
+				return;
+			}
+		}
+		i = following;
 	}
 }
+#endif
 
-void Ft_Esd_Widget_IterateChildActiveSlotReverse(Ft_Esd_Widget *context, int slot)
+static void iterateChildren(Ft_Esd_Widget *context, int slot, int filter, ft_bool_t reverse)
 {
-	Ft_Esd_Widget *child = context->Last;
-	while (child)
+#if ESD_WIDGET_TREE
+	ft_uint16_t index;
+	Esd_WidgetTree *tree = Esd_WidgetTree_Find(context, &index);
+	if (tree)
 	{
-		Ft_Esd_Widget *const previous = child->Previous;
-		if (child->Active)
-			child->Slots->Table[slot](child);
-		child = child->Parent ? child->Previous : previous;
+		iterateTree(tree, index, slot, filter, reverse);
+		return;
 	}
+#endif
+	iterateList(reverse ? context->Last : context->First, slot, filter, reverse);
+}
+
+void Ft_Esd_Widget_IterateChildSlot(Ft_Esd_Widget *context, int slot)
+{
+	iterateChildren(context, slot, ESD_ITERATE_ALL, FT_FALSE);
+}
+
+void Ft_Esd_Widget_IterateChildSlotReverse(Ft_Esd_Widget *context, int slot)
+{
+	iterateChildren(context, slot, ESD_ITERATE_ALL, FT_TRUE);
+}
+
+void Ft_Esd_Widget_IterateChildActiveSlot(Ft_Esd_Widget *context, int slot)
+{
+	iterateChildren(context, slot, ESD_ITERATE_ACTIVE, FT_FALSE);
+}
+
+void Ft_Esd_Widget_IterateChildActiveSlotReverse(Ft_Esd_Widget *context, int slot)
+{
+	iterateChildren(context, slot, ESD_ITERATE_ACTIVE, FT_TRUE);
 }
 
 void Ft_Esd_Widget_IterateChildActiveValidSlot(Ft_Esd_Widget *context, int slot)
 {
-	Ft_Esd_Widget *child = context->First;
-	while (child)
-	{
-		Ft_Esd_Widget *const next = child->Next;
-		if (child->Active && child->GlobalValid)
-			child->Slots->Table[slot](child);
-		child = child->Parent ? child->Next : next;
-	}
+	iterateChildren(context, slot, ESD_ITERATE_VALID, FT_FALSE);
 }
 
 void Ft_Esd_Widget_IterateChildActiveValidSlotReverse(Ft_Esd_Widget *context, int slot)
 {
-	Ft_Esd_Widget *child = context->Last;
-	while (child)
-	{
-		Ft_Esd_Widget *const previous = child->Previous;
-		if (child->Active && child->GlobalValid)
-			child->Slots->Table[slot](child);
-		child = child->Parent ? child->Previous : previous;
-	}
+	iterateChildren(context, slot, ESD_ITERATE_VALID, FT_TRUE);
 }
 
 void Ft_Esd_Widget_IterateChildVisibleSlot(Ft_Esd_Widget *context, int slot)
 {
-	Ft_Esd_Widget *child = context->First;
-	while (child)
-	{
-		Ft_Esd_Widget *const next = child->Next;
-		if (child->Active && child->GlobalValid && Ft_Esd_Rect16_Intersects(child->GlobalRect, Ft_Esd_ScissorRect))
-			child->Slots->Table[slot](child);
-		child = child->Parent ? child->Next : next;
-	}
+	iterateChildren(context, slot, ESD_ITERATE_VISIBLE, FT_FALSE);
 }
 
 void Ft_Esd_Widget_IterateChildVisibleSlotReverse(Ft_Esd_Widget *context, int slot)
 {
-	Ft_Esd_Widget *child = context->Last;
-	while (child)
-	{
-		Ft_Esd_Widget *const previous = child->Previous;
-		if (child->Active && child->GlobalValid && Ft_Esd_Rect16_Intersects(child->GlobalRect, Ft_Esd_ScissorRect))
-			child->Slots->Table[slot](child);
-		child = child->Parent ? child->Previous : previous;
-	}
+	iterateChildren(context, slot, ESD_ITERATE_VISIBLE, FT_TRUE);
 }
 
 void Ft_Esd_Widget__Initializer(Ft_Esd_Widget *context)
@@ -137,12 +161,12 @@ void Ft_Esd_Widget_Update(struct Ft_Esd_Widget *context)
 {
 	if (context->Recalculate)
 	{
-		context->Recalculate = 0;
 		Ft_Esd_Widget *child = context->First;
+		++Ft_Esd_LayoutStats.Recalculated;
 		while (child)
 		{
 			Ft_Esd_Widget *const next = child->Next;
-			if (child->Active)
+			if (child->Active && Ft_Esd_Widget_NeedsLayout(context, child))
 			{
 				Ft_Esd_Widget_SetGlobalRect(child,
 				    context->GlobalX,
@@ -152,6 +176,8 @@ void Ft_Esd_Widget_Update(struct Ft_Esd_Widget *context)
 			}
 			child = next;
 		}
+		context->Recalculate = 0;
+		context->RecalculateLocal = 0;
 	}
 	Ft_Esd_Widget_IterateChildActiveSlotReverse(context, FT_ESD_WIDGET_UPDATE);
 }
@@ -185,17 +211,27 @@ void Ft_Esd_Widget_End(struct Ft_Esd_Widget *context)
 		}
 		child = next;
 	}
+	if (context->Root)
+		Esd_WidgetTree_Release(context);
 }
 
 void Ft_Esd_Widget_PostLocalRect(Ft_Esd_Widget *context)
 {
-	if (context->Parent)
-		context->Parent->Recalculate = 1;
+	Ft_Esd_Widget *const parent = context->Parent;
+	context->LocalChanged = 1;
+	if (parent)
+	{
+		// Anything else requesting recalculation requires all children to be positioned
+		if (!parent->Recalculate)
+			parent->RecalculateLocal = 1;
+		parent->Recalculate = 1;
+	}
 }
 
 void Ft_Esd_Widget_PostGlobalRect(Ft_Esd_Widget *context)
 {
 	context->Recalculate = 1;
+	context->RecalculateLocal = 0;
 }
 
 void Ft_Esd_Widget_Detach_Internal(Ft_Esd_Widget *context)
@@ -216,6 +252,8 @@ void Ft_Esd_Widget_Detach_Internal(Ft_Esd_Widget *context)
 	context->Next = 0;
 	context->GlobalValid = FT_FALSE;
 	parent->Recalculate = FT_TRUE;
+	Esd_WidgetTree_Invalidate(parent);
+	Ft_Esd_Widget_UpdateActive(context);
 }
 
 void Ft_Esd_Widget_Detach(Ft_Esd_Widget *context)
@@ -249,6 +287,8 @@ void Ft_Esd_Widget_LocalInsertTop(Ft_Esd_Widget *context, Ft_Esd_Widget *parent)
 	if (!parent->Last)
 		parent->Last = context;
 	parent->Recalculate = 1;
+	Esd_WidgetTree_Invalidate(parent);
+	Ft_Esd_Widget_UpdateActive(context);
 	if (!activeBefore && Ft_Esd_Widget_GetActive(context))
 		context->Slots->Enable(context);
 }
@@ -276,6 +316,8 @@ void Ft_Esd_Widget_LocalInsertBottom(Ft_Esd_Widget *context, Ft_Esd_Widget *pare
 	if (!parent->First)
 		parent->First = context;
 	parent->Recalculate = 1;
+	Esd_WidgetTree_Invalidate(parent);
+	Ft_Esd_Widget_UpdateActive(context);
 	if (!activeBefore && Ft_Esd_Widget_GetActive(context))
 		context->Slots->Enable(context);
 }
@@ -304,6 +346,8 @@ void Ft_Esd_Widget_SetActive(Ft_Esd_Widget *context, ft_bool_t active)
 	{
 		ft_bool_t activeBefore = Ft_Esd_Widget_GetActive(context);
 		context->Active = active;
+		Esd_WidgetTree_SetActive(context);
+		Ft_Esd_Widget_UpdateActive(context);
 		ft_bool_t activeAfter = Ft_Esd_Widget_GetActive(context);
 		if (activeBefore != activeAfter)
 		{
@@ -318,7 +362,8 @@ void Ft_Esd_Widget_SetActive(Ft_Esd_Widget *context, ft_bool_t active)
 	}
 }
 
-ft_bool_t Ft_Esd_Widget_GetActive(Ft_Esd_Widget *context)
+#if defined(_DEBUG)
+static ft_bool_t getActiveSlow(Ft_Esd_Widget *context)
 {
 	Ft_Esd_Widget *widget = context;
 	while (widget->Parent)
@@ -329,6 +374,26 @@ ft_bool_t Ft_Esd_Widget_GetActive(Ft_Esd_Widget *context)
 	}
 	return widget->Root && widget->Active;
 }
+#endif
+
+ft_bool_t Ft_Esd_Widget_GetActive(Ft_Esd_Widget *context)
+{
+	eve_assert_ex(context->ActiveEffective == getActiveSlow(context), "Cached active state out of date, call Ft_Esd_Widget_UpdateActive after changing Active or Root directly");
+	return context->ActiveEffective;
+}
+
+void Ft_Esd_Widget_UpdateActive(Ft_Esd_Widget *context)
+{
+	Ft_Esd_Widget *const parent = context->Parent;
+	ft_bool_t active = context->Active && (parent ? parent->ActiveEffective : context->Root);
+	if (context->ActiveEffective == active)
+		return;
+
+	// The children only depend on this widget, so they are only visited when it changes
+	context->ActiveEffective = active;
+	for (Ft_Esd_Widget *child = context->First; child; child = child->Next)
+		Ft_Esd_Widget_UpdateActive(child);
+}
 
 void Ft_Esd_Widget_SetX(Ft_Esd_Widget *context, ft_int16_t x)
 {
@@ -390,8 +455,11 @@ void Ft_Esd_Widget_SetGlobalRect(Ft_Esd_Widget *context, ft_int16_t x, ft_int16_
 		context->GlobalWidth = width;
 		context->GlobalHeight = height;
 		Ft_Esd_Widget_PostGlobalRect(context);
+		++Ft_Esd_LayoutStats.Moved;
 	}
 	context->GlobalValid = FT_TRUE;
+	context->LocalChanged = FT_FALSE;
+	++Ft_Esd_LayoutStats.Visited;
 }
 
 void Ft_Esd_Widget_RecurseScrollGlobalRect(Ft_Esd_Widget *context, ft_int16_t xd, ft_int16_t yd)
@@ -404,6 +472,8 @@ void Ft_Esd_Widget_RecurseScrollGlobalRect(Ft_Esd_Widget *context, ft_int16_t xd
 		{
 			child->GlobalX += xd;
 			child->GlobalY += yd;
+			++Ft_Esd_LayoutStats.Visited;
+			++Ft_Esd_LayoutStats.Moved;
 			Ft_Esd_Widget_RecurseScrollGlobalRect(child, xd, yd);
 		}
 		child = next;
@@ -425,8 +495,11 @@ void Ft_Esd_Widget_ScrollGlobalRect(Ft_Esd_Widget *context, ft_int16_t x, ft_int
 		context->GlobalHeight = height;
 		Ft_Esd_Widget_PostGlobalRect(context);
 		Ft_Esd_Widget_RecurseScrollGlobalRect(context, xd, yd);
+		++Ft_Esd_LayoutStats.Moved;
 	}
 	context->GlobalValid = FT_TRUE;
+	context->LocalChanged = FT_FALSE;
+	++Ft_Esd_LayoutStats.Visited;
 }
 
 void Ft_Esd_Widget_GetGlobalRect(Ft_Esd_Widget *context, ft_int16_t *x, ft_int16_t *y, ft_int16_t *width, ft_int16_t *height)
@@ -453,6 +526,12 @@ void Ft_Esd_Widget_Free(Ft_Esd_Widget *context)
 	s_Ft_Esd_Widget_FreeQueue = context;
 }
 
+void Ft_Esd_Widget_LayoutFrameStart()
+{
+	Ft_Esd_LastLayoutStats = Ft_Esd_LayoutStats;
+	memset(&Ft_Esd_LayoutStats, 0, sizeof(Esd_LayoutStats));
+}
+
 void Ft_Esd_Widget_ProcessFree()
 {
 	Ft_Esd_Widget *current = s_Ft_Esd_Widget_FreeQueue;
@@ -71,6 +71,13 @@ typedef struct Ft_Esd_WidgetSlots
 
 } Ft_Esd_WidgetSlots;
 
+// Keep a depth first copy of the widget tree of each root widget in one array, so iterating children
+// does not chase pointers through memory. The linked lists remain the actual tree. Disabled by default,
+// the arrays are allocated statically, see Ft_Esd_WidgetTree.h
+#ifndef ESD_WIDGET_TREE
+#define ESD_WIDGET_TREE 0
+#endif
+
 // Class ID for base widget
 #define Ft_Esd_Widget_CLASSID 0x1EA612C1
 ESD_SYMBOL(Ft_Esd_Widget_CLASSID, Type = esd_classid_t)
@@ -125,6 +132,12 @@ typedef struct Ft_Esd_Widget
 	// Container widget for user added entries to the layout
 	struct Ft_Esd_Widget *Container;
 
+#if ESD_WIDGET_TREE
+	// Record of this widget in the flattened tree, which is only used when the record still refers to this widget
+	ft_uint16_t TreeIndex;
+	ft_uint8_t TreeId;
+#endif
+
 	// Flags
 	union
 	{
@@ -135,6 +148,9 @@ typedef struct Ft_Esd_Widget
 			ft_bool_t Root : 1; // Widget with this flag set is controlled manually and cannot be added into any layout
 			ft_bool_t Instanced : 1; // Widget is allocated dynamically in memory and needs to be deleted
 			ft_bool_t GlobalValid : 1; // Global rectangle has been set by the parent layout
+			ft_bool_t LocalChanged : 1; // Local rectangle changed since the parent layout last positioned this widget
+			ft_bool_t RecalculateLocal : 1; // Recalculate was only requested by children changing their LocalRect, layouts which position each child independently only need to position those children
+			ft_bool_t ActiveEffective : 1; // Widget and all its parents are active, up to an active root widget. Cached result of Ft_Esd_Widget_GetActive, updated when Active, Root, or the parent changes
 		};
 		ft_uint32_t Flags;
 	};
@@ -143,6 +159,22 @@ typedef struct Ft_Esd_Widget
 
 ESD_TYPE(Ft_Esd_Widget *, Native = Pointer, Edit = None)
 
+// Layout work done in one frame
+typedef struct
+{
+	ft_uint32_t Recalculated; // Layouts which recalculated their children
+	ft_uint32_t Visited; // Widgets positioned by their parent layout
+	ft_uint32_t Moved; // Widgets of which the global rectangle changed
+
+} Esd_LayoutStats;
+
+// Layout work done during the current and the previous frame
+extern Esd_LayoutStats Ft_Esd_LayoutStats;
+extern Esd_LayoutStats Ft_Esd_LastLayoutStats;
+
+// Check if a layout has to position a child again during Recalculate. Layouts which position each child independently of its siblings may skip the children which did not change
+#define Ft_Esd_Widget_NeedsLayout(context, child) (!(context)->RecalculateLocal || (child)->LocalChanged || !(child)->GlobalValid)
+
 // Call after changing LocalRect variables
 void Ft_Esd_Widget_PostLocalRect(Ft_Esd_Widget *context);
 
@@ -241,6 +273,9 @@ void Ft_Esd_Widget_InsertBottom(Ft_Esd_Widget *context, Ft_Esd_Widget *parent);
 void Ft_Esd_Widget_SetActive(Ft_Esd_Widget *context, ft_bool_t active);
 ft_bool_t Ft_Esd_Widget_GetActive(Ft_Esd_Widget *context);
 
+// Update the cached active state of a widget and its children. Only needed after changing Active or Root directly
+void Ft_Esd_Widget_UpdateActive(Ft_Esd_Widget *context);
+
 // Change a widget's relative positioning
 void Ft_Esd_Widget_SetX(Ft_Esd_Widget *context, ft_int16_t x);
 void Ft_Esd_Widget_SetY(Ft_Esd_Widget *context, ft_int16_t y);
@@ -0,0 +1,147 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#include "Ft_Esd_WidgetTree.h"
+
+#if ESD_WIDGET_TREE
+
+// Widgets refer to their tree by index, so a released tree never leaves a dangling pointer
+static Esd_WidgetTree s_WidgetTrees[ESD_WIDGET_TREE_MAX];
+
+// Add the root and its descendants in depth first order without recursion, the records of the parents
+// are the stack. Returns false when the tree does not fit
+static ft_bool_t flatten(Esd_WidgetTree *tree, ft_uint8_t id, Ft_Esd_Widget *root)
+{
+	Ft_Esd_Widget *widget = root;
+	ft_uint16_t parent = ESD_WIDGET_TREE_NONE;
+	ft_uint16_t previous = ESD_WIDGET_TREE_NONE;
+	ft_uint16_t index;
+
+	for (;;)
+	{
+		if (tree->Count >= ESD_WIDGET_TREE_SIZE)
+			return FT_FALSE;
+		index = tree->Count++;
+		widget->TreeId = id;
+		widget->TreeIndex = index;
+		tree->Flags[index] = widget->Active;
+		tree->Records[index].Widget = widget;
+		tree->Records[index].Parent = parent;
+		tree->Records[index].Skip = 0;
+		tree->Records[index].Previous = previous;
+		tree->Records[index].Last = ESD_WIDGET_TREE_NONE;
+		if (parent != ESD_WIDGET_TREE_NONE)
+			tree->Records[parent].Last = index;
+
+		if (widget->First)
+		{
+			parent = index;
+			previous = ESD_WIDGET_TREE_NONE;
+			widget = widget->First;
+			continue;
+		}
+
+		// Close the parents which have no more children, their descendants are all added
+		while (widget != root && !widget->Next)
+		{
+			index = parent;
+			tree->Records[index].Skip = tree->Count - index - 1;
+			parent = tree->Records[index].Parent;
+			widget = tree->Records[index].Widget;
+		}
+		if (widget == root)
+			return FT_TRUE;
+		previous = index;
+		widget = widget->Next;
+	}
+}
+
+static void build(Esd_WidgetTree *tree, Ft_Esd_Widget *root)
+{
+	ft_uint8_t id = (ft_uint8_t)(tree - s_WidgetTrees) + 1;
+
+	tree->Root = root;
+	tree->Count = 0;
+	tree->Dirty = FT_FALSE;
+	++tree->Version;
+	if (!flatten(tree, id, root))
+	{
+		// Keep iterating the linked lists until the tree changes again
+		eve_printf_debug("Widget tree does not fit in %i records\n", (int)ESD_WIDGET_TREE_SIZE);
+		tree->Count = 0;
+	}
+}
+
+Esd_WidgetTree *Esd_WidgetTree_Find(Ft_Esd_Widget *widget, ft_uint16_t *index)
+{
+	Esd_WidgetTree *tree = NULL;
+
+	if (widget->TreeId && widget->TreeId <= ESD_WIDGET_TREE_MAX)
+		tree = &s_WidgetTrees[widget->TreeId - 1];
+
+	if (widget->Root)
+	{
+		// The root owns the tree, and rebuilds it before iterating
+		if (!tree || tree->Root != widget)
+		{
+			tree = NULL;
+			for (int i = 0; i < ESD_WIDGET_TREE_MAX && !tree; ++i)
+			{
+				if (!s_WidgetTrees[i].Root)
+					tree = &s_WidgetTrees[i];
+			}
+			if (!tree)
+				return NULL;
+			tree->Dirty = FT_TRUE;
+		}
+		if (tree->Dirty)
+			build(tree, widget);
+	}
+
+	// The widget may have been moved out of the tree since it was built
+	if (!tree || tree->Dirty || widget->TreeIndex >= tree->Count || tree->Records[widget->TreeIndex].Widget != widget)
+		return NULL;
+	*index = widget->TreeIndex;
+	return tree;
+}
+
+void Esd_WidgetTree_Invalidate(Ft_Esd_Widget *widget)
+{
+	if (widget->TreeId && widget->TreeId <= ESD_WIDGET_TREE_MAX)
+		s_WidgetTrees[widget->TreeId - 1].Dirty = FT_TRUE;
+}
+
+void Esd_WidgetTree_SetActive(Ft_Esd_Widget *widget)
+{
+	Esd_WidgetTree *tree;
+
+	if (!widget->TreeId || widget->TreeId > ESD_WIDGET_TREE_MAX)
+		return;
+	tree = &s_WidgetTrees[widget->TreeId - 1];
+	if (widget->TreeIndex < tree->Count && tree->Records[widget->TreeIndex].Widget == widget)
+		tree->Flags[widget->TreeIndex] = widget->Active;
+}
+
+void Esd_WidgetTree_Release(Ft_Esd_Widget *root)
+{
+	Esd_WidgetTree *tree;
+
+	if (!root->TreeId || root->TreeId > ESD_WIDGET_TREE_MAX)
+		return;
+	tree = &s_WidgetTrees[root->TreeId - 1];
+	if (tree->Root != root)
+		return;
+
+	// Widgets still referring to this tree no longer match any record
+	tree->Root = NULL;
+	tree->Count = 0;
+	tree->Dirty = FT_TRUE;
+	++tree->Version;
+}
+
+#endif
+
+/* end of file */
@@ -0,0 +1,81 @@
+/*
+ESD Framework
+Copyright (C) 2018  Bridgetek Pte Lte
+Author: Jan Boon <jan.boon@kaetemi.be>
+*/
+
+#ifndef ESD_WIDGETTREE_H
+#define ESD_WIDGETTREE_H
+
+#include "Ft_Esd_Widget.h"
+
+#if ESD_WIDGET_TREE
+
+// Maximum number of root widgets with a flattened tree, other roots iterate the linked lists
+#ifndef ESD_WIDGET_TREE_MAX
+#define ESD_WIDGET_TREE_MAX 4
+#endif
+
+// Number of records in each tree, a root with more widgets iterates the linked lists
+#ifndef ESD_WIDGET_TREE_SIZE
+#define ESD_WIDGET_TREE_SIZE 128
+#endif
+
+// No record
+#define ESD_WIDGET_TREE_NONE 0xFFFF
+
+#if (ESD_WIDGET_TREE_SIZE >= ESD_WIDGET_TREE_NONE)
+#error ESD_WIDGET_TREE_SIZE must be less than ESD_WIDGET_TREE_NONE
+#endif
+
+typedef struct
+{
+	Ft_Esd_Widget *Widget;
+	ft_uint16_t Parent; // Record of the parent widget
+	ft_uint16_t Skip; // Number of descendants, the next sibling follows after them
+	ft_uint16_t Previous; // Record of the previous sibling
+	ft_uint16_t Last; // Record of the last child
+
+} Esd_WidgetRecord;
+
+typedef struct
+{
+	Ft_Esd_Widget *Root;
+
+	// Records in depth first order, with the Active flag of each widget in a separate array
+	Esd_WidgetRecord Records[ESD_WIDGET_TREE_SIZE];
+	ft_uint8_t Flags[ESD_WIDGET_TREE_SIZE];
+	ft_uint16_t Count;
+
+	// Incremented on every rebuild, iterations stop using the records when it changes
+	ft_uint32_t Version;
+
+	// Widgets were inserted or detached, the records are rebuilt when the root iterates its children
+	ft_bool_t Dirty;
+
+} Esd_WidgetTree;
+
+/// Get the tree containing the widget and its record, rebuilding the tree of a root widget if needed.
+/// Returns NULL when the widget is not in an up to date tree
+Esd_WidgetTree *Esd_WidgetTree_Find(Ft_Esd_Widget *widget, ft_uint16_t *index);
+
+/// Mark the tree containing the widget for rebuilding, called when children are inserted or detached
+void Esd_WidgetTree_Invalidate(Ft_Esd_Widget *widget);
+
+/// Update the copy of the Active flag of the widget
+void Esd_WidgetTree_SetActive(Ft_Esd_Widget *widget);
+
+/// Release the tree of a root widget
+void Esd_WidgetTree_Release(Ft_Esd_Widget *root);
+
+#else
+
+#define Esd_WidgetTree_Invalidate(widget) eve_noop()
+#define Esd_WidgetTree_SetActive(widget) eve_noop()
+#define Esd_WidgetTree_Release(root) eve_noop()
+
+#endif
+
+#endif /* #ifndef ESD_WIDGETTREE_H */
+
+/* end of file */
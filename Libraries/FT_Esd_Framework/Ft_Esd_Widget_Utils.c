@@ -1,6 +1,7 @@
 
 
 #include "Ft_Esd_Widget.h"
+#include "Ft_Esd_WidgetTree.h"
 
 void Ft_Esd_Widget_Detach_Internal(Ft_Esd_Widget *context);
 
@@ -27,6 +28,8 @@ void Ft_Esd_Widget_LocalInsertAbove(Ft_Esd_Widget *context, Ft_Esd_Widget *sibli
 	if (parent->First == sibling)
 		parent->First = context;
 	parent->Recalculate = 1;
+	Esd_WidgetTree_Invalidate(parent);
+	Ft_Esd_Widget_UpdateActive(context);
 	if (!activeBefore && Ft_Esd_Widget_GetActive(context))
 		context->Slots->Enable(context);
 }
@@ -54,6 +57,8 @@ void Ft_Esd_Widget_LocalInsertBelow(Ft_Esd_Widget *context, Ft_Esd_Widget *sibli
 	if (parent->Last == sibling)
 		parent->Last = context;
 	parent->Recalculate = 1;
+	Esd_WidgetTree_Invalidate(parent);
+	Ft_Esd_Widget_UpdateActive(context);
 	if (!activeBefore && Ft_Esd_Widget_GetActive(context))
 		context->Slots->Enable(context);
 }
@@ -64,11 +69,14 @@ void Ft_Esd_Widget_SortToTop(Ft_Esd_Widget *context)
 	if (!parent)
 		return;
 	ft_bool_t active = context->Active;
+	ft_bool_t activeEffective = context->ActiveEffective;
 	ft_bool_t globalValid = context->GlobalValid;
 	context->Active = FT_FALSE;
+	context->ActiveEffective = FT_FALSE;
 	Ft_Esd_Widget_Detach(context);
 	Ft_Esd_Widget_LocalInsertTop(context, parent);
 	context->Active = active;
+	context->ActiveEffective = activeEffective; // Same parent, so the children are still up to date
 	context->GlobalValid = globalValid;
 }
 
@@ -78,11 +86,14 @@ void Ft_Esd_Widget_SortHigher(Ft_Esd_Widget *context)
 	if (!previous)
 		return;
 	ft_bool_t active = context->Active;
+	ft_bool_t activeEffective = context->ActiveEffective;
 	ft_bool_t globalValid = context->GlobalValid;
 	context->Active = FT_FALSE;
+	context->ActiveEffective = FT_FALSE;
 	Ft_Esd_Widget_Detach(context);
 	Ft_Esd_Widget_LocalInsertAbove(context, previous);
 	context->Active = active;
+	context->ActiveEffective = activeEffective; // Same parent, so the children are still up to date
 	context->GlobalValid = globalValid;
 }
 
@@ -92,11 +103,14 @@ void Ft_Esd_Widget_SortLower(Ft_Esd_Widget *context)
 	if (!next)
 		return;
 	ft_bool_t active = context->Active;
+	ft_bool_t activeEffective = context->ActiveEffective;
 	ft_bool_t globalValid = context->GlobalValid;
 	context->Active = FT_FALSE;
+	context->ActiveEffective = FT_FALSE;
 	Ft_Esd_Widget_Detach(context);
 	Ft_Esd_Widget_LocalInsertBelow(context, next);
 	context->Active = active;
+	context->ActiveEffective = activeEffective; // Same parent, so the children are still up to date
 	context->GlobalValid = globalValid;
 }
 
@@ -106,11 +120,14 @@ void Ft_Esd_Widget_SortToBottom(Ft_Esd_Widget *context)
 	if (!parent)
 		return;
 	ft_bool_t active = context->Active;
+	ft_bool_t activeEffective = context->ActiveEffective;
 	ft_bool_t globalValid = context->GlobalValid;
 	context->Active = FT_FALSE;
+	context->ActiveEffective = FT_FALSE;
 	Ft_Esd_Widget_Detach(context);
 	Ft_Esd_Widget_LocalInsertBottom(context, parent);
 	context->Active = active;
+	context->ActiveEffective = activeEffective; // Same parent, so the children are still up to date
 	context->GlobalValid = globalValid;
 }
 
@@ -167,6 +184,7 @@ void Ft_Esd_Widget_SetRoot(Ft_Esd_Widget *context, ft_bool_t root)
 	{
 		ft_bool_t activeBefore = Ft_Esd_Widget_GetActive(context);
 		context->Root = root;
+		Ft_Esd_Widget_UpdateActive(context);
 		ft_bool_t activeAfter = Ft_Esd_Widget_GetActive(context);
 		if (activeBefore != activeAfter)
 		{
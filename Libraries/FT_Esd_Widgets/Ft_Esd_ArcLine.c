@@ -83,7 +83,7 @@ void Ft_Esd_ArcLine_Render_Func(Ft_Esd_ArcLine *context, int x, int y, int radiu
 		.X = context->Widget.GlobalX - 1, .Y = context->Widget.GlobalY - 1, .Width = context->Widget.GlobalWidth + 2, .Height = context->Widget.GlobalHeight + 2
 	};
 	scissor = Ft_Esd_Rect16_Crop(scissor, Ft_Esd_Dl_Scissor_Get());
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_XY(scissor.X, scissor.Y));
+	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, ESD_SCISSOR_XY(scissor.X, scissor.Y));
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_SIZE(scissor.Width, scissor.Height));
 
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, CLEAR_COLOR_RGB(0, 0, 0));
@@ -323,7 +323,7 @@ void Ft_Esd_ArcLine_Render_Func(Ft_Esd_ArcLine *context, int x, int y, int radiu
 		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SAVE_CONTEXT()); // C
 
 		Ft_Esd_Rect16 scissor = Ft_Esd_Rect16_Crop(context->Widget.GlobalRect, Ft_Esd_Dl_Scissor_Get());
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_XY(scissor.X, scissor.Y));
+		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, ESD_SCISSOR_XY(scissor.X, scissor.Y));
 		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_SIZE(scissor.Width, scissor.Height));
 
 		//printf("Sec Round\n");
@@ -34,7 +34,7 @@ void Ft_Esd_CircleLine_Render_Func(Ft_Esd_CircleLine *context, int x, int y, int
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SAVE_CONTEXT());
 
 	Ft_Esd_Rect16 scissor = Ft_Esd_Rect16_Crop(context->Widget.GlobalRect, Ft_Esd_Dl_Scissor_Get());
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_XY(scissor.X, scissor.Y));
+	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, ESD_SCISSOR_XY(scissor.X, scissor.Y));
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_SIZE(scissor.Width, scissor.Height));
 
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, CLEAR_COLOR_RGB(0, 0, 0));
@@ -1069,6 +1069,7 @@ ft_void_t writeBitmapIntoGPUMemory(ft_uint8_t gradientType)
 	if (gradientType == ESD_PYTHAGOREAN)
 	{
 		pythagGpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, BITMAP_TOTAL_SIZE, GA_GC_FLAG);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, pythagGpuHandle, &pythagGpuHandle, "CircularGradient pythag");
 		uint32_t addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, pythagGpuHandle);
 
 		EVE_Cmd_startFunc(Ft_Esd_Host);
@@ -1081,6 +1082,7 @@ ft_void_t writeBitmapIntoGPUMemory(ft_uint8_t gradientType)
 	else
 	{
 		gaussGpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, BITMAP_TOTAL_SIZE, GA_GC_FLAG);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, gaussGpuHandle, &gaussGpuHandle, "CircularGradient gauss");
 		uint32_t addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, gaussGpuHandle);
 
 		EVE_Cmd_startFunc(Ft_Esd_Host);
@@ -1138,10 +1140,7 @@ ft_void_t Circular_Gradient_Widget_Render_Circular(Ft_Esd_CircularGradient *cont
 		eve_assert_ex(false, "No support yet in ESD for bitmaps for FT800 target");
 #endif
 	}
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SIZE(BILINEAR, REPEAT, REPEAT, w & 0x1FF, h & 0x1FF));
-#if (EVE_MODEL >= EVE_FT810)
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BITMAP_SIZE_H(w >> 9, h >> 9));
-#endif
+	Ft_Esd_Dl_Bitmap_Size(handle, BILINEAR, REPEAT, REPEAT, w, h);
 
 	// The code below will do the circular gradient
 	Ft_Esd_Dl_SAVE_CONTEXT();
@@ -1151,35 +1150,35 @@ ft_void_t Circular_Gradient_Widget_Render_Circular(Ft_Esd_CircularGradient *cont
 		.X = x0, .Y = y0, .Width = w, .Height = h
 	};
 	scissor = Ft_Esd_Rect16_Crop(scissor, Ft_Esd_Dl_Scissor_Get());
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_XY(scissor.X, scissor.Y));
+	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, ESD_SCISSOR_XY(scissor.X, scissor.Y));
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, SCISSOR_SIZE(scissor.Width, scissor.Height));
 
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, COLOR_MASK(0, 0, 0, 1)); // Only touch the alpha channel
+	Ft_Esd_Dl_COLOR_MASK(0, 0, 0, 1); // Only touch the alpha channel
 
 	Ft_Esd_Dl_BITMAP_HANDLE(handle); // At any instant only one bitmap is loaded in memory.
 	    // Hence we use only one Bitmap Handle. By default it is starting with zero (0)
 
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BLEND_FUNC(ONE, ZERO)); // Draw the X bitmap into alpha
+	Ft_Esd_Dl_BLEND_FUNC(ONE, ZERO); // Draw the X bitmap into alpha
 	BitMapTransform(0, w, h);
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(X0, Y0));
 
 	if (gradientType == ESD_PYTHAGOREAN)
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BLEND_FUNC(ONE, ONE)); // For pythagorean, want alpha addition
+		Ft_Esd_Dl_BLEND_FUNC(ONE, ONE); // For pythagorean, want alpha addition
 	else
-		Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BLEND_FUNC(DST_ALPHA, ZERO)); // But for Gaussian, multiplication
+		Ft_Esd_Dl_BLEND_FUNC(DST_ALPHA, ZERO); // But for Gaussian, multiplication
 	BitMapTransform(1, w, h); // Blend the Y bitmap into alpha
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(X0, Y0));
 
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, COLOR_MASK(1, 1, 1, 0)); // Now use the alpha buffer
+	Ft_Esd_Dl_COLOR_MASK(1, 1, 1, 0); // Now use the alpha buffer
 	Ft_Esd_Dl_BEGIN(RECTS);
 
 	Ft_Esd_Dl_COLOR_RGB(color1);
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BLEND_FUNC(ONE, ZERO));
+	Ft_Esd_Dl_BLEND_FUNC(ONE, ZERO);
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(X0, Y0));
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(X1, Y1));
 
 	Ft_Esd_Dl_COLOR_RGB(color2);
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, BLEND_FUNC(DST_ALPHA, ONE_MINUS_DST_ALPHA));
+	Ft_Esd_Dl_BLEND_FUNC(DST_ALPHA, ONE_MINUS_DST_ALPHA);
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(X0, Y0));
 	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, VERTEX2F(X1, Y1));
 	Ft_Esd_Dl_RESTORE_CONTEXT();
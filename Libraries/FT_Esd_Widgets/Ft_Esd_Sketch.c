@@ -61,7 +61,8 @@ void Ft_Esd_Sketch_Resize_Bitmap(Ft_Esd_Sketch *context)
 	}
 	if (addr == GA_INVALID)
 	{
-		bitmapInfo->GpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, bitmapInfo->Size, GA_GC_FLAG);
+		bitmapInfo->GpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, bitmapInfo->Size, GA_GC_FLAG | GA_PINNED_FLAG);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, bitmapInfo->GpuHandle, context, "Sketch");
 		addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, bitmapInfo->GpuHandle);
 	}
 
@@ -121,7 +122,8 @@ void Ft_Esd_Sketch_Alloc_Bitmap(Ft_Esd_Sketch *context)
 	if (addr == GA_INVALID)
 	{
 		// Allocate new memory if needed
-		bitmapInfo->GpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, bitmapInfo->Size, GA_GC_FLAG);
+		bitmapInfo->GpuHandle = Ft_Esd_GpuAlloc_Alloc(Ft_Esd_GAlloc, bitmapInfo->Size, GA_GC_FLAG | GA_PINNED_FLAG);
+		Ft_Esd_GpuAlloc_SetOwner(Ft_Esd_GAlloc, bitmapInfo->GpuHandle, context, "Sketch");
 		addr = Ft_Esd_GpuAlloc_Get(Ft_Esd_GAlloc, bitmapInfo->GpuHandle);
 
 		if (addr != GA_INVALID)
@@ -161,7 +163,7 @@ void Ft_Esd_Sketch_CoCmd_Sketch(Ft_Esd_Sketch *context)
 	if (addr == GA_INVALID)
 		return;
 
-	// Enable SKETCH mode
+	// Enable SKETCH mode, the sketch keeps writing to this address so it must not be moved
 	Ft_Esd_CoCmd_Sketch(context,
 	    context->Widget.GlobalRect,
 	    addr, L8);
@@ -30,14 +30,14 @@ void Ft_Esd_Toggle_Render_CoCmd(Ft_Esd_Toggle *context, ft_uint8_t tag, ft_int16
 {
 #if (EVE_MODEL < EVE_BT815)
 	// Fix for tag issue pre-BT815
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, TAG_MASK(0));
+	Ft_Esd_Dl_TAG_MASK(0);
 	Ft_Gpu_CoCmd_Toggle(Ft_Esd_Host, x, y, w, font, options, state, s);
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, TAG_MASK(1));
+	Ft_Esd_Dl_TAG_MASK(1);
 	Ft_Esd_Dl_TAG(tag);
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, COLOR_MASK(0, 0, 0, 0));
+	Ft_Esd_Dl_COLOR_MASK(0, 0, 0, 0);
 	ft_int16_t realY = context->Widget.GlobalY + (context->Widget.GlobalHeight >> 1);
 	Ft_Esd_Render_Line(x, realY, x + w, realY, Ft_Esd_Toggle_RealHeight(context), 0xffffffff);
-	Ft_Gpu_CoCmd_SendCmd(Ft_Esd_Host, COLOR_MASK(1, 1, 1, 1));
+	Ft_Esd_Dl_COLOR_MASK(1, 1, 1, 1);
 	Ft_Esd_Dl_TAG(255);
 #else
 	// Just use TAG on Toggle itself
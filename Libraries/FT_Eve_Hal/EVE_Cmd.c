@@ -32,6 +32,15 @@
 #include "EVE_Cmd.h"
 #include "EVE_Platform.h"
 #include <stddef.h>
+#include <string.h>
+
+/* Free space to wait for before streaming the next part of a large buffer.
+Smaller keeps the FIFO fuller, larger needs fewer transfers */
+#ifndef EVE_CMD_STREAM_CHUNK
+#define EVE_CMD_STREAM_CHUNK 256
+#endif
+
+static bool waitStreamSpace(EVE_HalContext *phost, uint32_t size);
 
 static inline void endFunc(EVE_HalContext *phost)
 {
@@ -95,16 +104,35 @@ static uint32_t wrBuffer(EVE_HalContext *phost, const void *buffer, uint32_t siz
 	{
 		uint32_t transfer = (size - transfered);
 		uint32_t space = phost->CmdSpace;
-		uint32_t req = min((string ? (transfer + 1) : transfer), (EVE_CMD_FIFO_SIZE >> 1));
-		eve_assert(!string || (req == (transfer + 1)));
-		if (space < req)
+		if (string)
 		{
-			if (!EVE_Cmd_waitSpace(phost, req))
-				return transfered; /* Coprocessor fault */
-			space = phost->CmdSpace;
+			uint32_t req = min((transfer + 1), (EVE_CMD_FIFO_SIZE >> 1));
+			eve_assert(req == (transfer + 1));
+			if (space < req)
+			{
+				if (!EVE_Cmd_waitSpace(phost, req))
+					return transfered; /* Coprocessor fault */
+				space = phost->CmdSpace;
+			}
+		}
+		else
+		{
+			/* Stream, write whatever space is free once a chunk is available */
+			uint32_t req = min(transfer, EVE_CMD_STREAM_CHUNK);
+			if (space < req)
+			{
+				if (!waitStreamSpace(phost, req))
+					return transfered; /* Coprocessor fault */
+				space = phost->CmdSpace;
+			}
 		}
 		if (transfer > space)
 			transfer = space;
+#if !defined(EVE_SUPPORT_CMDB)
+		/* Split at the end of RAM_CMD, the remainder is written at the start */
+		if (!string && transfer > (uint32_t)(EVE_CMD_FIFO_SIZE - phost->CmdWp))
+			transfer = EVE_CMD_FIFO_SIZE - phost->CmdWp;
+#endif
 		eve_assert(transfer <= EVE_CMD_FIFO_SIZE - 4);
 		if (transfer)
 		{
@@ -161,17 +189,48 @@ static uint32_t wrBuffer(EVE_HalContext *phost, const void *buffer, uint32_t siz
 			{
 				EVE_Hal_wr16(phost, REG_CMD_WRITE, phost->CmdWp);
 			}
+			else if (!phost->CmdWp)
+			{
+				/* Wrapped, the transfer must restart at the start of RAM_CMD */
+				endFunc(phost);
+			}
 #endif
 		}
 	} while (transfered < size);
 	return transfered;
 }
 
+/* Let the caller write any display list content it has deferred */
+static inline bool runDeferred(EVE_HalContext *phost)
+{
+	EVE_Callback cbCmdDeferred = phost->CbCmdDeferred;
+	if (cbCmdDeferred)
+	{
+		phost->CbCmdDeferred = NULL;
+		return cbCmdDeferred(phost);
+	}
+	return true;
+}
+
+/* Send any deferred display list content and any words held back by the
+peephole optimizer, must be called before anything else is written to the command buffer */
+static inline bool flushDeferred(EVE_HalContext *phost)
+{
+	if (!runDeferred(phost))
+		return false;
+#if defined(EVE_CMD_PEEPHOLE)
+	if (phost->CmdDlNb)
+		return EVE_Cmd_flushDl(phost);
+#endif
+	return true;
+}
+
 /* Begin writing a function, keeps the transfer open */
 void EVE_Cmd_startFunc(EVE_HalContext *phost)
 {
 	eve_assert(!phost->CmdWaiting);
 	eve_assert(phost->CmdBufferIndex == 0);
+	flushDeferred(phost);
 	phost->CmdFunc = true;
 }
 
@@ -188,6 +247,8 @@ bool EVE_Cmd_wrMem(EVE_HalContext *phost, const uint8_t *buffer, uint32_t size)
 {
 	eve_assert(!phost->CmdWaiting);
 	eve_assert(phost->CmdBufferIndex == 0);
+	if (!flushDeferred(phost))
+		return false;
 	return wrBuffer(phost, buffer, size, false, false) == size;
 }
 
@@ -195,6 +256,8 @@ bool EVE_Cmd_wrProgmem(EVE_HalContext *phost, eve_progmem_const uint8_t *buffer,
 {
 	eve_assert(!phost->CmdWaiting);
 	eve_assert(phost->CmdBufferIndex == 0);
+	if (!flushDeferred(phost))
+		return false;
 	return wrBuffer(phost, (void *)(uintptr_t)buffer, size, true, false) == size;
 }
 
@@ -203,6 +266,8 @@ uint32_t EVE_Cmd_wrString(EVE_HalContext *phost, const char *str, uint32_t maxLe
 	uint32_t transfered;
 	eve_assert(!phost->CmdWaiting);
 	eve_assert(phost->CmdBufferIndex == 0);
+	if (!flushDeferred(phost))
+		return 0;
 	transfered = wrBuffer(phost, str, maxLength, false, true);
 	return transfered;
 }
@@ -211,6 +276,8 @@ bool EVE_Cmd_wr8(EVE_HalContext *phost, uint8_t value)
 {
 	eve_assert(!phost->CmdWaiting);
 	eve_assert(phost->CmdBufferIndex < 4);
+	if (!flushDeferred(phost))
+		return false;
 
 	phost->CmdBuffer[phost->CmdBufferIndex++] = value;
 
@@ -227,6 +294,8 @@ bool EVE_Cmd_wr16(EVE_HalContext *phost, uint16_t value)
 {
 	eve_assert(!phost->CmdWaiting);
 	eve_assert(phost->CmdBufferIndex < 3);
+	if (!flushDeferred(phost))
+		return false;
 
 	phost->CmdBuffer[phost->CmdBufferIndex++] = value & 0xFF;
 	phost->CmdBuffer[phost->CmdBufferIndex++] = value >> 8;
@@ -240,11 +309,8 @@ bool EVE_Cmd_wr16(EVE_HalContext *phost, uint16_t value)
 	return true;
 }
 
-bool EVE_Cmd_wr32(EVE_HalContext *phost, uint32_t value)
+static bool wr32(EVE_HalContext *phost, uint32_t value)
 {
-	eve_assert(!phost->CmdWaiting);
-	eve_assert(phost->CmdBufferIndex == 0);
-
 	if (phost->CmdSpace < 4 && !EVE_Cmd_waitSpace(phost, 4))
 		return false;
 
@@ -270,11 +336,262 @@ bool EVE_Cmd_wr32(EVE_HalContext *phost, uint32_t value)
 	{
 		EVE_Hal_wr16(phost, REG_CMD_WRITE, phost->CmdWp);
 	}
+	else if (!phost->CmdWp)
+	{
+		/* Wrapped, the transfer must restart at the start of RAM_CMD */
+		endFunc(phost);
+	}
+#endif
+
+	return true;
+}
+
+bool EVE_Cmd_wr32(EVE_HalContext *phost, uint32_t value)
+{
+	eve_assert(!phost->CmdWaiting);
+	eve_assert(phost->CmdBufferIndex == 0);
+
+	if (!flushDeferred(phost))
+		return false;
+
+	return wr32(phost, value);
+}
+
+#if defined(EVE_CMD_PEEPHOLE)
+
+#define DL_OP(value) ((value) >> 24)
+#define DL_IS_VERTEX(value) ((value)&0xC0000000UL)
+#define DL_IS_VERTEX2F(value) (((value)&0xC0000000UL) == 0x40000000UL)
+#define DL_IS_VERTEX2II(value) (((value)&0xC0000000UL) == 0x80000000UL)
+
+#define DL_BEGIN 31
+#define DL_END 33
+#define DL_SAVE_CONTEXT 34
+#define DL_RESTORE_CONTEXT 35
+#define DL_VERTEX_FORMAT 39
+
+/* Check if the display list word only sets graphics context state,
+which has no effect until a later word reads it */
+static bool dlIsState(uint32_t value)
+{
+	if (DL_IS_VERTEX(value))
+		return false;
+
+	switch (DL_OP(value))
+	{
+	case 2: /* CLEAR_COLOR_RGB */
+	case 3: /* TAG */
+	case 4: /* COLOR_RGB */
+	case 5: /* BITMAP_HANDLE */
+	case 6: /* CELL */
+	case 9: /* ALPHA_FUNC */
+	case 10: /* STENCIL_FUNC */
+	case 11: /* BLEND_FUNC */
+	case 12: /* STENCIL_OP */
+	case 13: /* POINT_SIZE */
+	case 14: /* LINE_WIDTH */
+	case 15: /* CLEAR_COLOR_A */
+	case 16: /* COLOR_A */
+	case 17: /* CLEAR_STENCIL */
+	case 18: /* CLEAR_TAG */
+	case 19: /* STENCIL_MASK */
+	case 20: /* TAG_MASK */
+	case 21: /* BITMAP_TRANSFORM_A */
+	case 22: /* BITMAP_TRANSFORM_B */
+	case 23: /* BITMAP_TRANSFORM_C */
+	case 24: /* BITMAP_TRANSFORM_D */
+	case 25: /* BITMAP_TRANSFORM_E */
+	case 26: /* BITMAP_TRANSFORM_F */
+	case 27: /* SCISSOR_XY */
+	case 28: /* SCISSOR_SIZE */
+	case 32: /* COLOR_MASK */
+#if (EVE_MODEL >= EVE_FT810)
+	case DL_VERTEX_FORMAT:
+	case 42: /* PALETTE_SOURCE */
+	case 43: /* VERTEX_TRANSLATE_X */
+	case 44: /* VERTEX_TRANSLATE_Y */
+#endif
+		return true;
+	}
+
+	return false;
+}
+
+static bool dlIsPrimitive(uint32_t value)
+{
+	return !DL_IS_VERTEX(value) && (DL_OP(value) == DL_BEGIN || DL_OP(value) == DL_END);
+}
+
+/* Check if the display list word may read the state set by the specified opcode.
+Anything that is not known to be harmless is treated as reading all state */
+static bool dlReads(uint32_t value, uint32_t op)
+{
+	if (dlIsState(value) || dlIsPrimitive(value))
+		return false;
+	if (DL_IS_VERTEX2II(value))
+		return op != DL_VERTEX_FORMAT;
+	return true;
+}
+
+static void dlRemove(EVE_HalContext *phost, int i)
+{
+	--phost->CmdDlNb;
+	memmove(&phost->CmdDl[i], &phost->CmdDl[i + 1], (phost->CmdDlNb - i) * sizeof(uint32_t));
+	++phost->CmdDlRemoved;
+}
+
+/* Send the oldest held back words */
+static bool dlSend(EVE_HalContext *phost, uint8_t nb)
+{
+	uint32_t buffer[EVE_CMD_PEEPHOLE_SIZE];
+	uint32_t size = nb * sizeof(uint32_t);
+	eve_assert(nb <= phost->CmdDlNb);
+	memcpy(buffer, phost->CmdDl, size);
+	phost->CmdDlNb -= nb;
+	memmove(phost->CmdDl, &phost->CmdDl[nb], phost->CmdDlNb * sizeof(uint32_t));
+	return wrBuffer(phost, buffer, size, false, false) == size;
+}
+
+#if (EVE_MODEL >= EVE_FT810)
+/* Rewrite VERTEX2F as VERTEX2II when the vertex format and the primitive
+are known from the held back words, and the coordinates are whole pixels.
+This leaves no reader for the VERTEX_FORMAT words around the vertex,
+so they can be removed */
+static uint32_t dlVertex2ii(EVE_HalContext *phost, uint32_t value)
+{
+	int format = -1;
+	int primitive = -1;
+	uint32_t x, y, mask;
+	int i;
+
+	for (i = phost->CmdDlNb - 1; i >= 0 && (format < 0 || primitive < 0); --i)
+	{
+		uint32_t w = phost->CmdDl[i];
+		if (DL_IS_VERTEX(w) || DL_OP(w) == DL_SAVE_CONTEXT)
+			continue;
+		if (DL_OP(w) == DL_VERTEX_FORMAT)
+		{
+			if (format < 0)
+				format = w & 0x7;
+		}
+		else if (DL_OP(w) == DL_BEGIN)
+		{
+			if (primitive < 0)
+				primitive = w & 0xF;
+		}
+		else if (!dlIsState(w))
+		{
+			/* END, RESTORE_CONTEXT, or anything unknown */
+			return value;
+		}
+	}
+
+	if (format < 0 || primitive < 0 || primitive == BITMAPS)
+		return value;
+
+	x = (value >> 15) & 0x7FFF;
+	y = value & 0x7FFF;
+	mask = (1UL << format) - 1;
+	if ((x & 0x4000) || (y & 0x4000) || (x & mask) || (y & mask))
+		return value; /* Negative, or not on a whole pixel */
+	x >>= format;
+	y >>= format;
+	if (x > 511 || y > 511)
+		return value;
+
+	++phost->CmdDlRewritten;
+	return VERTEX2II(x, y, 0, 0);
+}
+#endif
+
+bool EVE_Cmd_wrDl(EVE_HalContext *phost, uint32_t value)
+{
+	int i;
+
+	eve_assert(!phost->CmdWaiting);
+	eve_assert(phost->CmdBufferIndex == 0);
+
+	if (phost->CmdFunc)
+	{
+		/* Words written as part of a function are sent as they are */
+		return flushDeferred(phost) && wr32(phost, value);
+	}
+
+	if (!runDeferred(phost))
+		return false;
+
+#if (EVE_MODEL >= EVE_FT810)
+	if (DL_IS_VERTEX2F(value))
+		value = dlVertex2ii(phost, value);
 #endif
 
+	if (dlIsState(value))
+	{
+		/* An earlier write of the same state which nothing has read is dead */
+		for (i = phost->CmdDlNb - 1; i >= 0; --i)
+		{
+			uint32_t w = phost->CmdDl[i];
+			if (dlIsState(w) && DL_OP(w) == DL_OP(value))
+			{
+				dlRemove(phost, i);
+				break;
+			}
+			if (dlReads(w, DL_OP(value)))
+				break;
+		}
+	}
+	else if (dlIsPrimitive(value))
+	{
+		/* BEGIN or END without any vertex before the next BEGIN or END is dead */
+		for (i = phost->CmdDlNb - 1; i >= 0; --i)
+		{
+			uint32_t w = phost->CmdDl[i];
+			if (dlIsPrimitive(w))
+			{
+				dlRemove(phost, i);
+				break;
+			}
+			if (!dlIsState(w))
+				break;
+		}
+	}
+	else if (value == RESTORE_CONTEXT())
+	{
+		/* Any state written since the last word that read it is overwritten */
+		for (i = phost->CmdDlNb - 1; i >= 0 && dlIsState(phost->CmdDl[i]); --i)
+			dlRemove(phost, i);
+
+		/* Nothing left between SAVE_CONTEXT and RESTORE_CONTEXT */
+		if (i >= 0 && phost->CmdDl[i] == SAVE_CONTEXT())
+		{
+			dlRemove(phost, i);
+			++phost->CmdDlRemoved;
+			return true;
+		}
+	}
+
+	if (phost->CmdDlNb == EVE_CMD_PEEPHOLE_SIZE)
+	{
+		if (!dlSend(phost, EVE_CMD_PEEPHOLE_SIZE >> 1))
+			return false;
+	}
+
+	phost->CmdDl[phost->CmdDlNb++] = value;
 	return true;
 }
 
+bool EVE_Cmd_flushDl(EVE_HalContext *phost)
+{
+	eve_assert(!phost->CmdWaiting);
+	eve_assert(phost->CmdBufferIndex == 0);
+
+	if (!phost->CmdDlNb)
+		return true;
+	return dlSend(phost, phost->CmdDlNb);
+}
+
+#endif
+
 /* Move the write pointer forward by the specified number of bytes. Returns the previous write pointer */
 uint16_t EVE_Cmd_moveWp(EVE_HalContext *phost, uint16_t bytes)
 {
@@ -282,6 +599,9 @@ uint16_t EVE_Cmd_moveWp(EVE_HalContext *phost, uint16_t bytes)
 	eve_assert(!phost->CmdWaiting);
 	eve_assert(phost->CmdBufferIndex == 0);
 
+	if (!flushDeferred(phost))
+		return -1;
+
 	if (!EVE_Cmd_waitSpace(phost, bytes))
 		return -1;
 
@@ -374,6 +694,9 @@ bool EVE_Cmd_waitFlush(EVE_HalContext *phost)
 	uint16_t rp, wp;
 
 	eve_assert(!phost->CmdWaiting);
+	if (!flushDeferred(phost))
+		return false;
+
 	phost->CmdWaiting = true;
 	while ((rp = EVE_Cmd_rp(phost)) != (wp = EVE_Cmd_wp(phost)))
 	{
@@ -418,9 +741,65 @@ bool EVE_Cmd_waitSpace(EVE_HalContext *phost, uint32_t size)
 	return true;
 }
 
+/* Refresh the available space with a single register read,
+using the cached write pointer when CMDB is not supported */
+static uint16_t readStreamSpace(EVE_HalContext *phost)
+{
+	uint16_t space;
+#if defined(EVE_SUPPORT_CMDB)
+	space = EVE_Hal_rd16(phost, REG_CMDB_SPACE) & EVE_CMD_FIFO_MASK;
+	if (EVE_CMD_FAULT(space))
+	{
+		phost->CmdFault = true;
+		return space;
+	}
+#else
+	uint16_t rp = EVE_Hal_rd16(phost, REG_CMD_READ) & EVE_CMD_FIFO_MASK;
+	if (EVE_CMD_FAULT(rp))
+	{
+		phost->CmdFault = true;
+		return rp;
+	}
+	space = (rp - phost->CmdWp - 4) & EVE_CMD_FIFO_MASK;
+#endif
+	phost->CmdSpace = space;
+	return space;
+}
+
+/* Wait for free space while streaming a buffer. 
+Returns false in case a coprocessor fault occurred */
+static bool waitStreamSpace(EVE_HalContext *phost, uint32_t size)
+{
+	uint16_t space;
+
+	eve_assert(!phost->CmdWaiting);
+	phost->CmdWaiting = true;
+
+	endFunc(phost);
+	space = readStreamSpace(phost);
+	if (!checkWait(phost, space))
+		return false;
+
+	while (space < size)
+	{
+		if (!handleWait(phost, space))
+			return false;
+		space = readStreamSpace(phost);
+		if (!checkWait(phost, space))
+			return false;
+	}
+
+	/* Sufficient space */
+	phost->CmdWaiting = false;
+	return true;
+}
+
 bool EVE_Cmd_waitLogo(EVE_HalContext *phost)
 {
 	eve_assert(!phost->CmdWaiting);
+	if (!flushDeferred(phost))
+		return false;
+
 	phost->CmdWaiting = true;
 
 	uint16_t rp, wp;
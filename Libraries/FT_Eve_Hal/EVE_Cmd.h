@@ -101,6 +101,24 @@ Waits if there is not enough space in the command buffer.
 Returns false in case a coprocessor fault occurred */
 bool EVE_Cmd_wr32(EVE_HalContext *phost, uint32_t value);
 
+#if defined(EVE_CMD_PEEPHOLE)
+/* Write a display list word to the command buffer.
+The word is held back in a small window, where state writes that are
+never read, empty BEGIN/END and SAVE_CONTEXT/RESTORE_CONTEXT pairs are
+removed, and VERTEX2F is rewritten as VERTEX2II where possible.
+Any other write to the command buffer sends the held back words first.
+Held back words are not included in EVE_Cmd_wp and EVE_Cmd_space.
+Returns false in case a coprocessor fault occurred */
+bool EVE_Cmd_wrDl(EVE_HalContext *phost, uint32_t value);
+
+/* Send any display list words held back by EVE_Cmd_wrDl. 
+Returns false in case a coprocessor fault occurred */
+bool EVE_Cmd_flushDl(EVE_HalContext *phost);
+#else
+#define EVE_Cmd_wrDl EVE_Cmd_wr32
+#define EVE_Cmd_flushDl(phost) (true)
+#endif
+
 /* Move the write pointer forward by the specified number of bytes. 
 Returns the previous write pointer */
 uint16_t EVE_Cmd_moveWp(EVE_HalContext *phost, uint16_t bytes);
@@ -0,0 +1,403 @@
+/**
+* This source code ("the Software") is provided by Bridgetek Pte Ltd
+* ("Bridgetek") subject to the licence terms set out
+*   http://brtchip.com/BRTSourceCodeLicenseAgreement/ ("the Licence Terms").
+* You must read the Licence Terms before downloading or using the Software.
+* By installing or using the Software you agree to the Licence Terms. If you
+* do not agree to the Licence Terms then do not download or use the Software.
+*
+* Without prejudice to the Licence Terms, here is a summary of some of the key
+* terms of the Licence Terms (and in the event of any conflict between this
+* summary and the Licence Terms then the text of the Licence Terms will
+* prevail).
+*
+* The Software is provided "as is".
+* There are no warranties (or similar) in relation to the quality of the
+* Software. You use it at your own risk.
+* The Software should not be used in, or for, any medical device, system or
+* appliance. There are exclusions of Bridgetek liability for certain types of loss
+* such as: special loss or damage; incidental loss or damage; indirect or
+* consequential loss or damage; loss of income; loss of business; loss of
+* profits; loss of revenue; loss of contracts; business interruption; loss of
+* the use of money or anticipated savings; loss of information; loss of
+* opportunity; loss of goodwill or reputation; and/or loss of, damage to or
+* corruption of data.
+* There is a monetary cap on Bridgetek's liability.
+* The Software may have subsequently been amended by another user and then
+* distributed by that other user ("Adapted Software").  If so that user may
+* have additional licence terms that apply to those amendments. However, Bridgetek
+* has no liability in relation to those amendments.
+*/
+
+/*
+Header-only encoders for the fixed part of coprocessor commands.
+
+Each encoder packs the command into a fixed size word array, which is
+written with a single EVE_Cmd_wrMem, so a single space check and a
+single copy, instead of one EVE_Cmd_wr32 call per word.
+With constant arguments the encoded words are folded at compile time,
+under C++14 the encoders are constexpr.
+Variable length data, such as the string of CMD_TEXT, is written after.
+*/
+
+#ifndef EVE_CMD_ENCODE__H
+#define EVE_CMD_ENCODE__H
+#include "EVE_GpuDefs.h"
+
+#if defined(__cplusplus) && (__cplusplus >= 201402L)
+#define EVE_CMD_ENCODER static constexpr inline
+#else
+#define EVE_CMD_ENCODER static inline
+#endif
+
+/* Pack two 16-bit arguments into one word, the first argument in the low half */
+#define EVE_CMD_PACK16(lo, hi) ((((uint32_t)(uint16_t)(hi)) << 16) | ((uint32_t)(uint16_t)(lo)))
+
+typedef struct EVE_CmdWords2
+{
+	uint32_t Words[2];
+} EVE_CmdWords2;
+
+typedef struct EVE_CmdWords3
+{
+	uint32_t Words[3];
+} EVE_CmdWords3;
+
+typedef struct EVE_CmdWords4
+{
+	uint32_t Words[4];
+} EVE_CmdWords4;
+
+typedef struct EVE_CmdWords5
+{
+	uint32_t Words[5];
+} EVE_CmdWords5;
+
+typedef struct EVE_CmdWords14
+{
+	uint32_t Words[14];
+} EVE_CmdWords14;
+
+/* Write an encoded command to the command buffer.
+Returns false in case a coprocessor fault occurred */
+#define EVE_Cmd_wrEncoded(phost, encoded) EVE_Cmd_wrMem((phost), (const uint8_t *)(encoded).Words, sizeof((encoded).Words))
+
+/* CMD_GRADIENT, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encGradient(int16_t x0, int16_t y0, uint32_t rgb0, int16_t x1, int16_t y1, uint32_t rgb1)
+{
+	EVE_CmdWords5 res = { {
+		CMD_GRADIENT,
+		EVE_CMD_PACK16(x0, y0),
+		rgb0,
+		EVE_CMD_PACK16(x1, y1),
+		rgb1,
+	} };
+	return res;
+}
+
+/* CMD_TEXT, followed by the string */
+EVE_CMD_ENCODER EVE_CmdWords3 EVE_CoCmd_encText(int16_t x, int16_t y, int16_t font, uint16_t options)
+{
+	EVE_CmdWords3 res = { {
+		CMD_TEXT,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(font, options),
+	} };
+	return res;
+}
+
+/* CMD_BUTTON, followed by the string */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_encButton(int16_t x, int16_t y, int16_t w, int16_t h, int16_t font, uint16_t options)
+{
+	EVE_CmdWords4 res = { {
+		CMD_BUTTON,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+		EVE_CMD_PACK16(font, options),
+	} };
+	return res;
+}
+
+/* CMD_KEYS, followed by the string */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_encKeys(int16_t x, int16_t y, int16_t w, int16_t h, int16_t font, uint16_t options)
+{
+	EVE_CmdWords4 res = { {
+		CMD_KEYS,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+		EVE_CMD_PACK16(font, options),
+	} };
+	return res;
+}
+
+/* CMD_TOGGLE, followed by the string */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_encToggle(int16_t x, int16_t y, int16_t w, int16_t font, uint16_t options, uint16_t state)
+{
+	EVE_CmdWords4 res = { {
+		CMD_TOGGLE,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, font),
+		EVE_CMD_PACK16(options, state),
+	} };
+	return res;
+}
+
+/* CMD_NUMBER, complete */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_encNumber(int16_t x, int16_t y, int16_t font, uint16_t options, int32_t n)
+{
+	EVE_CmdWords4 res = { {
+		CMD_NUMBER,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(font, options),
+		(uint32_t)n,
+	} };
+	return res;
+}
+
+/* CMD_SPINNER, complete */
+EVE_CMD_ENCODER EVE_CmdWords3 EVE_CoCmd_encSpinner(int16_t x, int16_t y, uint16_t style, uint16_t scale)
+{
+	EVE_CmdWords3 res = { {
+		CMD_SPINNER,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(style, scale),
+	} };
+	return res;
+}
+
+/* CMD_SLIDER, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encSlider(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t options, uint16_t val, uint16_t range)
+{
+	EVE_CmdWords5 res = { {
+		CMD_SLIDER,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+		EVE_CMD_PACK16(options, val),
+		range,
+	} };
+	return res;
+}
+
+/* CMD_PROGRESS, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encProgress(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t options, uint16_t val, uint16_t range)
+{
+	EVE_CmdWords5 res = { {
+		CMD_PROGRESS,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+		EVE_CMD_PACK16(options, val),
+		range,
+	} };
+	return res;
+}
+
+/* CMD_SCROLLBAR, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encScrollbar(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t options, uint16_t val, uint16_t size, uint16_t range)
+{
+	EVE_CmdWords5 res = { {
+		CMD_SCROLLBAR,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+		EVE_CMD_PACK16(options, val),
+		EVE_CMD_PACK16(size, range),
+	} };
+	return res;
+}
+
+/* CMD_DIAL, complete */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_encDial(int16_t x, int16_t y, int16_t r, uint16_t options, uint16_t val)
+{
+	EVE_CmdWords4 res = { {
+		CMD_DIAL,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(r, options),
+		val,
+	} };
+	return res;
+}
+
+/* CMD_GAUGE, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encGauge(int16_t x, int16_t y, int16_t r, uint16_t options, uint16_t major, uint16_t minor, uint16_t val, uint16_t range)
+{
+	EVE_CmdWords5 res = { {
+		CMD_GAUGE,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(r, options),
+		EVE_CMD_PACK16(major, minor),
+		EVE_CMD_PACK16(val, range),
+	} };
+	return res;
+}
+
+/* CMD_CLOCK, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encClock(int16_t x, int16_t y, int16_t r, uint16_t options, uint16_t h, uint16_t m, uint16_t s, uint16_t ms)
+{
+	EVE_CmdWords5 res = { {
+		CMD_CLOCK,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(r, options),
+		EVE_CMD_PACK16(h, m),
+		EVE_CMD_PACK16(s, ms),
+	} };
+	return res;
+}
+
+/* CMD_TRACK, complete. The tag is sign extended to a full word */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_encTrack(int16_t x, int16_t y, int16_t w, int16_t h, int16_t tag)
+{
+	EVE_CmdWords4 res = { {
+		CMD_TRACK,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+		(uint32_t)(int32_t)tag,
+	} };
+	return res;
+}
+
+/* CMD_SKETCH, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encSketch(int16_t x, int16_t y, uint16_t w, uint16_t h, uint32_t ptr, uint16_t format)
+{
+	EVE_CmdWords5 res = { {
+		CMD_SKETCH,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+		ptr,
+		format,
+	} };
+	return res;
+}
+
+#if (EVE_MODEL == EVE_FT801)
+/* CMD_CSKETCH, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encCSketch(int16_t x, int16_t y, uint16_t w, uint16_t h, uint32_t ptr, uint16_t format, uint16_t freq)
+{
+	EVE_CmdWords5 res = { {
+		CMD_CSKETCH,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+		ptr,
+		EVE_CMD_PACK16(format, freq),
+	} };
+	return res;
+}
+#endif
+
+/* Commands with a single word argument, complete.
+For CMD_FGCOLOR, CMD_BGCOLOR, CMD_GRADCOLOR, CMD_ROTATE, CMD_SETROTATE,
+CMD_SETBASE, CMD_SETSCRATCH, CMD_PLAYVIDEO, CMD_INTERRUPT, CMD_INFLATE,
+CMD_SNAPSHOT, CMD_INT_RAMSHARED, CMD_ANIMSTOP and CMD_ANIMDRAW */
+EVE_CMD_ENCODER EVE_CmdWords2 EVE_CoCmd_enc1(uint32_t cmd, uint32_t a)
+{
+	EVE_CmdWords2 res = { {
+		cmd,
+		a,
+	} };
+	return res;
+}
+
+/* Commands with two word arguments, complete.
+For CMD_TRANSLATE, CMD_SCALE, CMD_SETFONT, CMD_ROMFONT, CMD_APPEND,
+CMD_VIDEOFRAME, CMD_MEMZERO, CMD_MEMWRITE (followed by the data),
+CMD_LOADIMAGE, CMD_MEDIAFIFO and CMD_INT_SWLOADIMAGE */
+EVE_CMD_ENCODER EVE_CmdWords3 EVE_CoCmd_enc2(uint32_t cmd, uint32_t a, uint32_t b)
+{
+	EVE_CmdWords3 res = { {
+		cmd,
+		a,
+		b,
+	} };
+	return res;
+}
+
+/* Commands with three word arguments, complete.
+For CMD_SETFONT2, CMD_MEMCPY, CMD_MEMSET, CMD_FLASHREAD and CMD_ANIMSTART */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_enc3(uint32_t cmd, uint32_t a, uint32_t b, uint32_t c)
+{
+	EVE_CmdWords4 res = { {
+		cmd,
+		a,
+		b,
+		c,
+	} };
+	return res;
+}
+
+#if (EVE_MODEL >= EVE_FT810)
+/* CMD_SETBITMAP, complete */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_encSetBitmap(uint32_t source, uint16_t fmt, uint16_t w, uint16_t h)
+{
+	EVE_CmdWords4 res = { {
+		CMD_SETBITMAP,
+		source,
+		EVE_CMD_PACK16(fmt, w),
+		h,
+	} };
+	return res;
+}
+
+/* CMD_SNAPSHOT2, complete */
+EVE_CMD_ENCODER EVE_CmdWords5 EVE_CoCmd_encSnapshot2(uint32_t fmt, uint32_t ptr, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	EVE_CmdWords5 res = { {
+		CMD_SNAPSHOT2,
+		fmt,
+		ptr,
+		EVE_CMD_PACK16(x, y),
+		EVE_CMD_PACK16(w, h),
+	} };
+	return res;
+}
+
+#endif
+
+#if (EVE_MODEL >= EVE_BT815)
+/* CMD_ANIMXY, complete */
+EVE_CMD_ENCODER EVE_CmdWords3 EVE_CoCmd_encAnimXY(int32_t ch, int16_t x, int16_t y)
+{
+	EVE_CmdWords3 res = { {
+		CMD_ANIMXY,
+		(uint32_t)ch,
+		EVE_CMD_PACK16(x, y),
+	} };
+	return res;
+}
+
+/* CMD_ANIMFRAME, complete */
+EVE_CMD_ENCODER EVE_CmdWords4 EVE_CoCmd_encAnimFrame(int16_t x, int16_t y, uint32_t aoptr, uint32_t frame)
+{
+	EVE_CmdWords4 res = { {
+		CMD_ANIMFRAME,
+		EVE_CMD_PACK16(x, y),
+		aoptr,
+		frame,
+	} };
+	return res;
+}
+
+#endif
+
+/* CMD_BITMAP_TRANSFORM and CMD_TOUCH_TRANSFORM, complete */
+EVE_CMD_ENCODER EVE_CmdWords14 EVE_CoCmd_encTransform(uint32_t cmd, int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t tx0, int32_t ty0, int32_t tx1, int32_t ty1, int32_t tx2, int32_t ty2, uint16_t result)
+{
+	EVE_CmdWords14 res = { {
+		cmd,
+		(uint32_t)x0,
+		(uint32_t)y0,
+		(uint32_t)x1,
+		(uint32_t)y1,
+		(uint32_t)x2,
+		(uint32_t)y2,
+		(uint32_t)tx0,
+		(uint32_t)ty0,
+		(uint32_t)tx1,
+		(uint32_t)ty1,
+		(uint32_t)tx2,
+		(uint32_t)ty2,
+		result,
+	} };
+	return res;
+}
+
+#endif /* #ifndef EVE_CMD_ENCODE__H */
+
+/* end of file */
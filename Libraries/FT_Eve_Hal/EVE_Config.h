@@ -680,6 +680,16 @@ typedef eve_progmem uint16_t eve_prog_uint16_t;
 #define BUFFER_OPTIMIZATION
 #endif
 
+/* Define EVE_CMD_PEEPHOLE to hold back display list words written
+with EVE_Cmd_wrDl in a small window, where redundant words are removed
+before they are sent to the command buffer */
+#if defined(EVE_CMD_PEEPHOLE) && !defined(EVE_CMD_PEEPHOLE_SIZE)
+#define EVE_CMD_PEEPHOLE_SIZE 16
+#endif
+#if defined(EVE_CMD_PEEPHOLE) && (EVE_CMD_PEEPHOLE_SIZE > 255)
+#error EVE_CMD_PEEPHOLE_SIZE does not fit in the CmdDlNb counter
+#endif
+
 /* Disable unsupported options */
 #if defined(ENABLE_ILI9488_HVGA_PORTRAIT) && !defined(FT9XX_PLATFORM)
 #undef ENABLE_ILI9488_HVGA_PORTRAIT
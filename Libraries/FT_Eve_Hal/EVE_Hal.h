@@ -175,6 +175,19 @@ typedef struct EVE_HalContext
 	bool CmdFault; /* Flagged when coprocessor is in fault mode and needs to be reset */
 	bool CmdWaiting; /* Flagged while waiting for CMD write (to check during any function that may be called by CbCmdWait) */
 
+	/* Called before anything else is written to the command buffer while set,
+	so display list content that was deferred by the caller gets written first.
+	Cleared before it is called */
+	EVE_Callback CbCmdDeferred;
+
+#if defined(EVE_CMD_PEEPHOLE)
+	/* Display list words held back by the peephole optimizer */
+	uint32_t CmdDl[EVE_CMD_PEEPHOLE_SIZE];
+	uint8_t CmdDlNb;
+	uint32_t CmdDlRemoved; /* Number of display list words removed by the peephole optimizer */
+	uint32_t CmdDlRewritten; /* Number of VERTEX2F words rewritten as VERTEX2II by the peephole optimizer */
+#endif
+
 } EVE_HalContext;
 
 typedef struct EVE_HalPlatform
@@ -29,6 +29,9 @@
 * has no liability in relation to those amendments.
 */
 
+#ifndef EVE_LOADFILE__H
+#define EVE_LOADFILE__H
+
 #include "EVE_Platform.h"
 
 /* Load SD card */
@@ -41,4 +44,78 @@ bool EVE_Util_loadInflateFile(EVE_HalContext *phost, uint32_t address, const cha
 The image format is provided as output to the optional format argument */
 bool EVE_Util_loadImageFile(EVE_HalContext *phost, uint32_t address, const char *filename, uint32_t *format);
 
+/* Asset pack, a single file containing all assets with an index at the front, see Tools/eve_pack.py to build one.
+While a pack is open, files are loaded from the pack when it contains them, without opening any other file.
+All values are little endian. The entries are sorted by the hash of their name */
+#define EVE_PACK_MAGIC 0x50455645UL /* "EVEP" */
+#define EVE_PACK_VERSION 1
+
+/* Compression of a pack entry, or the loading mechanism of a file */
+#define EVE_PACK_RAW 0
+#define EVE_PACK_DEFLATE 1
+#define EVE_PACK_IMAGE 2
+
+typedef struct
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t NbEntries;
+	uint32_t Reserved;
+} EVE_PackHeader;
+
+typedef struct
+{
+	uint32_t NameHash; /* FNV-1a hash of the file name */
+	uint32_t NameOffset; /* Offset of the null terminated file name in the pack */
+	uint32_t Offset; /* Offset of the data in the pack, aligned to 4 bytes */
+	uint32_t Size; /* Size of the data in the pack */
+	uint32_t RawSize; /* Size of the data once loaded into RAM_G, 0 if unknown */
+	uint32_t Format; /* Bitmap format, 0 if not a bitmap */
+	uint32_t Compression; /* EVE_PACK_RAW, EVE_PACK_DEFLATE or EVE_PACK_IMAGE */
+	uint32_t Crc; /* CRC-32 of the data in the pack, checked when the pack is opened if EVE_PACK_VERIFY is set */
+} EVE_PackEntry;
+
+#if !defined(FT9XX_PLATFORM)
+
+/* Open an asset pack, replacing the currently open pack */
+bool EVE_Util_openPack(const char *filename);
+void EVE_Util_closePack();
+
+/* Called before the pack is closed or replaced while its data is mapped, so that pointers
+returned by EVE_Util_packData can be dropped. Only one callback can be set */
+typedef void (*EVE_PackCloseCallback)();
+void EVE_Util_setPackCloseCallback(EVE_PackCloseCallback callback);
+
+/* Hash of a file name as used in the pack */
+uint32_t EVE_Util_hashName(const char *filename);
+
+/* Find a file in the open pack, returns NULL if there is no pack or the file is not in the pack */
+const EVE_PackEntry *EVE_Util_findPackEntry(const char *filename);
+
+/* Data of an entry when the pack is memory mapped, NULL otherwise */
+const uint8_t *EVE_Util_packData(const EVE_PackEntry *entry);
+
+/* Load an entry of the open pack, using the compression of the entry */
+bool EVE_Util_loadPackEntry(EVE_HalContext *phost, uint32_t address, const EVE_PackEntry *entry, uint32_t *format);
+
+/* A pack may store a file both raw and deflated, see eve_pack.py --both. The other form is stored under
+the file name followed by this suffix, and the form which loads fastest on the target is used */
+#define EVE_PACK_ALTERNATE "#"
+
+/* Record how long a load took. The throughput of writing to RAM_G and of CMD_INFLATE are measured
+separately. The raw size of deflated data must be known, otherwise the load is not recorded */
+void EVE_Util_measureLoad(uint32_t compression, uint32_t size, uint32_t rawSize, uint32_t ms);
+
+/* Pick the form of a pack entry which loads fastest, based on the throughput measured so far.
+Returns the entry itself when it has no other form, or when nothing has been measured yet */
+const EVE_PackEntry *EVE_Util_preferPackEntry(const EVE_PackEntry *entry);
+
+/* Measure the throughput on the target, by loading the largest raw and deflated entries of the open pack
+which fit in the given area of RAM_G a few times. Returns false if nothing could be loaded */
+bool EVE_Util_benchmarkPack(EVE_HalContext *phost, uint32_t address, uint32_t size);
+
+#endif
+
+#endif /* #ifndef EVE_LOADFILE__H */
+
 /* end of file */
@@ -34,24 +34,272 @@
 #if !defined(FT9XX_PLATFORM)
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-bool EVE_Util_loadSdCard(EVE_HalContext *phost)
+/* Map files into memory, so they are written to the transport without copying.
+Falls back to stdio when the file cannot be mapped */
+#ifndef EVE_LOADFILE_MMAP
+#if defined(_WIN32) || defined(__unix__)
+#define EVE_LOADFILE_MMAP 1
+#else
+#define EVE_LOADFILE_MMAP 0
+#endif
+#endif
+
+/* Check the CRC of every entry when a pack is opened, which reads the whole pack */
+#ifndef EVE_PACK_VERIFY
+#if defined(_DEBUG)
+#define EVE_PACK_VERIFY 1
+#else
+#define EVE_PACK_VERIFY 0
+#endif
+#endif
+
+#if EVE_LOADFILE_MMAP
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+typedef struct
 {
-	/* no-op */
+	const uint8_t *Data;
+	uint32_t Size;
+#if defined(_WIN32)
+	HANDLE File;
+	HANDLE Mapping;
+#endif
+} EVE_MappedFile;
+
+static bool mapFile(EVE_MappedFile *map, const char *filename)
+{
+#if defined(_WIN32)
+	LARGE_INTEGER size;
+	map->Data = NULL;
+	map->Mapping = NULL;
+	map->File = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (map->File == INVALID_HANDLE_VALUE)
+		return false;
+	if (GetFileSizeEx(map->File, &size) && size.QuadPart > 0 && size.QuadPart <= UINT32_MAX)
+	{
+		map->Size = (uint32_t)size.QuadPart;
+		map->Mapping = CreateFileMappingA(map->File, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (map->Mapping)
+			map->Data = MapViewOfFile(map->Mapping, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (!map->Data)
+	{
+		if (map->Mapping)
+			CloseHandle(map->Mapping);
+		CloseHandle(map->File);
+		return false;
+	}
+	return true;
+#else
+	struct stat st;
+	void *data = MAP_FAILED;
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		return false;
+	if (!fstat(fd, &st) && st.st_size > 0 && (uint64_t)st.st_size <= UINT32_MAX)
+	{
+		map->Size = (uint32_t)st.st_size;
+		data = mmap(NULL, map->Size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd); /* The mapping remains valid */
+	if (data == MAP_FAILED)
+		return false;
+	madvise(data, map->Size, MADV_SEQUENTIAL);
+	map->Data = data;
 	return true;
+#endif
 }
 
-bool EVE_Util_loadRawFile(EVE_HalContext *phost, uint32_t address, const char *filename)
+static void unmapFile(EVE_MappedFile *map)
+{
+#if defined(_WIN32)
+	UnmapViewOfFile(map->Data);
+	CloseHandle(map->Mapping);
+	CloseHandle(map->File);
+#else
+	munmap((void *)map->Data, map->Size);
+#endif
+}
+
+#endif
+
+/* Write the command which receives the data, for inflate and image loading */
+static bool loadBegin(EVE_HalContext *phost, uint32_t address, uint32_t mode)
+{
+	if (mode == EVE_PACK_RAW)
+		return true;
+	if (!EVE_Cmd_waitSpace(phost, 12))
+		return false;
+	if (mode == EVE_PACK_DEFLATE)
+	{
+		EVE_Cmd_wr32(phost, CMD_INFLATE);
+		EVE_Cmd_wr32(phost, address);
+	}
+	else
+	{
+		EVE_Cmd_wr32(phost, CMD_LOADIMAGE);
+		EVE_Cmd_wr32(phost, address);
+		EVE_Cmd_wr32(phost, OPT_NODL);
+		// TODO: Let it write into the scratch display list handle,
+		//  and read it out and write into the bitmapInfo the proper
+		//  values to use. Replace compressed bool with uint8 enum to
+		//  specify the loading mechanism
+	}
+	return true;
+}
+
+static bool loadEnd(EVE_HalContext *phost, uint32_t mode, uint32_t *format)
+{
+	if (mode == EVE_PACK_RAW)
+		return true;
+	if (!EVE_Cmd_waitFlush(phost))
+		return false;
+	if (mode == EVE_PACK_IMAGE && format)
+		*format = EVE_Hal_rd32(phost, 0x3097e8);
+	return true;
+}
+
+/* Load data from memory. Command data is padded to 4 bytes,
+the tail is copied since reading past the end of a mapping may fault */
+static bool loadSpan(EVE_HalContext *phost, uint32_t address, const uint8_t *data, uint32_t size, uint32_t mode, uint32_t *format)
+{
+	uint32_t body = size & ~3UL;
+	uint32_t tail = size & 3UL;
+	uint8_t pad[4] = { 0 };
+
+	if (mode == EVE_PACK_RAW)
+	{
+		EVE_Hal_wrMem(phost, address, data, size);
+		return true;
+	}
+
+	if (!loadBegin(phost, address, mode))
+		return false;
+	if (body && !EVE_Cmd_wrMem(phost, data, body))
+		return false;
+	if (tail)
+	{
+		memcpy(pad, data + body, tail);
+		if (!EVE_Cmd_wrMem(phost, pad, 4))
+			return false;
+	}
+	return loadEnd(phost, mode, format);
+}
+
+/* Load data from the current position of a file, through a buffer */
+static bool loadStream(EVE_HalContext *phost, uint32_t address, FILE *afile, uint32_t size, uint32_t mode, uint32_t *format)
 {
-	FILE *afile;
-	uint32_t ftsize = 0;
 	uint8_t pbuff[8192];
 	uint16_t blocklen;
 	uint32_t addr = address;
 
+	if (!loadBegin(phost, address, mode))
+		return false;
+	while (size > 0)
+	{
+		blocklen = size > 8192 ? 8192 : size;
+		if (fread(pbuff, 1, blocklen, afile) != blocklen) /* copy the data into pbuff and then transfer it */
+			return false;
+		size -= blocklen;
+		if (mode == EVE_PACK_RAW)
+		{
+			EVE_Hal_wrMem(phost, addr, pbuff, blocklen);
+			addr += blocklen;
+		}
+		else
+		{
+			memset(&pbuff[blocklen], 0, (4 - (blocklen & 3)) & 3); /* zero the padding of the last block */
+			blocklen += 3;
+			blocklen -= blocklen % 4;
+			if (!EVE_Cmd_wrMem(phost, pbuff, blocklen))
+				return false;
+		}
+	}
+	return loadEnd(phost, mode, format);
+}
+
+/* The open asset pack */
+static FILE *s_PackFile;
+#if EVE_LOADFILE_MMAP
+static EVE_MappedFile s_PackMap;
+#endif
+static const uint8_t *s_PackData;
+static uint32_t s_PackSize;
+static EVE_PackEntry *s_PackEntries;
+static uint32_t s_PackNbEntries;
+static char *s_PackNames; /* Copy of the names, which follow the index */
+static uint32_t s_PackNamesOffset;
+static EVE_PackCloseCallback s_PackCloseCallback;
+
+/* Total bytes and time of the loads so far. Writing to RAM_G is counted in bytes sent,
+CMD_INFLATE in bytes inflated */
+static uint32_t s_BusBytes;
+static uint32_t s_BusMs;
+static uint32_t s_InflateBytes;
+static uint32_t s_InflateMs;
+
+static bool loadPack(EVE_HalContext *phost, uint32_t address, const EVE_PackEntry *entry, uint32_t mode, uint32_t *format)
+{
+	uint32_t start = EVE_millis();
+	bool res;
+
+	if (s_PackData)
+		res = loadSpan(phost, address, s_PackData + entry->Offset, entry->Size, mode, format);
+	else
+		res = !fseek(s_PackFile, entry->Offset, SEEK_SET)
+		    && loadStream(phost, address, s_PackFile, entry->Size, mode, format);
+
+	if (res && mode != EVE_PACK_IMAGE)
+		EVE_Util_measureLoad(mode, entry->Size, entry->RawSize, EVE_millis() - start);
+	return res;
+}
+
+static bool loadFile(EVE_HalContext *phost, uint32_t address, const char *filename, uint32_t mode, uint32_t *format)
+{
+	const EVE_PackEntry *entry;
+	FILE *afile;
+	uint32_t ftsize;
+	bool res;
+
+	/* Files in the open pack do not need to be opened */
+	entry = EVE_Util_findPackEntry(filename);
+	if (entry)
+	{
+		/* Use the other form of the entry if it loads faster */
+		if (mode != EVE_PACK_IMAGE)
+		{
+			const EVE_PackEntry *preferred = EVE_Util_preferPackEntry(entry);
+			if (preferred != entry)
+			{
+				entry = preferred;
+				mode = preferred->Compression;
+			}
+		}
+		return loadPack(phost, address, entry, mode, format);
+	}
+
+#if EVE_LOADFILE_MMAP
+	EVE_MappedFile map;
+	if (mapFile(&map, filename))
+	{
+		res = loadSpan(phost, address, map.Data, map.Size, mode, format);
+		unmapFile(&map);
+		return res;
+	}
+#endif
+
 #pragma warning(push)
 #pragma warning(disable : 4996)
-	afile = fopen(filename, "rb");
+	afile = fopen(filename, "rb"); // read Binary (rb)
 #pragma warning(pop)
 	if (afile == NULL)
 	{
@@ -61,105 +309,379 @@ bool EVE_Util_loadRawFile(EVE_HalContext *phost, uint32_t address, const char *f
 	fseek(afile, 0, SEEK_END);
 	ftsize = ftell(afile);
 	fseek(afile, 0, SEEK_SET);
-	while (ftsize > 0)
-	{
-		blocklen = ftsize > 8192 ? 8192 : ftsize;
-		fread(pbuff, 1, blocklen, afile);
-		ftsize -= blocklen;
-		EVE_Hal_wrMem(phost, addr, pbuff, blocklen);
-		addr += blocklen;
-	}
+	res = loadStream(phost, address, afile, ftsize, mode, format);
 	fclose(afile);
+	return res;
+}
 
+bool EVE_Util_loadSdCard(EVE_HalContext *phost)
+{
+	/* no-op */
 	return true;
 }
 
+bool EVE_Util_loadRawFile(EVE_HalContext *phost, uint32_t address, const char *filename)
+{
+	return loadFile(phost, address, filename, EVE_PACK_RAW, NULL);
+}
+
 bool EVE_Util_loadInflateFile(EVE_HalContext *phost, uint32_t address, const char *filename)
 {
-	FILE *afile;
-	uint32_t ftsize = 0;
-	uint8_t pbuff[8192];
-	uint16_t blocklen;
+	return loadFile(phost, address, filename, EVE_PACK_DEFLATE, NULL);
+}
+
+bool EVE_Util_loadImageFile(EVE_HalContext *phost, uint32_t address, const char *filename, uint32_t *format)
+{
+	return loadFile(phost, address, filename, EVE_PACK_IMAGE, format);
+}
+
+#if EVE_PACK_VERIFY
+
+/* CRC-32, as zlib.crc32 used by eve_pack.py */
+static uint32_t crc32Update(uint32_t crc, const uint8_t *data, uint32_t size)
+{
+	while (size--)
+	{
+		int bit;
+		crc ^= *data++;
+		for (bit = 0; bit < 8; ++bit)
+			crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+	}
+	return crc;
+}
+
+static bool verifyEntry(const EVE_PackEntry *entry)
+{
+	uint32_t crc = 0xFFFFFFFFUL;
+	if (s_PackData)
+	{
+		crc = crc32Update(crc, s_PackData + entry->Offset, entry->Size);
+	}
+	else
+	{
+		uint8_t buffer[1024];
+		uint32_t remaining = entry->Size;
+		if (fseek(s_PackFile, entry->Offset, SEEK_SET))
+			return false;
+		while (remaining)
+		{
+			uint32_t part = min(remaining, (uint32_t)sizeof(buffer));
+			if (fread(buffer, 1, part, s_PackFile) != part)
+				return false;
+			crc = crc32Update(crc, buffer, part);
+			remaining -= part;
+		}
+	}
+	return ~crc == entry->Crc;
+}
+
+#endif
+
+/* Check that the data and the name of every entry are inside the pack, and copy the names */
+static bool validatePack()
+{
+	uint32_t namesEnd = s_PackSize;
+	uint32_t i;
+
+	for (i = 0; i < s_PackNbEntries; ++i)
+	{
+		const EVE_PackEntry *entry = &s_PackEntries[i];
+		if (entry->Offset < s_PackNamesOffset || entry->Offset > s_PackSize || entry->Size > s_PackSize - entry->Offset)
+			return false;
+		if (entry->Offset < namesEnd)
+			namesEnd = entry->Offset;
+	}
+	for (i = 0; i < s_PackNbEntries; ++i)
+	{
+		if (s_PackEntries[i].NameOffset < s_PackNamesOffset || s_PackEntries[i].NameOffset >= namesEnd)
+			return false;
+	}
 
-	if (!EVE_Cmd_waitSpace(phost, 8))
-		return false; // Space for CMD_INFLATE
+	/* The names are null terminated, the last one before the data */
+	if (s_PackNbEntries)
+	{
+		uint32_t size = namesEnd - s_PackNamesOffset;
+		s_PackNames = malloc(size);
+		if (!s_PackNames)
+			return false;
+		if (s_PackData)
+			memcpy(s_PackNames, s_PackData + s_PackNamesOffset, size);
+		else if (fseek(s_PackFile, s_PackNamesOffset, SEEK_SET) || fread(s_PackNames, size, 1, s_PackFile) != 1)
+			return false;
+		if (s_PackNames[size - 1])
+			return false;
+	}
+
+#if EVE_PACK_VERIFY
+	for (i = 0; i < s_PackNbEntries; ++i)
+	{
+		if (!verifyEntry(&s_PackEntries[i]))
+		{
+			eve_printf_debug("Pack entry does not match its CRC: %s\n", s_PackNames + (s_PackEntries[i].NameOffset - s_PackNamesOffset));
+			return false;
+		}
+	}
+#endif
+
+	return true;
+}
+
+bool EVE_Util_openPack(const char *filename)
+{
+	EVE_PackHeader header;
+	uint32_t size;
 
+	EVE_Util_closePack();
+
+#if EVE_LOADFILE_MMAP
+	if (mapFile(&s_PackMap, filename))
+	{
+		if (s_PackMap.Size < sizeof(EVE_PackHeader))
+		{
+			unmapFile(&s_PackMap);
+			return false;
+		}
+		s_PackData = s_PackMap.Data;
+		s_PackSize = s_PackMap.Size;
+		memcpy(&header, s_PackData, sizeof(EVE_PackHeader));
+	}
+	else
+#endif
+	{
 #pragma warning(push)
 #pragma warning(disable : 4996)
-	afile = fopen(filename, "rb"); // read Binary (rb)
+		s_PackFile = fopen(filename, "rb");
 #pragma warning(pop)
-	if (afile == NULL)
+		if (s_PackFile && !fseek(s_PackFile, 0, SEEK_END))
+		{
+			s_PackSize = (uint32_t)ftell(s_PackFile);
+			fseek(s_PackFile, 0, SEEK_SET);
+		}
+		if (!s_PackFile || fread(&header, sizeof(EVE_PackHeader), 1, s_PackFile) != 1)
+		{
+			eve_printf_debug("Unable to open pack: %s\n", filename);
+			EVE_Util_closePack();
+			return false;
+		}
+	}
+
+	if (header.Magic != EVE_PACK_MAGIC || header.Version != EVE_PACK_VERSION)
 	{
-		eve_printf_debug("Unable to open: %s\n", filename);
+		eve_printf_debug("Not a valid pack: %s\n", filename);
+		EVE_Util_closePack();
 		return false;
 	}
-	EVE_Cmd_wr32(phost, CMD_INFLATE);
-	EVE_Cmd_wr32(phost, address);
-	fseek(afile, 0, SEEK_END);
-	ftsize = ftell(afile);
-	fseek(afile, 0, SEEK_SET);
-	while (ftsize > 0)
+
+	/* The index is copied, so it is aligned even when the pack is not mapped */
+	if (header.NbEntries > (s_PackSize - sizeof(EVE_PackHeader)) / sizeof(EVE_PackEntry))
+	{
+		eve_printf_debug("Invalid pack index: %s\n", filename);
+		EVE_Util_closePack();
+		return false;
+	}
+	size = header.NbEntries * sizeof(EVE_PackEntry);
+	s_PackEntries = size ? malloc(size) : NULL;
+	if (size && (!s_PackEntries || (!s_PackData && fread(s_PackEntries, size, 1, s_PackFile) != 1)))
 	{
-		blocklen = ftsize > 8192 ? 8192 : ftsize;
-		fread(pbuff, 1, blocklen, afile); /* copy the data into pbuff and then transfter it to command buffer */
-		ftsize -= blocklen;
+		eve_printf_debug("Invalid pack index: %s\n", filename);
+		EVE_Util_closePack();
+		return false;
+	}
+	if (s_PackData && size)
+		memcpy(s_PackEntries, s_PackData + sizeof(EVE_PackHeader), size);
+	s_PackNbEntries = header.NbEntries;
+	s_PackNamesOffset = sizeof(EVE_PackHeader) + size;
 
-		if (!EVE_Cmd_wrMem(phost, (char *)pbuff, blocklen)) /* copy data continuously into command memory */
-			break;
+	if (!validatePack())
+	{
+		eve_printf_debug("Invalid pack entries: %s\n", filename);
+		EVE_Util_closePack();
+		return false;
 	}
 
-	fclose(afile); /* close the opened compressed file */
+	eve_printf_debug("Opened pack %s, %i entries\n", filename, (int)s_PackNbEntries);
+	return true;
+}
+
+void EVE_Util_closePack()
+{
+	/* Let the users of the mapped data drop their pointers first */
+	if (s_PackData && s_PackCloseCallback)
+		s_PackCloseCallback();
 
-	return EVE_Cmd_waitFlush(phost);
+#if EVE_LOADFILE_MMAP
+	if (s_PackData)
+		unmapFile(&s_PackMap);
+#endif
+	if (s_PackFile)
+		fclose(s_PackFile);
+	free(s_PackEntries);
+	free(s_PackNames);
+	s_PackFile = NULL;
+	s_PackData = NULL;
+	s_PackSize = 0;
+	s_PackEntries = NULL;
+	s_PackNbEntries = 0;
+	s_PackNames = NULL;
+	s_PackNamesOffset = 0;
 }
 
-bool EVE_Util_loadImageFile(EVE_HalContext *phost, uint32_t address, const char *filename, uint32_t *format)
+void EVE_Util_setPackCloseCallback(EVE_PackCloseCallback callback)
 {
-	FILE *afile;
-	uint32_t ftsize = 0;
-	uint8_t pbuff[8192];
-	uint16_t blocklen;
+	s_PackCloseCallback = callback;
+}
 
-#pragma warning(push)
-#pragma warning(disable : 4996)
-	afile = fopen(filename, "rb"); // read Binary (rb)
-#pragma warning(pop)
-	if (afile == NULL)
+uint32_t EVE_Util_hashName(const char *filename)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261UL;
+	while (*filename)
 	{
-		eve_printf_debug("Unable to open: %s\n", filename);
-		return 0;
-	}
-	EVE_Cmd_wr32(phost, CMD_LOADIMAGE);
-	EVE_Cmd_wr32(phost, address);
-	EVE_Cmd_wr32(phost, OPT_NODL);
-	// TODO: Let it write into the scratch display list handle,
-	//  and read it out and write into the bitmapInfo the proper
-	//  values to use. Replace compressed bool with uint8 enum to
-	//  specify the loading mechanism
-	fseek(afile, 0, SEEK_END);
-	ftsize = ftell(afile);
-	fseek(afile, 0, SEEK_SET);
-	while (ftsize > 0)
+		hash ^= (uint8_t)*filename++;
+		hash *= 16777619UL;
+	}
+	return hash;
+}
+
+/* Name of an entry, validated when the pack is opened */
+static const char *packName(const EVE_PackEntry *entry)
+{
+	return s_PackNames + (entry->NameOffset - s_PackNamesOffset);
+}
+
+/* Find the entry named by the file name followed by the suffix */
+static const EVE_PackEntry *findHash(uint32_t hash, const char *filename, const char *suffix)
+{
+	uint32_t low = 0;
+	uint32_t high = s_PackNbEntries;
+	const char *name;
+	size_t len;
+
+	/* The packer rejects hash collisions, but a file which is not in the pack may have the same hash */
+	while (low < high)
 	{
-		blocklen = ftsize > 8192 ? 8192 : ftsize;
-		fread(pbuff, 1, blocklen, afile); /* copy the data into pbuff and then transfter it to command buffer */
-		ftsize -= blocklen;
-		blocklen += 3;
-		blocklen -= blocklen % 4;
+		uint32_t mid = (low + high) >> 1;
+		if (s_PackEntries[mid].NameHash < hash)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	if (low >= s_PackNbEntries || s_PackEntries[low].NameHash != hash)
+		return NULL;
+	name = packName(&s_PackEntries[low]);
+	len = strlen(filename);
+	if (strncmp(name, filename, len) || strcmp(name + len, suffix))
+		return NULL;
+	return &s_PackEntries[low];
+}
+
+const EVE_PackEntry *EVE_Util_findPackEntry(const char *filename)
+{
+	if (!s_PackNbEntries || !filename)
+		return NULL;
+	return findHash(EVE_Util_hashName(filename), filename, "");
+}
 
-		if (!EVE_Cmd_wrMem(phost, (char *)pbuff, blocklen))
-			break;
+const uint8_t *EVE_Util_packData(const EVE_PackEntry *entry)
+{
+	return s_PackData ? (s_PackData + entry->Offset) : NULL;
+}
+
+bool EVE_Util_loadPackEntry(EVE_HalContext *phost, uint32_t address, const EVE_PackEntry *entry, uint32_t *format)
+{
+	return loadPack(phost, address, entry, entry->Compression, format);
+}
+
+void EVE_Util_measureLoad(uint32_t compression, uint32_t size, uint32_t rawSize, uint32_t ms)
+{
+	/* Halve the totals before they overflow, which also favours recent measurements */
+	if (s_BusBytes > 0x40000000UL || s_InflateBytes > 0x40000000UL)
+	{
+		s_BusBytes >>= 1;
+		s_BusMs >>= 1;
+		s_InflateBytes >>= 1;
+		s_InflateMs >>= 1;
 	}
 
-	fclose(afile); /* close the opened jpg file */
+	if (compression == EVE_PACK_RAW)
+	{
+		s_BusBytes += size;
+		s_BusMs += ms;
+	}
+	else if (compression == EVE_PACK_DEFLATE && rawSize)
+	{
+		s_InflateBytes += rawSize;
+		s_InflateMs += ms;
+	}
+}
 
-	if (!EVE_Cmd_waitFlush(phost))
-		return false;
+const EVE_PackEntry *EVE_Util_preferPackEntry(const EVE_PackEntry *entry)
+{
+	const EVE_PackEntry *other;
+	const EVE_PackEntry *raw;
+	const EVE_PackEntry *deflated;
+	double busMs, inflateMs, rawCost, sendCost, inflateCost;
+	const char *suffix;
+	uint32_t hash;
 
-	if (format)
-		*format = EVE_Hal_rd32(phost, 0x3097e8);
+	if (!entry || entry->Compression == EVE_PACK_IMAGE || !s_BusBytes || !s_InflateBytes)
+		return entry;
 
-	return true;
+	/* Continue the hash of the name with the suffix */
+	hash = entry->NameHash;
+	for (suffix = EVE_PACK_ALTERNATE; *suffix; ++suffix)
+	{
+		hash ^= (uint8_t)*suffix;
+		hash *= 16777619UL;
+	}
+	other = findHash(hash, packName(entry), EVE_PACK_ALTERNATE);
+	if (!other || other->Compression == entry->Compression || other->Compression == EVE_PACK_IMAGE)
+		return entry;
+
+	raw = (entry->Compression == EVE_PACK_RAW) ? entry : other;
+	deflated = (entry->Compression == EVE_PACK_RAW) ? other : entry;
+	if (!deflated->RawSize)
+		return entry;
+
+	/* Sending the deflated data and inflating it overlap through the command buffer, so the slowest of both counts */
+	busMs = (double)s_BusMs / s_BusBytes;
+	inflateMs = (double)s_InflateMs / s_InflateBytes;
+	rawCost = raw->Size * busMs;
+	sendCost = deflated->Size * busMs;
+	inflateCost = deflated->RawSize * inflateMs;
+	return (rawCost <= (sendCost > inflateCost ? sendCost : inflateCost)) ? raw : deflated;
+}
+
+bool EVE_Util_benchmarkPack(EVE_HalContext *phost, uint32_t address, uint32_t size)
+{
+	const EVE_PackEntry *raw = NULL;
+	const EVE_PackEntry *deflated = NULL;
+	uint32_t i;
+	int run;
+
+	for (i = 0; i < s_PackNbEntries; ++i)
+	{
+		const EVE_PackEntry *entry = &s_PackEntries[i];
+		if (entry->Compression == EVE_PACK_RAW && entry->Size <= size
+		    && (!raw || entry->Size > raw->Size))
+			raw = entry;
+		else if (entry->Compression == EVE_PACK_DEFLATE && entry->RawSize && entry->RawSize <= size
+		    && (!deflated || entry->RawSize > deflated->RawSize))
+			deflated = entry;
+	}
+
+	/* Load each a few times, a single load may be too short to time in milliseconds */
+	for (run = 0; run < 4; ++run)
+	{
+		if (raw && !loadPack(phost, address, raw, EVE_PACK_RAW, NULL))
+			return false;
+		if (deflated && !loadPack(phost, address, deflated, EVE_PACK_DEFLATE, NULL))
+			return false;
+	}
+
+	eve_printf_debug("Load throughput: %u bytes in %u ms raw, %u bytes in %u ms inflated\n",
+	    (unsigned int)s_BusBytes, (unsigned int)s_BusMs, (unsigned int)s_InflateBytes, (unsigned int)s_InflateMs);
+	return raw || deflated;
 }
 
 #endif
@@ -59,6 +59,7 @@ Main file to include the EVE HAL in your applications.
 #include "EVE_Hal.h"
 #include "EVE_Cmd.h"
 #include "EVE_GpuDefs.h"
+#include "EVE_CmdEncode.h"
 #if defined(ENABLE_ILI9488_HVGA_PORTRAIT) || defined(ENABLE_KD2401_HVGA_PORTRAIT)
 #include "EVE_ILI9488.h"
 #endif
@@ -362,6 +362,11 @@ bool EVE_Util_resetCoprocessor(EVE_HalContext *phost)
 	EVE_Hal_wr8(phost, REG_ROMSUB_SEL, 3);
 #endif
 
+#if defined(EVE_CMD_PEEPHOLE)
+	/* Drop display list words held back for the failed frame */
+	phost->CmdDlNb = 0;
+#endif
+
 	/* Refresh fifo */
 	EVE_Cmd_wp(phost);
 	EVE_Cmd_rp(phost);
@@ -168,6 +168,7 @@ static inline ft_void_t Ft_Gpu_Hal_RdCmdRpWp(EVE_HalContext *phost, ft_uint16_t
 /*******************************************************************************/
 
 #define Ft_Gpu_CoCmd_SendCmd EVE_Cmd_wr32
+#define Ft_Gpu_CoCmd_SendDl EVE_Cmd_wrDl
 inline static ft_void_t Ft_Gpu_CoCmd_SendCmdArr(EVE_HalContext *phost, ft_uint32_t *cmd, ft_size_t nb)
 {
 	EVE_Cmd_wrMem(phost, (uint8_t *)cmd, (uint32_t)nb * 4);
@@ -178,6 +179,7 @@ inline static ft_void_t Ft_Gpu_CoCmd_SendCmdArr(EVE_HalContext *phost, ft_uint32
 #define Ft_Gpu_CoCmd_EndFrame(phost) eve_noop()
 
 #define Eve_CoCmd_SendCmd Ft_Gpu_CoCmd_SendCmd
+#define Eve_CoCmd_SendDl Ft_Gpu_CoCmd_SendDl
 #define Eve_CoCmd_SendCmdArr Ft_Gpu_CoCmd_SendCmdArr
 #define Eve_CoCmd_SendStr Ft_Gpu_CoCmd_SendStr
 #define Eve_CoCmd_SendStr_S Ft_Gpu_CoCmd_SendStr_S
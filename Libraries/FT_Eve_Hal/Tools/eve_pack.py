@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""
+Build an asset pack for EVE_Util_openPack.
+
+Files are stored under their path relative to the root directory, using
+forward slashes, which must match the file names used by the application.
+JPEG and PNG files are marked as images, other files are stored as raw
+unless they are detected as deflated with --detect-deflate.
+
+With --both, other files are stored both raw and deflated, the second form
+under the file name followed by "#". The application then loads the form
+which is fastest on the target, see EVE_Util_preferPackEntry.
+
+Usage: eve_pack.py -o assets.pack [--root DIR] [--detect-deflate] [--both] FILE...
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+PACK_MAGIC = 0x50455645  # "EVEP"
+PACK_VERSION = 1
+
+PACK_RAW = 0
+PACK_DEFLATE = 1
+PACK_IMAGE = 2
+
+ALTERNATE = "#"
+
+HEADER = struct.Struct("<4I")
+ENTRY = struct.Struct("<8I")
+
+
+def hash_name(name):
+    """FNV-1a hash of the file name, as EVE_Util_hashName"""
+    h = 2166136261
+    for b in name.encode("utf-8"):
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def align(value):
+    return (value + 3) & ~3
+
+
+def classify(path, data, detect_deflate):
+    """Returns the compression and the size once loaded into RAM_G"""
+    ext = os.path.splitext(path)[1].lower()
+    if ext in (".jpg", ".jpeg", ".png"):
+        return PACK_IMAGE, 0
+    if detect_deflate and len(data) >= 2 and data[0] == 0x78 and ((data[0] << 8) | data[1]) % 31 == 0:
+        try:
+            return PACK_DEFLATE, len(zlib.decompress(data))
+        except zlib.error:
+            pass
+    return PACK_RAW, len(data)
+
+
+def alternate(data, compression, raw_size):
+    """Returns the other form of a raw or deflated file, or None if it is not worth storing"""
+    if compression == PACK_RAW:
+        deflated = zlib.compress(data, 9)
+        if len(deflated) < len(data):
+            return deflated, PACK_DEFLATE, raw_size
+    elif compression == PACK_DEFLATE:
+        return zlib.decompress(data), PACK_RAW, raw_size
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build an asset pack for EVE_Util_openPack")
+    parser.add_argument("-o", "--output", required=True, help="output pack file")
+    parser.add_argument("--root", default=".", help="directory the file names are relative to")
+    parser.add_argument("--detect-deflate", action="store_true", help="mark zlib streams as deflated")
+    parser.add_argument("--both", action="store_true", help="store files both raw and deflated, implies --detect-deflate")
+    parser.add_argument("files", nargs="+", help="files to pack")
+    args = parser.parse_args()
+
+    entries = {}
+
+    def add(name, data, compression, raw_size):
+        h = hash_name(name)
+        if h in entries:
+            if entries[h][0] == name:
+                return False
+            sys.exit("Hash collision between %s and %s, rename one of them" % (entries[h][0], name))
+        entries[h] = (name, data, compression, raw_size)
+        return True
+
+    for path in args.files:
+        name = os.path.relpath(path, args.root).replace(os.sep, "/")
+        with open(path, "rb") as f:
+            data = f.read()
+        compression, raw_size = classify(path, data, args.detect_deflate or args.both)
+        if add(name, data, compression, raw_size) and args.both:
+            other = alternate(data, compression, raw_size)
+            if other:
+                add(name + ALTERNATE, *other)
+
+    # Index first, then the names, then the data aligned to 4 bytes
+    ordered = sorted(entries.items())
+    offset = HEADER.size + ENTRY.size * len(ordered)
+    names = b""
+    name_offsets = []
+    for _, (name, _, _, _) in ordered:
+        name_offsets.append(offset + len(names))
+        names += name.encode("utf-8") + b"\0"
+    offset = align(offset + len(names))
+
+    index = b""
+    blobs = b""
+    for i, (h, (name, data, compression, raw_size)) in enumerate(ordered):
+        index += ENTRY.pack(h, name_offsets[i], offset + len(blobs), len(data), raw_size, 0,
+                            compression, zlib.crc32(data) & 0xFFFFFFFF)
+        blobs += data + b"\0" * (align(len(data)) - len(data))
+
+    with open(args.output, "wb") as f:
+        f.write(HEADER.pack(PACK_MAGIC, PACK_VERSION, len(ordered), 0))
+        f.write(index)
+        f.write(names)
+        f.write(b"\0" * (align(f.tell()) - f.tell()))
+        f.write(blobs)
+
+    print("Packed %i files into %s" % (len(ordered), args.output))
+
+
+if __name__ == "__main__":
+    main()